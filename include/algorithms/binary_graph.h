@@ -0,0 +1,114 @@
+#ifndef BINARY_GRAPH_H
+#define BINARY_GRAPH_H
+
+#include <iostream>
+#include <string>
+
+#include "_algorithms.h"
+#include "graphs.h"
+#include "file_input.h"
+
+namespace algorithms
+{
+	using namespace graphs;
+	
+	/*
+	 * Binary graph file:
+	 * 
+	 * A graph saved as compressed sparse rows, so that it is loaded by mapping the file instead of tokenizing an edge
+	 * list.  write() saves a digraph, graph, edge_weighted_digraph or edge_weighted_graph; load() maps such a file
+	 * read-only, checks its header and offsets, and serves the graph straight from the mapping:  nothing is copied,
+	 * and pages are read in as the graph is walked, so loading takes as long whatever the size of the graph.
+	 * 
+	 * The file, in native byte order, every section aligned on 8 bytes:
+	 * 
+	 * 		header			magic "GRPH", version, kind, byte order mark, V, E, and the number of adjacency entries
+	 * 		edgeStart		V+1 ulong-s, the neighbours of v being targets[edgeStart[v], edgeStart[v+1])
+	 * 		targets			a uint per adjacency entry, padded to 8 bytes
+	 * 		weights			a double per adjacency entry, for the edge weighted kinds only
+	 * 
+	 * The neighbours of each vertex are in the order adj() of the graph written gives them, so that walking the loaded
+	 * graph visits vertices in the same order.  An undirected graph holds each edge at both its ends, a self loop of
+	 * graph twice at its vertex, as the graph classes do.  The loaded graph is immutable, thus may be shared by any
+	 * number of readers and threads.
+	 * 
+	 * A file of another version, kind or byte order, truncated, or whose offsets don't add up, is reported and leaves
+	 * the binary_graph not ready().  The targets are not checked when loading, as that reads the whole file; verify()
+	 * does, when the file is not trusted.
+	*/
+	
+	class binary_graph
+	{
+	public:
+		enum kind : uint { DIGRAPH=0, GRAPH, EDGE_WEIGHTED_DIGRAPH, EDGE_WEIGHTED_GRAPH };
+		
+		binary_graph() noexcept;
+		binary_graph(const binary_graph&) = delete;
+		binary_graph(binary_graph&&) = delete;
+		binary_graph& operator=(const binary_graph&) = delete;
+		binary_graph& operator=(binary_graph&&) = delete;
+		
+		binary_graph(const std::string&) noexcept;
+		~binary_graph() noexcept;
+		
+		static bool write(const std::string&, const digraph&);
+		static bool write(const std::string&, const graph&);
+		static bool write(const std::string&, const edge_weighted_digraph&);
+		static bool write(const std::string&, const edge_weighted_graph&);
+		
+		bool load(const std::string&);
+		void unload();
+		bool verify() const;
+		
+		bool ready() const { return _edgeStart != nullptr; }
+		kind type() const { return _kind; }
+		bool directed() const { return _kind == DIGRAPH || _kind == EDGE_WEIGHTED_DIGRAPH; }
+		bool weighted() const { return _kind == EDGE_WEIGHTED_DIGRAPH || _kind == EDGE_WEIGHTED_GRAPH; }
+		uint V() const { return _V; }
+		uint E() const { return _E; }
+		ulong entries() const { return _entries; }
+		uint degree(const uint& v) const { return _edgeStart[v + 1] - _edgeStart[v]; }
+		
+		// Return pointers at the neighbours of v, and their weights, if weighted.
+		void adj(const uint& v, const uint*& begin, const uint*& end) const;
+		void adj(const uint& v, const uint*& begin, const uint*& end, const double*& weights) const;
+		
+		const ulong* edgeStart() const { return _edgeStart; }
+		const uint* targets() const { return _targets; }
+		const double* weights() const { return _weights; }
+		
+		static constexpr const uint version = 1;
+	
+	private:
+		struct _header
+		{
+			char magic[4];
+			uint version;
+			uint kind;
+			uint order;					// _order as written, to tell the byte order of the file.
+			uint V;
+			uint E;
+			ulong entries;
+			ulong reserved[4];
+		};
+		
+		template <typename Neighbours>
+		static bool _write(const std::string&, const kind&, const uint&, const uint&, const Neighbours&);
+		static bool _put(const int&, const void*, const ulong&);
+		static ulong _padded(const ulong& bytes) { return (bytes + 7) & ~7ul; }
+		
+		static constexpr const uint _order = 0x01020304;
+		static constexpr const ulong _buffer_size = 1ul << 16;
+		
+		file_input _in;
+		const ulong* _edgeStart = nullptr;		// The sections of the mapping.
+		const uint* _targets = nullptr;
+		const double* _weights = nullptr;
+		kind _kind = DIGRAPH;
+		uint _V = 0;
+		uint _E = 0;
+		ulong _entries = 0;
+	};
+}
+
+#endif
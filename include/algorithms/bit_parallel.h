@@ -0,0 +1,78 @@
+#ifndef BIT_PARALLEL_H
+#define BIT_PARALLEL_H
+
+#include <string>
+
+#include "_algorithms.h"
+#include "line.h"
+
+#include "graphs.h"
+#include "containers.h"
+
+namespace algorithms
+{
+	using namespace graphs;
+	
+	/*
+	 * Bit-parallel NFA simulation:
+	 * 
+	 * A shift-and over the Glushkov automaton of the NFA, which has no ε-transitions.  The NFA is given as for
+	 * lazy_dfa:  its ε-graph's directed_DFS_multi, the bytes matched per state (the match transition leading from
+	 * v to v+1), and the accepting state M.  The positions of the Glushkov automaton are the states with a match
+	 * transition, kept as a bit vector of up to max_words machine words, bit v for state v.  At construction,
+	 * 
+	 * 		_masks[c] holds the positions matching byte c,
+	 * 		follow(v) the positions reachable via ε-transitions from v+1, where v's match transition leads, and
+	 * 		_first the positions reachable from the start state, _last those whose v+1 reaches M.
+	 * 
+	 * D holding the positions which matched the last byte, reading byte c takes it to
+	 * 
+	 * 		D = follow(D) & _masks[c],		follow(D) being the union of follow(v), v in D,
+	 * 
+	 * and the text is recognized if D meets _last at its end.  follow(D) is read from tables, one per 8 bits of
+	 * the vector, of the union of the follow sets of each of their 256 values (Navarro and Raffinot):  a lookup
+	 * per non-zero byte of D, rather than one per state in it.  The tables take 16 KB times the square of the
+	 * words.  With no state lists, no DFS and no ε-closure at matching time, NFA uses this when its states fit.
+	*/
+	
+	class bit_parallel
+	{
+		using stci = std::string::const_iterator;
+		using lici = algorithms::line::const_iterator;
+	
+	public:
+		static constexpr const uint max_words = 4;
+		static constexpr const uint max_states = 64 * max_words;
+		
+		bit_parallel() = delete;
+		bit_parallel(const bit_parallel&) = delete;
+		bit_parallel(bit_parallel&&) = delete;
+		bit_parallel& operator=(const bit_parallel&) = delete;
+		bit_parallel& operator=(bit_parallel&&) = delete;
+		
+		bit_parallel(directed_DFS_multi&, const ulong*, const uint&) noexcept;
+		~bit_parallel() noexcept;
+		
+		bool recognizes(const std::string&) const;
+		bool recognizes(const stci&, const stci&) const;
+		bool recognizes(const lici&, const lici&) const;
+		
+		uint words() const { return _words; }
+	
+	private:
+		template <typename Iterator> bool _run(Iterator, const Iterator&) const;
+		
+		static constexpr const uint _chunks = 8;	// The 8-bit chunks of a word, each with a follow table.
+		
+		ulong* _masks = nullptr;			// 256 * _words, the positions matching each byte.
+		ulong* _follow = nullptr;			// _words * _chunks * 256 * _words, the follow sets of each chunk's values.
+		ulong _first[max_words] = {0};		// The positions reachable from the start state.
+		ulong _last[max_words] = {0};		// The positions whose v+1 reaches M.
+		bool _empty = false;				// Whether the empty text is recognized.
+		uint _words = 0;
+		uint _V = 0;
+		uint _M = 0;
+	};
+}
+
+#endif
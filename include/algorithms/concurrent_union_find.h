@@ -0,0 +1,54 @@
+#ifndef CONCURRENT_UNION_FIND_H
+#define CONCURRENT_UNION_FIND_H
+
+#include <atomic>
+
+#include "_algorithms.h"
+
+namespace algorithms
+{
+	/*
+	 * Union find class that may be shared by several threads at once, e.g. by parallel MST or
+	 * connectivity jobs.  The interface follows weighted_union_find:  formUnion(), connected(),
+	 * find() and count().
+	 * 
+	 * All parent links are atomics, and are only ever changed by compare and swap:
+	 * 		find() halves the path it walks.  A failed swap simply means another thread already
+	 * 		shortened the link, so find() never retries and is wait-free.
+	 * 		formUnion() links one root under the other.  The swap only succeeds if the site is
+	 * 		still a root, otherwise both roots are found again.  Thus formUnion() is lock-free.
+	 * 
+	 * Instead of component sizes, which can not be updated together with the link, roots are
+	 * ordered by a fixed random priority (a hash of the site) and the lower priority root is
+	 * linked under the higher one.  This keeps the expected tree height logarithmic, and as the
+	 * order never changes, concurrent unions can not form a cycle.
+	 * 
+	 * count() is exact once all threads are done, as every successful link merges two components.
+	*/
+	
+	class concurrent_union_find
+	{
+		std::atomic<uint>* _id = nullptr;		// parent link (site indexed)
+		std::atomic<uint> _count{0};			// The number of components.
+		uint _size = 0;							// Size of memory allocation.
+		
+		// Bijective integer hash, so that distinct sites never share a priority.
+		static uint _priority(uint x) { x ^= x >> 16; x *= 0x7feb352d; x ^= x >> 15; x *= 0x846ca68b; x ^= x >> 16; return x; }
+	
+	public:
+		concurrent_union_find(const uint&) noexcept;
+		~concurrent_union_find() noexcept { delete[] _id; }
+		
+		concurrent_union_find(const concurrent_union_find&) = delete;
+		concurrent_union_find& operator=(const concurrent_union_find&) = delete;
+		
+		uint count() const { return _count.load(); }
+		uint size() const { return _size; }
+		
+		bool connected(const uint& p, const uint& q);
+		uint find(const uint& p);
+		bool formUnion(const uint& p, const uint& q);
+	};
+}
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef DFA_H
+#define DFA_H
+
+#include <string>
+#include <iostream>
+
+#include "_algorithms.h"
+#include "line.h"
+#include "nfa.h"
+
+namespace algorithms
+{
+	using namespace graphs;
+	
+	/*
+	 * DFA, compiled ahead of time from an NFA.
+	 * 
+	 * Where NFA simulates the RE, and lazy_dfa caches the sets of states it meets on the way, DFA holds the
+	 * complete, minimal automaton, built once:
+	 * 
+	 * 		Subset construction:  every set of NFA states reachable from the start, found via a lazy_dfa
+	 * 		without a budget.  If the NFA sanitizes its input, the sanity check becomes part of the DFA, as
+	 * 		the product with a two state automaton tracking whether the previous character was the escape.
+	 * 
+	 * 		Byte classes:  bytes no state tells apart share a column of the transition table.
+	 * 
+	 * 		Hopcroft minimization:  refine {accepting, rejecting} by the predecessors of each block until
+	 * 		no block splits, in O(n log n) per byte class.
+	 * 
+	 * Matching costs a table lookup per character, with no state set at all.  A DFA object is immutable once
+	 * built, thus may be shared by any number of readers and threads.
+	 * 
+	 * save() writes the DFA to a binary blob (native byte order) and load() reads one back, so that fixed
+	 * patterns need not be compiled at run time at all.
+	*/
+	
+	class DFA
+	{
+		friend class pattern_set;
+		
+		using stci = std::string::const_iterator;
+		using lici = algorithms::line::const_iterator;
+	
+	public:
+		DFA() = default;
+		DFA(const DFA&) = delete;
+		DFA(DFA&&) = delete;
+		DFA& operator=(const DFA&) = delete;
+		DFA& operator=(DFA&&) = delete;
+		
+		DFA(NFA&) noexcept;
+		DFA(const std::string&) noexcept;
+		DFA(const char*, const ulong&) noexcept;
+		~DFA() noexcept;
+		
+		bool compile(NFA&);
+		bool load(const char*, const ulong&);
+		std::string save() const;
+		
+		bool ready() const { return _table != nullptr; }
+		uint states() const { return _states; }
+		uint classes() const { return _classCount; }
+		
+		bool recognizes(const std::string&) const;
+		bool operator()(const std::string&) const;
+		bool recognizes(const stci&, const stci&) const;
+		bool operator()(const stci&, const stci&) const;
+		bool recognizes(const lici&, const lici&) const;
+		bool operator()(const lici&, const lici&) const;
+	
+	private:
+		uint _next(const uint& s, const char& c) const { return _table[s * _classCount + _classes[(uchar)c]]; }
+		void _release();
+		static uint _minimize(const uint&, const uint*, const bool*, const uint&, uint*);
+		
+		static constexpr const uint _none = graphs::undefined_uint;
+		
+		uchar _classes[256] = {0};			// The byte class of each byte.
+		uint* _table = nullptr;				// _classCount transitions per state.
+		bool* _accepting = nullptr;
+		uint _states = 0;
+		uint _classCount = 0;
+		uint _start = 0;
+		uint _dead = _none;					// The state no input leads out of, if any.
+	};
+}
+
+#endif
@@ -8,6 +8,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <sys/stat.h>		// Needed for fstat(), which we need to determine file size.
+#include <sys/mman.h>		// Needed for mmap() and madvise().
 #include "string.h"			// Needed for strerror().
 
 #include <iostream>
@@ -22,6 +23,19 @@ namespace algorithms
 	/*
 	 * Read in a text file, one line at a time and store contents in a user provided containers::array<algorithms::line>
 	 * array.
+	 * 
+	 * Alternatively, map() the file read-only into memory, and walk its lines with next_line() as line_view-s straight
+	 * into the mapping:  nothing is copied or allocated per line, and the kernel is told the file is read sequentially,
+	 * so reading even a multi-GB file runs at the bandwidth of the disk or of the page cache.  The views stay valid until
+	 * unmap(), the next map(), or destruction.
+	 * 
+	 * Or stream() the file, for input larger than memory or not mappable:  it is read in chunks of a fixed size, the
+	 * partial line at the end of a chunk carried over to the front of the next one, so memory stays constant whatever
+	 * the size of the file (a line longer than the chunk grows it).  A view then stays valid until the next call to
+	 * next_line() or more().
+	 * 
+	 * In either mode, next_line(line_view&) returns the lines in turn, more() tells whether any is left, and rewind()
+	 * starts over.
 	*/
 	
 	class file_input
@@ -37,21 +51,51 @@ namespace algorithms
 		// Main interface function.  Client provides filename reference and a containers::array<algorithms::line>& reference.
 		int operator()(const std::string&, containers::array<algorithms::line>&);
 		
+		// Memory mapped mode:
+		bool map(const std::string&);
+		void unmap();
+		const char* begin() const { return _map; }
+		const char* end() const { return _map + _mapSize; }
+		ulong size() const { return _mapSize; }
+		ulong linecount() const;
+		
+		// Streaming mode:
+		bool stream(const std::string&, const ulong& chunk=default_chunk);
+		void close_stream();
+		ulong capacity() const { return _chunkSize; }
+		
+		// Set the view to the line starting at the first argument, and return the start of the next line.
+		static const char* next_line(const char*, const char*, line_view&);
+		
+		bool next_line(line_view&);
+		bool more();
+		bool rewind();
+		
+		static constexpr const ulong default_chunk = 1ul << 16;
+	
 	private:
 		bool open_file(int);
 		bool open_file(int, int);
 		bool read_file(containers::array<algorithms::line>&);
 		void close_file();
-		int get_line(int);
 		void error_cleanup(int);
+		bool _refill();
 		
-		char* _buffer = nullptr;
 		std::string filename = {};
 		const int FileFlag = O_RDONLY;
 		int fd = 0;
 		bool ready = false;
 		
-		static const size_t READ_BUFFER_SIZE = 1024;		// Size of the buffer to hold one line.
+		char* _map = nullptr;
+		ulong _mapSize = 0;
+		
+		char* _chunk = nullptr;
+		ulong _chunkSize = 0;
+		ulong _filled = 0;				// The bytes of the chunk read in.
+		ulong _lines = 0;				// The lines streamed so far.
+		bool _streaming = false;
+		bool _drained = false;			// No more to read from the file.
+		const char* _at = nullptr;		// The start of the next line, in the mapping or the chunk.
 	};
 	
 }
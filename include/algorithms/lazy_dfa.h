@@ -0,0 +1,102 @@
+#ifndef LAZY_DFA_H
+#define LAZY_DFA_H
+
+#include "_algorithms.h"
+
+#include "graphs.h"
+#include "containers.h"
+
+namespace algorithms
+{
+	using namespace graphs;
+	
+	/*
+	 * Lazy DFA:
+	 * 
+	 * A DFA built from an NFA on demand, one state at a time (subset construction).  Each DFA
+	 * state is a set of NFA states, those reachable after the input read so far, and has a row
+	 * of 256 transitions, one per byte, filled in once taken the first time.  When the states and
+	 * transitions a text needs exist, reading a byte of it is a single table lookup.
+	 * 
+	 * The NFA is given as in nfa_program:  its ε-transitions as adjacency arrays, those of NFA
+	 * state v being edges[edgeStart[v], edgeStart[v+1]), and for each NFA state v the set of bytes
+	 * it matches (4 words, bit b for byte b), the match transition leading from v to v+1.  The NFA
+	 * state M accepts.  Neither is written to, so lazy_dfa-s on one NFA may run in parallel.
+	 * 
+	 * The states are cached within budget() bytes.  When a new state would exceed it, all of
+	 * them are dropped (flushes() counts these) and the construction starts over, so matching
+	 * stays correct at any budget, merely slower.  A few states are kept regardless of the budget.
+	 * 
+	 * State 0 is the dead state (no NFA state left, no match possible), state 1 the start state.
+	*/
+	
+	class lazy_dfa
+	{
+		// No transition computed yet, an empty bucket, or no state found.
+		static constexpr const uint _none = graphs::undefined_uint;
+	
+	public:
+		static constexpr const uint dead = 0;
+		static constexpr const uint start = 1;
+		static constexpr const ulong default_budget = 1ul << 20;
+		
+		lazy_dfa() = delete;
+		lazy_dfa(const lazy_dfa&) = delete;
+		lazy_dfa(lazy_dfa&&) = delete;
+		lazy_dfa& operator=(const lazy_dfa&) = delete;
+		lazy_dfa& operator=(lazy_dfa&&) = delete;
+		
+		lazy_dfa(const uint*, const uint*, const ulong*, const uint&, const ulong& budget=default_budget) noexcept;
+		~lazy_dfa() noexcept;
+		
+		uint next(const uint& s, const uchar& c)
+		{
+			uint t = _table[(s << 8) + c];
+			return t != _none ? t : _compute(s, c);
+		}
+		
+		bool accepting(const uint& s) const { return _accepting[s]; }
+		
+		void budget(const ulong&);
+		ulong budget() const { return _budget; }
+		ulong used() const;
+		uint states() const { return _count; }
+		uint flushes() const { return _flushes; }
+	
+	private:
+		uint _compute(const uint&, const uchar&);
+		uint _closure(const uint*, const uint&, uint*);
+		uint _add(const uint*, const uint&);
+		uint _find(const uint*, const uint&) const;
+		bool _reserve(const uint&, const uint&, const bool&);
+		void _flush();
+		static uint _hash(const uint*, const uint&);
+		
+		const uint* p_edgeStart = nullptr;		// The NFA's ε-transitions, not owned.
+		const uint* p_edges = nullptr;
+		const ulong* p_bytes = nullptr;			// Bytes matched per NFA state, not owned.
+		uint _M = 0;								// The accepting NFA state.
+		ulong _budget = default_budget;
+		
+		uint* _table = nullptr;					// 256 transitions per DFA state, _none if not yet known.
+		bool* _accepting = nullptr;
+		uint* _setStart = nullptr;				// State s holds the NFA states _sets[_setStart[s], _setStart[s+1]).
+		uint* _sets = nullptr;
+		uint* _buckets = nullptr;				// Hash table of the states, by their NFA state sets.
+		uint* _initial = nullptr;				// The NFA states of the start state.
+		uint* _target = nullptr;				// The NFA states of the state being computed.
+		uint* _sources = nullptr;				// The NFA states its match transitions lead to.
+		uint* _stack = nullptr;
+		visited_set _marked;
+		
+		uint _count = 0;
+		uint _capacity = 0;
+		uint _setsCount = 0;
+		uint _setsCapacity = 0;
+		uint _bucketCount = 0;
+		uint _initialCount = 0;
+		uint _flushes = 0;
+	};
+}
+
+#endif
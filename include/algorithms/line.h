@@ -125,6 +125,24 @@ namespace algorithms
 		uint _length = 0;
 	};
 	
+	/*
+	 * A view of a line of text owned elsewhere, such as a file mapped by file_input:  its first character and
+	 * length, without the newline.  Costs no allocation, and is valid as long as the text it points into.
+	*/
+	
+	struct line_view
+	{
+		using const_iterator = line::const_iterator;
+		using citerator = line::citerator;
+		
+		const char* data = nullptr;
+		uint length = 0;
+		
+		const_iterator cbegin() const { return const_iterator(data); }
+		const_iterator cend() const { return const_iterator(data + length); }
+		void get_citers(citerator& b, citerator& e) const { b = citerator(data); e = citerator(data + length); }
+	};
+
 }
 
 #endif
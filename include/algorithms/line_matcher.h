@@ -0,0 +1,54 @@
+#ifndef LINE_MATCHER_H
+#define LINE_MATCHER_H
+
+#include "_algorithms.h"
+#include "line.h"
+#include "nfa.h"
+
+#include "containers.h"
+
+namespace algorithms
+{
+	/*
+	 * Streams the matches of an NFA over a range of lines, one at a time:
+	 * 
+	 * 		line_matcher m(nfa, lines.cbegin(), lines.cend());
+	 * 		while(m.next() == true)
+	 * 			... m.lineNumber(), m.span() ...
+	 * 
+	 * Matches are leftmost-longest and non-overlapping within each line, as for NFA::find_all(), and never
+	 * span lines.  Lines are numbered from 0 at begin.  The NFA and the lines must outlive the matcher.
+	*/
+	
+	class line_matcher
+	{
+		using arli = containers::array<algorithms::line>;
+		using arli_citer = arli::const_iterator;
+		using lici = algorithms::line::const_iterator;
+	
+	public:
+		line_matcher() = delete;
+		line_matcher(const line_matcher&) = delete;
+		line_matcher(line_matcher&&) = delete;
+		line_matcher& operator=(const line_matcher&) = delete;
+		line_matcher& operator=(line_matcher&&) = delete;
+		
+		line_matcher(NFA&, const arli_citer&, const arli_citer&) noexcept;
+		~line_matcher() = default;
+		
+		bool next();
+		
+		uint lineNumber() const { return _lineNumber; }
+		const NFA::match_span& span() const { return _span; }
+	
+	private:
+		NFA* p_nfa = nullptr;
+		arli_citer _line;
+		arli_citer _end;
+		uint _lineNumber = 0;
+		uint _offset = 0;			// Where to resume the search within the current line.
+		NFA::match_span _span;
+	};
+}
+
+#endif
@@ -7,6 +7,11 @@
 
 #include "_algorithms.h"
 #include "line.h"
+#include "lazy_dfa.h"
+#include "bit_parallel.h"
+#include "prefilter.h"
+#include "nfa_program.h"
+#include "pike_vm.h"
 
 #include "graphs.h"
 #include "containers.h"
@@ -41,10 +46,24 @@ namespace algorithms
 	 * ε-transitions from opening parenthesis '(' to character after '|', from '|' to closing parenthesis ')'
 	 * addEdge(lp, OR+1); addEdge(OR, i)
 	 * 
-	 * Character classes:  [[:misc:]], [[:alpha:]], [[:ALPHA:]], [[:ascii:]], [[:digit:]], and [[:hex:]].
+	 * Character classes:  [[:misc:]], [[:alpha:]], [[:ALPHA:]], [[:ascii:]], [[:digit:]], [[:hex:]], [[:alphanum:]],
+	 * [[:space:]] and [[:punct:]].
+	 * Bracket sets, perhaps complemented with a leading '^', of single characters, ranges and the above classes, such as
+	 * [a-fx-z_], [^[:space:],] or [[:digit:].].  Within a set, '\' escapes, and RE operators are best escaped as well.
 	 * Single character or group ranges (...){n1,n2} or A{n1,n2}, with 0 <= n1,n2 <= 99.  Note that the separation
 	 * of the numbers is arbtirary and not enforced.
 	 * Alphanumeric user defined ranges, with range = {0-9,A-Z,a-z}.  These can be complemented with '^'.
+	 * Each class, range and set is compiled into a 256 bit map of the bytes it matches, so that testing a character
+	 * against it is a single bit lookup.
+	 * 
+	 * UTF-8:  the RE and the text are UTF-8, and matching runs one byte at a time, with no decoding.  A non-ASCII
+	 * character in the RE is the sequence of its bytes.  A bracket set holding non-ASCII characters, or complemented,
+	 * is a set of code points, compiled as RE2 does:  each code point range is split into ranges whose UTF-8
+	 * encodings share their length and differ per byte in a range of values, as [U+0400, U+04FF] into
+	 * [D0-D3][80-BF], and the set becomes the alternation of these byte range sequences, its ASCII members being
+	 * one of them.  So [^,] matches any one character but ',', "é" included, but no lone byte of "é".  Operators
+	 * following such a character or set apply to it as a whole.  The classes, and the ranges (a-z), hold ASCII
+	 * bytes;  a complemented range (^a-z) complements bytes, as before.
 	 * Multi-OR ( ... | ...| ... )
 	 * One or more operator '+':  A+, or (...)+
 	 * Zero or one: A?, or (...)?
@@ -54,35 +73,73 @@ namespace algorithms
 	 * the available states at each character of the expanded regular expression state.  Once all characters are
 	 * consumed, the algorithm determines whether the end of the RE has been reached, marking a successful match.
 	 * 
-	 * TODO -- UTF-8 characters.
+	 * The bytes each state matches are computed once, at construction.  Matching then runs on one of three
+	 * backends, see setBackend():
+	 * 
+	 * 		BIT_PARALLEL:  the reachable states as a bit vector (bit_parallel), a few word operations per
+	 * 		character.  The default, if the states fit.
+	 * 		LAZY_DFA:  the reachable states cached as the states of a lazy_dfa, so that once warm, matching
+	 * 		costs a table lookup per character.  dfaBudget() bounds the memory of the cache.  The default
+	 * 		for larger NFAs.
+	 * 		DFS:  a DFS over the ε-transitions per character, as described above.
+	 * 
+	 * Ahead of any backend, a prefilter rejects the texts lacking a byte every match contains, or not beginning
+	 * with a byte a match can begin with, at the speed of a memchr(), and lets searches skip to the positions a
+	 * match can begin at.  See setPrefilter().
+	 * 
+	 * The graph, the bytes per state, the bit_parallel masks and the prefilter make up the NFA's nfa_program,
+	 * immutable and reference counted.  An NFA matches on its own state, thus from one thread at a time;
+	 * other threads share its program() via an nfa_matcher each, without compiling the RE again.
+	 * 
+	 * Search:  find() reports the leftmost-longest match within a text, and find_all() all non-overlapping ones,
+	 * as offsets [begin, end) into it.  Instead of restarting the simulation at each position, both run a single
+	 * pass, as if the RE were prefixed by a self-looping state:  the start state is added anew before every
+	 * character, and each NFA state carries the leftmost start position of the threads reaching it.  Once a match
+	 * is seen, no new threads start, threads starting further right are dropped, and the pass ends as soon as no
+	 * thread could still produce an earlier or longer match.  The input is not sanitized.  See line_matcher for
+	 * matching over an array of lines.
+	 * 
+	 * Captures:  match() matches the whole text, as recognizes() does, and also reports the span of each group,
+	 * numbered by its '(' from 0, the parentheses around the RE, on.  A group repeated by an operator holds its last
+	 * repetition, one not taking part holds pike_vm::unmatched.  The quantifiers are greedy and the leftmost
+	 * alternative wins, as in Perl.  The spans come from a pike_vm, built on the first call, so that only callers of
+	 * match() pay for the captures;  other threads may run a pike_vm of their own over program().
 	*/
 	
+	class DFA;
+	
 	class NFA
 	{
-		class ascii_range
+		friend class DFA;				// Compiles the NFA's states.
+		
+	public:
+		enum backend : uchar { DFS, BIT_PARALLEL, LAZY_DFA };
+		
+		// A match, as offsets [begin, end) into the text searched.
+		struct match_span
 		{
-		public:
-			ascii_range() {};
-			ascii_range(int id, char b, char e, bool c) { rangeID = id; begin = b ; end = e; complement = c; }
-			int rangeID = 0;
-			char begin = 0;
-			char end = 0;
-			bool complement = false;
+			uint begin = 0;
+			uint end = 0;
 		};
 		
+		using arspan = containers::array<match_span>;
+	
+	private:
 		using arui = containers::array<uint>;
 		using arui_citer = arui::const_iterator;
 		using stci = std::string::const_iterator;
-		using arar = containers::array<ascii_range>;
-		using arar_citer = arar::const_iterator;
 		using lici = algorithms::line::const_iterator;
 		
-		// Set up the character class enumeration, which will be used as an index within the character class function pointer array.
-		enum charclass : char {misc = -99, lcase, ucase, ascii, digit, hex, alphanum};
-		static constexpr const charclass cc[] = {misc, lcase, ucase, ascii, digit, hex, alphanum};
+		// The corrected RE holds bytes, operators and, beyond the bytes, the tokens of the classes and sets.
+		using restring = std::u32string;
+		
+		// The character classes, the first tokens, each also an index into the set bit maps.
+		enum charclass : char32_t {misc = 256, lcase, ucase, ascii, digit, hex, alphanum, space, punct};
+		static constexpr const charclass cc[] = {misc, lcase, ucase, ascii, digit, hex, alphanum, space, punct};
 		static constexpr const charclass _class_start = misc;
-		static constexpr const charclass _class_end = alphanum;
-		static constexpr const char _rangestart = -80;
+		static constexpr const charclass _class_end = punct;
+		static constexpr const char32_t _rangestart = _class_end + 1;
+		static constexpr const char32_t _capture_start = 0x40000000;	// The '(' of group k, then its ')', 2k and 2k+1 on.
 		static constexpr const char _escape = '\\';
 		static constexpr const char _anychar = '.';
 		static const string pattern;					// 54, 54 bytes, vs 5*15 = 75 bytes.
@@ -101,17 +158,22 @@ namespace algorithms
 		static const string::const_iterator hex_e;
 		static const string::const_iterator alphanum_b;
 		static const string::const_iterator alphanum_e;
+		static const string::const_iterator space_b;
+		static const string::const_iterator space_e;
+		static const string::const_iterator punct_b;
+		static const string::const_iterator punct_e;
 		
-		static constexpr const uint TEST_FUNCTIONS = 7;
 		static constexpr const uint maxRange = 99;
 		
 		uint _V = 0;									// The number of vertices of the graph representation of the RE.
 		uint _E = 0;									// The number of edges of the graph representation of the RE.
 		uint _M = 0;									// The length of the corrected/expanded RE string.
-		uint _rangecount = 0;
+		uint _rangecount = 0;							// The user sets, tokens from _rangestart on.
+		uint _groups = 0;								// The capturing groups.
+		uint _setCapacity = 0;
 		bool _initialized = false;
 		
-		arar* _ranges = nullptr;						// Array of ascii_range objects.
+		ulong* _sets = nullptr;							// 256 bits per class or set token, the bytes it matches.
 		containers::stack<uint>* _ops = nullptr;		// Used for storing '('.
 		containers::stack<uint>* _orstack = nullptr;	// Used for storing '|' during RE processing (building _corrected_re).
 		arui* _match = nullptr;							// Storage for the matching states.
@@ -119,31 +181,61 @@ namespace algorithms
 		arui* _initial_reachable_states = nullptr;		// As the RE[0] states are the same for all input strings, store them here.
 		digraph* p_g = nullptr;							// This will hold the digraph representation of the RE.
 		directed_DFS_multi* p_dfs = nullptr;			// We'll use this object and p_g to determine dfs paths needed by the algorithm.
+		nfa_program* p_program = nullptr;				// Owns p_g, _bytes, and the tables below.
+		const ulong* _bytes = nullptr;					// 256 bits per state, the bytes matched there.
+		lazy_dfa* p_dfa = nullptr;						// The cached reachable states, for LAZY_DFA.
+		pike_vm* p_vm = nullptr;						// For match(), once called.
+		const bit_parallel* p_bits = nullptr;			// The state masks, for BIT_PARALLEL.
+		const prefilter* p_filter = nullptr;			// The leading class and required byte of the RE.
+		bool _prefilter = true;
+		ulong _budget = lazy_dfa::default_budget;
+		backend _backend = DFS;
 		
-		string _re = "";
-		string _group = "";
-		string _corrected_re = "";
+		// Search threads:  two lists of NFA states, the current and the next, with their start positions.
+		uint* _threads[2] = {nullptr, nullptr};
+		uint _threadCount[2] = {0, 0};
+		uint* _startOf[2] = {nullptr, nullptr};
+		visited_set* _inList = nullptr;
+		uint* _stack = nullptr;
 		
-		using FPP = bool (NFA::**)(const char&) const;
-		using FP = bool (NFA::*)(const char&) const;
-		FPP _fpp = nullptr;								// Function pointer array for the character class functions.
+		string _re = "";
+		restring _group;
+		restring _corrected_re;
 		
 		bool _sanitize = true;
 		
 		bool _substr_equals(const stci, const stci, const stci, const stci) const;
-		bool _process_re(const string&);
+		bool _process_re(const string&, const string&);
+		string _group_utf8(const string&, string&) const;
 		bool _getClass(string::const_iterator, string::const_iterator, charclass&, uint&);
-		bool _isCharClass(const char&, charclass&) const;
+		bool _isCharClass(const char32_t&, charclass&) const;
 		
 		bool _input_sanity_check(const string&) const;
 		bool _input_sanity_check(const stci&, const stci&) const;
 		bool _input_sanity_check(const lici&, const lici&) const;
 		bool _re_sanity_check(const string&) const;
 		void _build_graph();
-		bool _create_user_defined_set(const char&, const char&, const int&, const bool&);
+		bool _create_user_defined_set(const char&, const char&, const char32_t&, const bool&);
+		bool _bracket_set(const string&, const uint&, uint&);
+		void _addRange(const char32_t&, const char&, const char&);
+		char32_t _newSet();
+		char32_t _findSet(const ulong*);
+		ulong* _set(const char32_t& token) const { return _sets + 4*(token - _class_start); }
+		
+		// The parenthesis of a capturing group, or a plain one, and the operator either stands for.
+		static char32_t _paren(const uint& group, const char& c) { return group == graphs::undefined_uint ? c : _capture_start + 2*group + (c == ')'); }
+		static char32_t _op(const char32_t& c) { return c < _capture_start ? c : (c & 1) == 0 ? '(' : ')'; }
+		string _symbol(const char32_t&) const;
+		
+		template <typename Iterator> bool _find(Iterator, const Iterator&, match_span&);
+		template <typename Iterator> uint _find_all(const Iterator&, const Iterator&, arspan&);
+		void _addThread(const uint&, const uint&, const uint&);
+		template <typename Iterator> bool _admits(const Iterator&, const Iterator&) const;
+		template <typename Iterator> bool _capture(const Iterator&, const Iterator&, arspan&);
 		
 		// Character class functions.
-		bool _isMatch(const char&, const char&);
+		bool _isMatch(const char&, const char32_t&);
+		bool _matches(const uint& v, const char& c) const { uchar b = c; return ((_bytes[4*v + (b >> 6)] >> (b & 63)) & 1) != 0; }
 		bool _isDigit(const char&) const;
 		bool _isAlpha(const char&) const;
 		bool _isALPHA(const char&) const;
@@ -151,6 +243,9 @@ namespace algorithms
 		bool _isMisc(const char&) const;
 		bool _isHex(const char&) const;
 		bool _isAlphaNum(const char&) const;
+		bool _isSpace(const char&) const;
+		bool _isPunct(const char&) const;
+		bool _inClass(const charclass&, const char&) const;
 		
 	public:
 		NFA(const string&) noexcept;
@@ -162,12 +257,33 @@ namespace algorithms
 		void print_status() const;
 		void sanitize(const bool& Sanitize) { _sanitize = Sanitize; }
 		bool ready() const { return _initialized == true; }
+		uint states() const { return _V; }
+		bool setBackend(const backend&);
+		backend getBackend() const { return _backend; }
+		void dfaBudget(const ulong&);
+		void setPrefilter(const bool& Prefilter) { _prefilter = Prefilter; }
+		bool getPrefilter() const { return _prefilter; }
+		const prefilter* filter() const { return p_filter; }
+		const nfa_program* program() const { return p_program; }
+		const lazy_dfa* dfa() const { return p_dfa; }
 		bool recognizes(const string&);
 		bool operator()(const string&);
 		bool recognizes(const stci&, const stci&);
 		bool operator()(const stci&, const stci&);
 		bool recognizes(const lici&, const lici&);
 		bool operator()(const lici&, const lici&);
+		
+		bool find(const string&, match_span&);
+		bool find(const stci&, const stci&, match_span&);
+		bool find(const lici&, const lici&, match_span&);
+		uint find_all(const string&, arspan&);
+		uint find_all(const stci&, const stci&, arspan&);
+		uint find_all(const lici&, const lici&, arspan&);
+		
+		uint groups() const { return _groups; }
+		bool match(const string&, arspan&);
+		bool match(const stci&, const stci&, arspan&);
+		bool match(const lici&, const lici&, arspan&);
 	};
 }
 
@@ -0,0 +1,73 @@
+#ifndef NFA_MATCHER_H
+#define NFA_MATCHER_H
+
+#include <string>
+
+#include "_algorithms.h"
+#include "line.h"
+#include "lazy_dfa.h"
+#include "nfa_program.h"
+
+#include "graphs.h"
+#include "containers.h"
+
+namespace algorithms
+{
+	using namespace graphs;
+	
+	class NFA;
+	
+	/*
+	 * Matches the RE of a shared nfa_program, one matcher per thread:
+	 * 
+	 * 		NFA nfa(re);
+	 * 		// In each thread:
+	 * 		nfa_matcher matcher(nfa);
+	 * 		matcher.recognizes(text);
+	 * 
+	 * The matcher holds a reference to the program, which thus outlives the NFA if need be, and the state a match
+	 * writes to:  none if the program's states fit bit_parallel, else a lazy_dfa of its own.
+	 * Construction costs no compilation at all.  Input is sanitized and prefiltered as by NFA, unless turned off.
+	*/
+	
+	class nfa_matcher
+	{
+		using stci = std::string::const_iterator;
+		using lici = algorithms::line::const_iterator;
+	
+	public:
+		nfa_matcher() = delete;
+		nfa_matcher(const nfa_matcher&) = delete;
+		nfa_matcher(nfa_matcher&&) = delete;
+		nfa_matcher& operator=(const nfa_matcher&) = delete;
+		nfa_matcher& operator=(nfa_matcher&&) = delete;
+		
+		nfa_matcher(const nfa_program*, const ulong& budget=lazy_dfa::default_budget) noexcept;
+		nfa_matcher(const NFA&, const ulong& budget=lazy_dfa::default_budget) noexcept;
+		~nfa_matcher() noexcept;
+		
+		bool ready() const { return p_program != nullptr; }
+		void sanitize(const bool& Sanitize) { _sanitize = Sanitize; }
+		void setPrefilter(const bool& Prefilter) { _prefilter = Prefilter; }
+		const nfa_program* program() const { return p_program; }
+		const lazy_dfa* dfa() const { return p_dfa; }
+		
+		bool recognizes(const std::string&);
+		bool operator()(const std::string&);
+		bool recognizes(const stci&, const stci&);
+		bool operator()(const stci&, const stci&);
+		bool recognizes(const lici&, const lici&);
+		bool operator()(const lici&, const lici&);
+	
+	private:
+		void _initialize(const nfa_program*, const ulong&);
+		template <typename Iterator> bool _recognizes(const Iterator&, const Iterator&);
+		
+		const nfa_program* p_program = nullptr;
+		lazy_dfa* p_dfa = nullptr;
+		bool _sanitize = true;
+		bool _prefilter = true;
+	};
+}
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef NFA_PROGRAM_H
+#define NFA_PROGRAM_H
+
+#include <atomic>
+
+#include "_algorithms.h"
+#include "bit_parallel.h"
+#include "prefilter.h"
+
+#include "graphs.h"
+#include "containers.h"
+
+namespace algorithms
+{
+	using namespace graphs;
+	
+	/*
+	 * The compiled, immutable part of an NFA:  the ε-transition graph, also as flat adjacency arrays, the bytes
+	 * matched per state, the capture slot of each state, and the tables derived from them, the bit_parallel masks
+	 * (if the states fit) and the prefilter.
+	 * 
+	 * The adjacency arrays hold the ε-transitions of a state in the order they were added, which pike_vm takes as
+	 * their priority.  The capture slot of the '(' of group k is 2k, of its ')' 2k+1, of any other state none.
+	 * 
+	 * Nothing in it changes once built, so one program may be shared by any number of threads, each matching
+	 * through its own nfa_matcher, which holds whatever a match writes to.  Programs are reference counted:
+	 * the creator holds the first reference, acquire() adds one, and release() drops one, deleting the
+	 * program with the last.  NFA creates its program at construction, see NFA::program().
+	*/
+	
+	class nfa_program
+	{
+	public:
+		nfa_program() = delete;
+		nfa_program(const nfa_program&) = delete;
+		nfa_program(nfa_program&&) = delete;
+		nfa_program& operator=(const nfa_program&) = delete;
+		nfa_program& operator=(nfa_program&&) = delete;
+		
+		// Takes ownership of the graph, of the bytes, 4 words per state, and of the capture slots, 1 per state.
+		nfa_program(digraph*, directed_DFS_multi&, ulong*, uint*, const uint&, const uint&) noexcept;
+		
+		const nfa_program* acquire() const;
+		void release() const;
+		uint references() const { return _references.load(); }
+		
+		const digraph& graph() const { return *p_g; }
+		const uint* edgeStart() const { return _edgeStart; }
+		const uint* edges() const { return _edges; }
+		const ulong* bytes() const { return _bytes; }
+		const uint* slots() const { return _slots; }
+		uint groups() const { return _groups; }
+		uint accepting() const { return _M; }
+		uint states() const { return _M + 1; }
+		const bit_parallel* bits() const { return p_bits; }
+		const prefilter* filter() const { return p_filter; }
+	
+	private:
+		~nfa_program() noexcept;
+		
+		digraph* p_g = nullptr;
+		uint* _edgeStart = nullptr;				// The ε-transitions of state v are _edges[_edgeStart[v], _edgeStart[v+1]).
+		uint* _edges = nullptr;
+		ulong* _bytes = nullptr;
+		uint* _slots = nullptr;
+		uint _groups = 0;
+		uint _M = 0;
+		bit_parallel* p_bits = nullptr;
+		prefilter* p_filter = nullptr;
+		mutable std::atomic<uint> _references {1};
+	};
+}
+
+#endif
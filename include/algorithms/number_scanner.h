@@ -0,0 +1,49 @@
+#ifndef NUMBER_SCANNER_H
+#define NUMBER_SCANNER_H
+
+#include "_algorithms.h"
+
+namespace algorithms
+{
+	/*
+	 * Number scanner:
+	 * 
+	 * Validates and converts a number in one pass over its text, in place of matching the RE-s of read_tokens and
+	 * readNumber with a DFA, copying the token, then converting it with strtol() or strtod().  operator() finds the
+	 * longest prefixes of a text matching
+	 * 
+	 * 		the integer RE	-?[[:digit:]]+
+	 * 		the real RE		-?[[:digit:]]+.?[[:digit:]]*((e|E)-?[[:digit:]]{1,3})?
+	 * 
+	 * and accumulates the value of the integer on the way.  A real is converted by std::from_chars().  As with the
+	 * conversions replaced, a value out of the range of a long, or of a normal double (subnormal results included,
+	 * as strtod() flags them), is an error.
+	*/
+	
+	class number_scanner
+	{
+	public:
+		number_scanner() = default;
+		~number_scanner() = default;
+		
+		bool operator()(const char*, const char*);
+		
+		uint integer() const { return _integer; }		// The length of the integer prefix, 0 if none.
+		uint real() const { return _real; }			// The length of the real prefix, 0 if none.
+		uint digits() const { return _digits; }		// The digits of the integer prefix.
+		
+		bool toLong(long&) const;
+		bool toDouble(double&) const;
+	
+	private:
+		const char* _begin = nullptr;
+		ulong _magnitude = 0;
+		uint _integer = 0;
+		uint _real = 0;
+		uint _digits = 0;
+		bool _negative = false;
+		bool _overflow = false;
+	};
+}
+
+#endif
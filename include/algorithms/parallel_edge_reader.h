@@ -0,0 +1,89 @@
+#ifndef PARALLEL_EDGE_READER_H
+#define PARALLEL_EDGE_READER_H
+
+#include <iostream>
+#include <string>
+
+#include "_algorithms.h"
+#include "graphs.h"
+#include "file_input.h"
+
+namespace algorithms
+{
+	using namespace graphs;
+	
+	/*
+	 * Parallel edge list reader:
+	 * 
+	 * Reads the edge lists of read_int_graph and read_edge_weighted_(di)graph, V and E followed by edges "v w", or
+	 * "v w weight" if weighted, several to a line if need be, on several threads.  The file is mapped, V and E read,
+	 * and the rest split at newlines into a chunk per thread.  Each thread parses its chunk with std::from_chars into
+	 * edge buffers of its own, allocating nothing shared, so that the threads never wait on one another.
+	 * 
+	 * The buffers, in the order of the chunks, hold the edges in the order of the file.  DG(), G(), EWDG() and EWG()
+	 * add them to a graph in that order, in one pass, making the same graph the single threaded readers make.  CSR()
+	 * fills compressed sparse rows, the edges of v being those in [edgeStart[v], edgeStart[v+1]), in the order of the
+	 * file:  each thread counts the sources of its own edges, and from the counts each thread then knows where its
+	 * edges go, and places them in parallel.  As the counts of a thread take V uints, a thread takes several chunks
+	 * where there are fewer than 2V edges a thread, so that the counts take at most half of what the rows take.  CDG()
+	 * makes a compressed_digraph by way of CSR(), for an edge list whose digraph wouldn't fit in memory:  the rows cost
+	 * 4 bytes an edge while the compressed_digraph is built, and the compressed_digraph a byte or two once built.
+	 * 
+	 * A line failing to parse, or a vertex not in [0, V), is reported with its line number, and leaves the reader
+	 * not ready().
+	*/
+	
+	class parallel_edge_reader
+	{
+	public:
+		parallel_edge_reader() = delete;
+		parallel_edge_reader(const parallel_edge_reader&) = delete;
+		parallel_edge_reader(parallel_edge_reader&&) = delete;
+		parallel_edge_reader& operator=(const parallel_edge_reader&) = delete;
+		parallel_edge_reader& operator=(parallel_edge_reader&&) = delete;
+		
+		parallel_edge_reader(const std::string&, const bool& weighted, const uint& threads=0, const char& delim=' ') noexcept;
+		~parallel_edge_reader() noexcept;
+		
+		bool ready() const { return _initialized; }
+		bool weighted() const { return _weighted; }
+		uint V() const { return _V; }
+		uint E() const { return _E; }
+		uint threads() const { return _threads; }
+		
+		digraph DG() const;
+		graph G() const;
+		edge_weighted_digraph EWDG() const;
+		edge_weighted_graph EWG() const;
+		compressed_digraph CDG() const;
+		void CSR(uint* edgeStart, uint* targets, double* weights=nullptr) const;
+	
+	private:
+		struct _chunk
+		{
+			const char* begin = nullptr;
+			const char* end = nullptr;
+			uint* edges = nullptr;			// v and w of each edge.
+			double* weights = nullptr;
+			ulong count = 0;
+			ulong capacity = 0;
+			const char* error = nullptr;		// The line that failed to parse, if any.
+		};
+		
+		bool _header(const char*&);
+		void _parse(_chunk&) const;
+		void _grow(_chunk&) const;
+		bool _delimiter(const char& c) const { return c == _delim || c == ' ' || c == '\t' || c == '\r'; }
+		
+		file_input _in;
+		_chunk* _chunks = nullptr;
+		uint _threads = 0;
+		uint _V = 0;
+		uint _E = 0;
+		char _delim = ' ';
+		bool _weighted = false;
+		bool _initialized = false;
+	};
+}
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef PATTERN_SET_H
+#define PATTERN_SET_H
+
+#include <string>
+#include <iostream>
+#include <initializer_list>
+
+#include "_algorithms.h"
+#include "line.h"
+#include "dfa.h"
+
+namespace algorithms
+{
+	using namespace graphs;
+	
+	/*
+	 * A set of up to max_patterns RE-s, compiled into one DFA, so that a single pass over the input tells which
+	 * of them match, as a lexer generator would:
+	 * 
+	 * 		add() each RE, with an optional priority, then compile().
+	 * 		match() returns the pattern matching the whole text, matches() all of them, as a bit mask by id.
+	 * 		longest() returns the pattern matching the longest prefix of the text (maximal munch), and its length.
+	 * 
+	 * Patterns are numbered in the order added.  Where several match, the one of highest priority wins, and among
+	 * equal priorities the one added first.
+	 * 
+	 * Each RE is compiled into its minimal DFA first (see DFA).  compile() then builds the product of these over
+	 * the tuples of their states reachable from the start, with the byte classes no pattern tells apart sharing a
+	 * column, and records for each state the patterns accepting there and the winner among them.  Once compiled,
+	 * a pattern_set is immutable, thus may be shared by any number of readers and threads.
+	*/
+	
+	class pattern_set
+	{
+		using stci = std::string::const_iterator;
+		using lici = algorithms::line::const_iterator;
+	
+	public:
+		static constexpr const uint max_patterns = 64;
+		static constexpr const uint max_states = 1u << 20;
+		static constexpr const uint none = graphs::undefined_uint;
+		
+		pattern_set() = default;
+		pattern_set(const pattern_set&) = delete;
+		pattern_set(pattern_set&&) = delete;
+		pattern_set& operator=(const pattern_set&) = delete;
+		pattern_set& operator=(pattern_set&&) = delete;
+		
+		pattern_set(std::initializer_list<std::string>) noexcept;
+		~pattern_set() noexcept;
+		
+		uint add(const std::string&, const int& priority=0);
+		bool compile();
+		
+		bool ready() const { return _table != nullptr; }
+		uint patterns() const { return _count; }
+		uint states() const { return _states; }
+		uint classes() const { return _classCount; }
+		const std::string& pattern(const uint& id) const { return _res[id]; }
+		
+		uint match(const std::string&) const;
+		uint match(const stci&, const stci&) const;
+		uint match(const lici&, const lici&) const;
+		ulong matches(const std::string&) const;
+		ulong matches(const stci&, const stci&) const;
+		ulong matches(const lici&, const lici&) const;
+		uint longest(const std::string&, uint&) const;
+		uint longest(const stci&, const stci&, uint&) const;
+		uint longest(const lici&, const lici&, uint&) const;
+	
+	private:
+		uint _next(const uint& s, const char& c) const { return _table[s * _classCount + _classes[(uchar)c]]; }
+		template <typename Iterator> uint _run(Iterator, const Iterator&) const;
+		template <typename Iterator> uint _longest(Iterator, const Iterator&, uint&) const;
+		void _release();
+		
+		static constexpr const uint _none = graphs::undefined_uint;
+		
+		std::string _res[max_patterns];
+		int _priority[max_patterns] = {0};
+		DFA* _dfas[max_patterns] = {nullptr};
+		uint _count = 0;
+		
+		uchar _classes[256] = {0};			// The byte class of each byte.
+		uint* _table = nullptr;				// _classCount transitions per state.
+		ulong* _accepts = nullptr;			// The patterns accepting in each state, bit i for pattern i.
+		uint* _winner = nullptr;			// The pattern reported in each state, _none if none accepts.
+		uint _states = 0;
+		uint _classCount = 0;
+		uint _dead = _none;					// The state no input leads out of, if any.
+	};
+}
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef PIKE_VM_H
+#define PIKE_VM_H
+
+#include <string>
+
+#include "_algorithms.h"
+#include "line.h"
+#include "nfa_program.h"
+
+#include "graphs.h"
+#include "containers.h"
+
+namespace algorithms
+{
+	using namespace graphs;
+	
+	/*
+	 * Pike VM:
+	 * 
+	 * NFA simulation which, besides whether the RE matches, tells what each of its groups matched.  Every NFA state
+	 * reachable after the input read so far is a thread, carrying the capture slots of the path which reached it
+	 * first.  Paths are explored in the order of the ε-transitions of nfa_program, which is their priority:  a loop
+	 * before its exit, the first alternative before the next, so that the quantifiers are greedy and the leftmost
+	 * alternative wins, as in Perl.  A state reached again by a later path keeps its first thread, so that a text
+	 * costs O(states + edges) per character, and no backtracking.  Looking one byte ahead, only the states matching
+	 * the next byte, or accepting at the end of the text, keep a thread and a copy of its slots.
+	 * 
+	 * The '(' of group k sets a pending start, its ')' the group's span, [pending start, position), so that a group
+	 * under a closure holds its last iteration, and a group skipped holds none.  Group 0 is the whole RE.
+	 * 
+	 * The captures cost a copy of the slots per thread and character, so NFA::recognizes() never runs this, only
+	 * NFA::match() does.  A pike_vm holds the scratch of its matches, thus serves one thread, and any number of them
+	 * may share one program.
+	*/
+	
+	class pike_vm
+	{
+		using stci = std::string::const_iterator;
+		using lici = algorithms::line::const_iterator;
+		
+		static constexpr const uint _none = graphs::undefined_uint;
+		static constexpr const uint _end = 256;		// The byte past the end of the text.
+		
+		// A state to visit, or with v == _none, a slot to restore once the states past it are visited.
+		struct frame
+		{
+			uint v;
+			uint slot;
+			uint value;
+		};
+	
+	public:
+		static constexpr const uint unmatched = graphs::undefined_uint;
+		
+		pike_vm() = delete;
+		pike_vm(const pike_vm&) = delete;
+		pike_vm(pike_vm&&) = delete;
+		pike_vm& operator=(const pike_vm&) = delete;
+		pike_vm& operator=(pike_vm&&) = delete;
+		
+		pike_vm(const nfa_program&) noexcept;
+		~pike_vm() noexcept;
+		
+		bool match(const std::string&);
+		bool match(const stci&, const stci&);
+		bool match(const lici&, const lici&);
+		
+		// After a match, group k spans [captures()[2k], captures()[2k+1]), or both are unmatched.
+		const uint* captures() const { return _captures; }
+		uint groups() const { return _groups; }
+	
+	private:
+		template <typename Iterator> bool _run(Iterator, const Iterator&);
+		void _add(const uint&, const uint&, uint*, const uint&, const uint&);
+		
+		const nfa_program* p_program = nullptr;
+		uint _M = 0;
+		uint _groups = 0;
+		uint _width = 0;						// Slots per thread:  the spans, 2 per group, then a pending start per group.
+		
+		uint* _states[2] = {nullptr, nullptr};	// The threads of the current and the next position, in priority order.
+		uint* _slots[2] = {nullptr, nullptr};	// _width slots per thread.
+		uint _count[2] = {0, 0};
+		visited_set _inList[2];
+		uint* _scratch = nullptr;
+		uint* _captures = nullptr;
+		frame* _stack = nullptr;
+	};
+}
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef PREFILTER_H
+#define PREFILTER_H
+
+#include "_algorithms.h"
+
+#include "graphs.h"
+#include "containers.h"
+
+namespace algorithms
+{
+	using namespace graphs;
+	
+	/*
+	 * Prefilter for NFA matching:
+	 * 
+	 * Two facts about the RE, read off its automaton at construction (the ε-graph, its directed_DFS_multi, the
+	 * bytes matched per state and the accepting state M, as for lazy_dfa):
+	 * 
+	 * 		The leading class:  the bytes a match can begin with, those of the states in the ε-closure of the start.
+	 * 		The required byte:  a byte every match contains, that of a match transition v -> v+1 without which M
+	 * 		cannot be reached.  Up to max_candidates single byte states are tried.
+	 * 
+	 * Neither exists if the RE matches the empty string.  admits() rejects a text lacking either, before any
+	 * matching, and skip() finds the next position a match may begin at, so that a search passes over the
+	 * regions no match can start in.  The required byte is found via memchr(), the leading class with SSE2
+	 * (AVX2 when compiled for it), 16 (32) bytes per compare, as the OR of up to max_ranges byte ranges, or
+	 * byte by byte if the class has more.  Other targets scan byte by byte throughout.
+	*/
+	
+	class prefilter
+	{
+	public:
+		static constexpr const uint max_ranges = 4;
+		static constexpr const uint max_candidates = 32;
+		static constexpr const uint none = 256;
+		
+		prefilter() = delete;
+		prefilter(const prefilter&) = delete;
+		prefilter(prefilter&&) = delete;
+		prefilter& operator=(const prefilter&) = delete;
+		prefilter& operator=(prefilter&&) = delete;
+		
+		prefilter(directed_DFS_multi&, const digraph&, const ulong*, const uint&) noexcept;
+		~prefilter() = default;
+		
+		bool admits(const char*, const ulong&) const;
+		bool contains(const char*, const ulong&) const;
+		ulong skip(const char*, const ulong&) const;
+		
+		bool leads(const uchar& c) const { return ((_first[c >> 6] >> (c & 63)) & 1) != 0; }
+		bool nullable() const { return _nullable; }
+		uint leading() const { return _firstCount; }
+		uint required() const { return _required; }
+	
+	private:
+		ulong _scan(const char*, const ulong&) const;
+		
+		ulong _first[4] = {0, 0, 0, 0};		// The leading class, bit c for byte c.
+		uint _firstCount = 0;
+		uint _required = none;
+		bool _nullable = false;
+		
+		uchar _low[max_ranges] = {0};		// The leading class as _rangeCount ranges [_low, _low + _width].
+		uchar _width[max_ranges] = {0};
+		uint _rangeCount = 0;
+	};
+}
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef READ_SYMBOL_GRAPH_H
 #define READ_SYMBOL_GRAPH_H
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 #include <string>
@@ -14,16 +15,15 @@
 namespace algorithms
 {
 	// This class that reads strings from file to build a symbol table, and then a graph/digraph.
+	// The names are interned in a hash_map, vertex v being the entry v, so that both directions of
+	// the mapping take O(1), and reading N names takes O(N).
 	
 	using namespace std;
 	using namespace graphs;
 	
 	class read_symbol_graph
 	{
-		using values = containers::array<std::string>;
-		using symbols = containers::symbol_table<std::string, uint>;
-		using symbols_iter = containers::symbol_table<std::string, uint>::iterator;
-		using symbols_citer = containers::symbol_table<std::string, uint>::const_iterator;
+		using symbols = containers::hash_map<uint>;
 		
 	public:
 		read_symbol_graph(const std::string& filename, const bool& useDigraph=false) noexcept
@@ -38,7 +38,7 @@ namespace algorithms
 			_readfile_str(filename, delim);
 			
 		}
-		~read_symbol_graph() { delete p_st; delete p_keys; delete p_g; };
+		~read_symbol_graph() { delete p_st; delete p_g; };
 		
 		void reset();
 		void readfile(const std::string& filename, const char& delim=' ', const bool& useDigraph=false);
@@ -57,8 +57,7 @@ namespace algorithms
 		
 		void _readfile_str(const std::string&, const char& delim=' ');
 		
-		containers::symbol_table<std::string, uint>* p_st = nullptr;		// string -> index
-		containers::array<std::string>* p_keys = nullptr;					// index -> string
+		symbols* p_st = nullptr;				// string -> index, and index -> string by key().
 		base_graph* p_g = nullptr;
 		
 		uint _V = 0;
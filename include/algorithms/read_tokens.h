@@ -1,23 +1,24 @@
 #ifndef READ_NUMBERS_H
 #define READ_NUMBERS_H
 
-#include <stdlib.h>		// Needed for atoi() and strtol().
-#include <limits.h>		// INT_MIN, INT_MAX, LONG_MIN, LONG_MAX.
-
-#include <cfloat>		// Somehow the double min/max ranges used by strtod() ended up in the C++ <cfloat>.
+#include <cerrno>		// ERANGE.
 #include <string>
 
 #include "_algorithms.h"
 #include "line.h"
 #include "file_input.h"
-#include "nfa.h"
+#include "number_scanner.h"
+#include "structural_index.h"
 
 namespace algorithms
 {
 	using namespace std;
-	class NFA;
 
-	// Read integer, real number, operator (currently on a "->"), and string tokens from a text file.
+	// Read integer, real number, operator (currently on a "->"), and string tokens from a text file.  The file is
+	// memory mapped, and tokens are read from views of its lines, so that no line is copied or allocated.  If
+	// streaming, the file is read instead in chunks of fixed size, as tokens are asked for, in constant memory.
+	// size() then counts only the lines read so far.  The delimiters of each line are indexed into bit masks by a
+	// structural_index, which tokens are then delimited by.
 	
 	class read_tokens
 	{
@@ -38,8 +39,8 @@ namespace algorithms
 		read_tokens(const read_tokens&) = delete;
 		read_tokens& operator=(const read_tokens&) = delete;
 		
-		read_tokens(const std::string&, const char&);
-		read_tokens(const std::string&, const std::string&);
+		read_tokens(const std::string&, const char&, const bool& streaming=false);
+		read_tokens(const std::string&, const std::string&, const bool& streaming=false);
 		~read_tokens();
 		
 		// Resets parsing of read file.
@@ -56,20 +57,18 @@ namespace algorithms
 		bool eof() const { return _EOF; }
 		bool eol() const { return _EOL; }
 		string str(const tokenType&) const;
-		bool ready() const { return _file_read_result == 0 and _re_initialized; }
+		bool ready() const { return _file_read_result == 0; }
 		void printfile() const;
-		uint size() const { return p_lines->size(); }
+		uint size() const { return p_fileinput->linecount(); }
 		
 	private:
 		
 		void _initialize();
+		void _index_line();
 
 		// Work horses:
 		tokenType _nextToken(li_citer, li_citer&, const li_citer&);
-		bool _isIntToken(li_citer, li_citer&, const li_citer&);
-		bool _isOperatorToken(li_citer, li_citer&, const li_citer&);
-		bool _isRealToken(li_citer, li_citer&, const li_citer&);
-		bool _isStrToken(li_citer, li_citer&, const li_citer&);
+		bool _isStrToken(li_citer, li_citer&);
 		void _setToken(li_citer, li_citer);
 		bool _set_int_token(li_citer, li_citer);
 		bool _set_real_token(li_citer, li_citer);
@@ -83,7 +82,9 @@ namespace algorithms
 		uint _previous_line = 0;
 		uint _previous_char = 0;
 		tokenType result = NONE;
-		arli_citer file_begin, file_end, current_line;
+		line_view _line;
+		ulong* _masks = nullptr;			// The delimiters of the line, bit i for its character i.
+		ulong _maskWords = 0;
 		li_citer lbegin, lend, tokenStart, tokenEnd, c;
 		
 		// Our results:
@@ -95,29 +96,15 @@ namespace algorithms
 		bool _EOL = false;
 		bool _EOF = false;
 		
-		// Token conversion variables:
-		char* p_digits = nullptr;
-		char* endptr = nullptr;
-		static constexpr const int longCharLength = 10;
-		// sign + 1 + '.' + (52 bit mantissa = 16 base10 digits) + 'e|E' + sign + 3 exponent digits.
-		static constexpr const int doubleCharLength = 25;
-		static constexpr const int base_10 = 10;
-
-		static const string _double_re;
-		static const string _integer_re;
-		static const string _operator_re;
-		NFA* _dre = nullptr;		// Pointer to RE for double.
-		NFA* _ire = nullptr;		// Pointer to RE for integer.
-		NFA* _ore = nullptr;		// Pointer to RE for "->" operator.
-		static const int _operator_re_size;
-		bool _re_initialized = false;
+		// Token identification and conversion, in one pass:
+		number_scanner _scanner;
 		
 		// File I/O variables:
 		int _file_read_result = 0;
 		string delimiters = {" "};
 		
 		algorithms::file_input* p_fileinput = nullptr;
-		arli* p_lines = nullptr;
+		structural_index* p_delimiters = nullptr;
 	};
 }
 
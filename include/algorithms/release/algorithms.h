@@ -11,7 +11,21 @@
 
 #include "algorithms/_algorithms_exceptions.h"
 #include "algorithms/_algorithms.h"
+#include "algorithms/bit_parallel.h"
+#include "algorithms/line_matcher.h"
+#include "algorithms/pattern_set.h"
+#include "algorithms/prefilter.h"
+#include "algorithms/nfa_program.h"
+#include "algorithms/nfa_matcher.h"
+#include "algorithms/pike_vm.h"
+#include "algorithms/structural_index.h"
+#include "algorithms/parallel_edge_reader.h"
+#include "algorithms/number_scanner.h"
+#include "algorithms/binary_graph.h"
+#include "algorithms/concurrent_union_find.h"
+#include "algorithms/dfa.h"
 #include "algorithms/file_input.h"
+#include "algorithms/lazy_dfa.h"
 #include "algorithms/line.h"
 #include "algorithms/nfa.h"
 #include "algorithms/readNumber.h"
@@ -26,7 +40,21 @@ namespace algorithms
 {
 	extern bool _DEBUG;
 	
+	class bit_parallel;
+	class line_matcher;
+	class pattern_set;
+	class prefilter;
+	class nfa_program;
+	class nfa_matcher;
+	class pike_vm;
+	class structural_index;
+	class parallel_edge_reader;
+	class number_scanner;
+	class binary_graph;
+	class concurrent_union_find;
+	class DFA;
 	class file_input;
+	class lazy_dfa;
 	class line;
 	class NFA;
 	class read_edge_weighted_digraph;
@@ -35,7 +63,7 @@ namespace algorithms
 	class read_symbol_graph;
 	class read_tokens;
 	class readNumber;
-	class weighted_union_find;
+	template <typename Index> class basic_weighted_union_find;
 	
 	// Used by file_read and derived classes
 	enum process_file_state : uchar {OK, READ_FILE_ERROR, REACHED_EOF, OVERFLOW, UNDERFLOW, INVALID};
@@ -0,0 +1,53 @@
+#ifndef STRUCTURAL_INDEX_H
+#define STRUCTURAL_INDEX_H
+
+#include <string>
+
+#include "_algorithms.h"
+
+namespace algorithms
+{
+	/*
+	 * Structural index:
+	 * 
+	 * Classifies text 64 bytes at a time into bit masks, bit i of a block set if its byte i is one of a set of
+	 * delimiters, in the manner of simdjson's structural indexing.  With AVX2 a block takes two 32 byte compares
+	 * per delimiter, with SSE2 four 16 byte ones, OR-ed together and gathered by movemask.  Other targets, or sets
+	 * of more than max_delimiters delimiters, look each byte up in a table.  The set "\n" indexes the newlines.
+	 * 
+	 * index() writes the masks of a text to an array of (n + 63) / 64 words, from which next() and next_clear()
+	 * find the next delimiter, or the next byte that is not one, by counting trailing zeros, instead of testing
+	 * the bytes in between one at a time.
+	*/
+	
+	class structural_index
+	{
+	public:
+		static constexpr const uint max_delimiters = 8;
+		
+		structural_index() = delete;
+		structural_index(const structural_index&) = delete;
+		structural_index(structural_index&&) = delete;
+		structural_index& operator=(const structural_index&) = delete;
+		structural_index& operator=(structural_index&&) = delete;
+		
+		structural_index(const std::string&) noexcept;
+		~structural_index() = default;
+		
+		ulong block(const char*) const;
+		void index(const char*, const ulong&, ulong*) const;
+		
+		bool is(const uchar& c) const { return ((_table[c >> 6] >> (c & 63)) & 1) != 0; }
+		uint size() const { return _count; }
+		
+		static ulong next(const ulong*, const ulong&, const ulong&);
+		static ulong next_clear(const ulong*, const ulong&, const ulong&);
+	
+	private:
+		ulong _table[4] = {0, 0, 0, 0};		// The delimiters, bit c for byte c.
+		uchar _delimiters[max_delimiters] = {0};
+		uint _count = 0;
+	};
+}
+
+#endif
@@ -12,26 +12,79 @@ namespace algorithms
 	 * 
 	 * The algorithm implements a collapsed binary tree, producing worst case performance
 	 * of log N for N items.  This is also the height of the binary tree.
+	 * 
+	 * The non-const find() additionally compresses the path it walks, so that repeated
+	 * querries approach constant time (inverse Ackermann, amortized):
+	 * 		HALVING:  every other site on the path is pointed to its grandparent.
+	 * 		SPLITTING:  every site on the path is pointed to its grandparent.
+	 * The const find() leaves the tree untouched, and is what const objects end up using.
+	 * 
+	 * Large inputs should use the batched formUnions() and connectedBatch().  These work
+	 * through the pairs in blocks, prefetching the parent links of a whole block before
+	 * walking any of them, so that the random accesses to _id overlap rather than stall one
+	 * after the other.  components() relabels the sites densely, 0 to count()-1.
+	 * 
+	 * The site type is a template parameter:  weighted_union_find uses uint, while
+	 * weighted_union_find64 uses ulong for more than 4 billion sites.  Both are instantiated
+	 * in weighted_union_find.cpp.
+	 * 
+	 * For use by several threads at once, see concurrent_union_find.
 	*/
 	
-	class weighted_union_find
+	template <typename Index>
+	class basic_weighted_union_find
 	{
+	public:
+		enum compression : uchar { NONE, HALVING, SPLITTING };
+		
+		struct site_pair
+		{
+			Index p;
+			Index q;
+		};
+	
 	private:
+		static constexpr const uint _block_size = 64;	// Pairs prefetched at once by the batched operations.
 		
-		uint* _id = nullptr;					// parent link (site indexed)
-		uint* _component_size = nullptr;		// size of component for roots (site indexed)
-		uint _count = 0;						// The number of components.
-		uint _size = 0;							// Size of memory allocation.
+		Index* _id = nullptr;					// parent link (site indexed)
+		Index* _component_size = nullptr;		// size of component for roots (site indexed)
+		Index* _labels = nullptr;				// dense component labels, allocated by components() (site indexed)
+		Index _count = 0;						// The number of components.
+		Index _size = 0;						// Size of memory allocation.
+		compression _compression = HALVING;		// Path compression used by the non-const find().
+		
+		void _prefetch(const site_pair* pairs, const Index& n) const;
+	
 	public:
-		weighted_union_find(const uint&) noexcept;
-		~weighted_union_find() noexcept { delete[] _id; delete[] _component_size; }
+		basic_weighted_union_find(const Index&) noexcept;
+		~basic_weighted_union_find() noexcept { delete[] _id; delete[] _component_size; delete[] _labels; }
+		
+		basic_weighted_union_find(const basic_weighted_union_find&) = delete;
+		basic_weighted_union_find& operator=(const basic_weighted_union_find&) = delete;
 		
-		uint count() const { return _count; }
+		Index count() const { return _count; }
+		Index size() const { return _size; }
+		compression getCompression() const { return _compression; }
+		void setCompression(const compression& c) { _compression = c; }
 		
-		bool connected(const uint& p, const uint& q) const { return find(p) == find(q); }
-		uint find(const uint& p) const;
-		void formUnion(const uint& p, const uint& q);
+		bool connected(const Index& p, const Index& q) const { return find(p) == find(q); }
+		bool connected(const Index& p, const Index& q) { return find(p) == find(q); }
+		Index find(const Index& p) const;
+		Index find(const Index& p);
+		void formUnion(const Index& p, const Index& q);
+		
+		// Batched operations over n pairs.  connectedBatch() writes one result per pair.
+		void formUnions(const site_pair* pairs, const Index& n);
+		void connectedBatch(const site_pair* pairs, const Index& n, bool* result);
+		
+		// Returns a label per site, where sites of a component share the label and labels run
+		// from 0 to count()-1 in order of the lowest site of each component.  The array is owned by
+		// the object and is valid until the next call to components() or destruction.
+		const Index* components();
 	};
+	
+	using weighted_union_find = basic_weighted_union_find<uint>;
+	using weighted_union_find64 = basic_weighted_union_find<ulong>;
 }
 
 #endif
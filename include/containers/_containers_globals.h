@@ -1,6 +1,8 @@
 #ifndef _CONTAINERS_GLOBALS_H
 #define _CONTAINERS_GLOBALS_H
 
+#include <algorithm>
+
 #include "_containers.h"
 #include "_allocator.h"
 
@@ -9,6 +11,33 @@ namespace containers
 	extern bool _DEBUG;
 	template <typename T>
 	_allocator<T> al;
+	
+	// Sort the n key-value pairs by key into sortedKeys and sortedValues, keeping of equal keys the one that came last,
+	// as a put() of each in turn would, and return the number of keys left.  O(n log n), used by the bulk loads.
+	template <typename Key, typename Value>
+	uint _sort_unique(const Key* keys, const Value* values, const uint& n, Key* sortedKeys, Value* sortedValues)
+	{
+		uint* order = new uint[n];
+		for(uint i = 0; i < n; i++)
+			order[i] = i;
+		
+		std::stable_sort(order, order + n, [keys](const uint& a, const uint& b) { return keys[a] < keys[b]; });
+		
+		uint m = 0;
+		for(uint i = 0; i < n; i++)
+		{
+			if(i + 1 < n && !(keys[order[i]] < keys[order[i + 1]]))
+				continue;
+			
+			sortedKeys[m] = keys[order[i]];
+			sortedValues[m] = values[order[i]];
+			m++;
+		}
+		
+		delete[] order;
+		
+		return m;
+	}
 }
 
 #endif
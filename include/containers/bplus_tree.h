@@ -0,0 +1,919 @@
+#ifndef BPLUS_TREE_H
+#define BPLUS_TREE_H
+
+#include <algorithm>
+#include <mutex>
+#include <shared_mutex>
+
+#include "_containers.h"
+#include "_containers_globals.h"
+
+namespace containers
+{
+	using uint = containers::uint;
+	
+	/*
+	 * An ordered symbol table with the API of symbol_table, kept in a B+ tree instead of a sorted array.
+	 * 
+	 * The keys and values are in the leaves, up to _order of each to a leaf, and the leaves are chained in key order.
+	 * An inner node has up to _order children, and for each the smallest key that may be in it (that of the first child
+	 * is not used), and the number of keys under it.  The nodes are wide, so the tree is shallow, log_64 N levels, and a
+	 * search reads a few contiguous arrays of keys rather than chasing a pointer per comparison.  The counts make rank()
+	 * and select() O(log N) as well:  rank() adds up the counts of the children left of the path to a key, and select()
+	 * subtracts them on its way down.
+	 * 
+	 * put() and remove() are O(log N):  a full node splits in two, pushing a key up, and a node less than half full takes
+	 * a key (or child) from a sibling, or is merged with one.  get(), contains(), rank(), select(), floor(), ceiling()
+	 * and size(low, high) are O(log N).  bulk_load() sorts its keys with those present in O(N log N), and builds the tree
+	 * from the sorted keys in O(N).
+	 * 
+	 * The nodes are allocated with new, one at a time, rather than by _allocator, whose bookkeeping is O(allocations)
+	 * a deallocation.  As symbol_table, the tree is thread safe:  the getters hold read_write_mutex shared, so that they
+	 * run concurrently, and the setters hold it alone; the private member functions assume it held.
+	*/
+	
+	template <typename Key, typename Value>
+	class bplus_tree
+	{
+	public:
+		// The big 5 + 1:
+		bplus_tree();
+		bplus_tree(const bplus_tree&);
+		bplus_tree(bplus_tree&&) noexcept;
+		bplus_tree<Key, Value>& operator=(const bplus_tree&);
+		bplus_tree<Key, Value>& operator=(bplus_tree&&) noexcept;
+		~bplus_tree() noexcept;
+		
+		// getters:
+		bool get(const Key&, Value&) const;
+		Value get(const Key&) const;
+		
+		// setters:
+		void put(const Key&, const Value&);
+		template <typename KeyIterator, typename ValueIterator>
+		void bulk_load(KeyIterator, const KeyIterator&, ValueIterator);
+		bool remove(const Key&, Key&);
+		bool removeMin(Key&);
+		bool removeMax(Key&);
+		void clear();
+		
+		// info:
+		bool contains(const Key& key) const;
+		bool empty() const;
+		uint size() const;
+		uint size(const Key&, const Key&) const;
+		bool min(Key&) const;
+		bool max(Key&) const;
+		bool floor(const Key&, Key&) const;
+		bool ceiling(const Key&, Key&) const;
+		uint rank(const Key&) const;
+		bool select(const uint&, Key&) const;
+		uint height() const;
+		
+		static constexpr const uint _order = 64;				// Keys to a leaf, children to an inner node.
+	
+	private:
+		static constexpr const uint _min = _order / 2;		// The fewest a node other than the root holds.
+		
+		struct _node
+		{
+			bool leaf = true;
+			uint n = 0;								// Keys in a leaf, children in an inner node.
+			Key keys[_order];
+		};
+		
+		struct _leaf : _node
+		{
+			Value values[_order];
+			_leaf* next = nullptr;
+			_leaf* prev = nullptr;
+		};
+		
+		struct _inner : _node
+		{
+			_node* children[_order];
+			uint sizes[_order];						// The keys under each child.
+		};
+		
+		static uint _count(const _node*);
+		static uint _child(const _inner*, const Key&);
+		static uint _position(const _leaf*, const Key&);
+		static void _destroy(_node*);
+		
+		bool _insert(_node*, const Key&, const Value&, _node*&);
+		bool _erase(_node*, const Key&);
+		void _rebalance(_inner*, const uint&);
+		void _merge(_inner*, const uint&);
+		void _build(Key*, Value*, const uint&);
+		uint _gather(Key*, Value*) const;
+		uint _rank(const Key&) const;
+		const Key* _select(uint) const;
+		const _leaf* _find(const Key&, uint&) const;
+		bool _remove(const Key&);
+		
+		_node* _root = nullptr;
+		_leaf* _first = nullptr;						// The leftmost and rightmost leaves.
+		_leaf* _last = nullptr;
+		uint N = 0;
+		
+		mutable std::shared_mutex read_write_mutex;
+	};
+	
+	template <typename Key, typename Value>
+	bplus_tree<Key, Value>::bplus_tree()
+	{
+		_first = _last = new _leaf;
+		_root = _first;
+	}
+	
+	template <typename Key, typename Value>
+	bplus_tree<Key, Value>::bplus_tree(const bplus_tree<Key, Value>& t) : bplus_tree()
+	{
+		*this = t;
+	}
+	
+	template <typename Key, typename Value>
+	bplus_tree<Key, Value>::bplus_tree(bplus_tree<Key, Value>&& t) noexcept : bplus_tree()
+	{
+		*this = std::move(t);
+	}
+	
+	template <typename Key, typename Value>
+	bplus_tree<Key, Value>& bplus_tree<Key, Value>::operator=(const bplus_tree<Key, Value>& t)
+	{
+		if(this == &t)
+			return *this;
+		
+		// Copy the keys in order, and build the tree from them.
+		Key* keys = nullptr;
+		Value* values = nullptr;
+		uint n = 0;
+		{
+			std::shared_lock<std::shared_mutex> sl(t.read_write_mutex);
+			keys = new Key[t.N + 1];
+			values = new Value[t.N + 1];
+			n = t._gather(keys, values);
+		}
+		
+		{
+			std::unique_lock<std::shared_mutex> ul(read_write_mutex);
+			_build(keys, values, n);
+		}
+		
+		delete[] keys;
+		delete[] values;
+		
+		return *this;
+	}
+	
+	template <typename Key, typename Value>
+	bplus_tree<Key, Value>& bplus_tree<Key, Value>::operator=(bplus_tree<Key, Value>&& t) noexcept
+	{
+		{
+			std::unique_lock<std::shared_mutex> ul(read_write_mutex);
+			
+			std::swap(_root, t._root);
+			std::swap(_first, t._first);
+			std::swap(_last, t._last);
+			std::swap(N, t.N);
+			
+			return *this;
+		}
+	}
+	
+	template <typename Key, typename Value>
+	bplus_tree<Key, Value>::~bplus_tree() noexcept
+	{
+		_destroy(_root);
+	}
+	
+	template <typename Key, typename Value>
+	void bplus_tree<Key, Value>::_destroy(_node* node)
+	{
+		if(node->leaf == false)
+		{
+			_inner* p = (_inner*)node;
+			for(uint c = 0; c < p->n; c++)
+				_destroy(p->children[c]);
+			
+			delete p;
+		}
+		else
+			delete (_leaf*)node;
+	}
+	
+	template <typename Key, typename Value>
+	uint bplus_tree<Key, Value>::_count(const _node* node)
+	{
+		if(node->leaf == true)
+			return node->n;
+		
+		uint count = 0;
+		const _inner* p = (const _inner*)node;
+		for(uint c = 0; c < p->n; c++)
+			count += p->sizes[c];
+		
+		return count;
+	}
+	
+	template <typename Key, typename Value>
+	uint bplus_tree<Key, Value>::_child(const _inner* p, const Key& key)
+	{
+		// The child whose range holds key:  the number of separators keys[1, n) at most key.
+		return std::upper_bound(p->keys + 1, p->keys + p->n, key) - (p->keys + 1);
+	}
+	
+	template <typename Key, typename Value>
+	uint bplus_tree<Key, Value>::_position(const _leaf* l, const Key& key)
+	{
+		return std::lower_bound(l->keys, l->keys + l->n, key) - l->keys;
+	}
+	
+	template <typename Key, typename Value>
+	const typename bplus_tree<Key, Value>::_leaf* bplus_tree<Key, Value>::_find(const Key& key, uint& i) const
+	{
+		// The leaf key is in, or would go in, and its position there.
+		const _node* node = _root;
+		while(node->leaf == false)
+			node = ((const _inner*)node)->children[_child((const _inner*)node, key)];
+		
+		i = _position((const _leaf*)node, key);
+		
+		return (const _leaf*)node;
+	}
+	
+	template <typename Key, typename Value>
+	bool bplus_tree<Key, Value>::get(const Key& key, Value& result) const
+	{
+		{
+			std::shared_lock<std::shared_mutex> sl(read_write_mutex);
+			
+			uint i = 0;
+			const _leaf* l = _find(key, i);
+			if(i < l->n && l->keys[i] == key)
+			{
+				result = l->values[i];
+				return true;
+			}
+			
+			return false;
+		}
+	}
+	
+	template <typename Key, typename Value>
+	Value bplus_tree<Key, Value>::get(const Key& key) const
+	{
+		// As with symbol_table, a key not in the tree gets an initialized Value.
+		Value result{};
+		get(key, result);
+		
+		return result;
+	}
+	
+	template <typename Key, typename Value>
+	bool bplus_tree<Key, Value>::contains(const Key& key) const
+	{
+		{
+			std::shared_lock<std::shared_mutex> sl(read_write_mutex);
+			
+			uint i = 0;
+			const _leaf* l = _find(key, i);
+			
+			return i < l->n && l->keys[i] == key;
+		}
+	}
+	
+	template <typename Key, typename Value>
+	void bplus_tree<Key, Value>::put(const Key& key, const Value& value)
+	{
+		{
+			std::unique_lock<std::shared_mutex> ul(read_write_mutex);
+			
+			_node* split = nullptr;
+			if(_insert(_root, key, value, split) == true)
+				N++;
+			
+			// The root split:  grow a level.
+			if(split != nullptr)
+			{
+				_inner* root = new _inner;
+				root->leaf = false;
+				root->n = 2;
+				root->children[0] = _root;
+				root->children[1] = split;
+				root->keys[1] = split->keys[0];
+				root->sizes[0] = _count(_root);
+				root->sizes[1] = _count(split);
+				_root = root;
+			}
+		}
+	}
+	
+	template <typename Key, typename Value>
+	bool bplus_tree<Key, Value>::_insert(_node* node, const Key& key, const Value& value, _node*& split)
+	{
+		// Put key in the subtree of node, and return whether it is new.  If node was full, set split to the node holding
+		// its upper half, keys[0] of which goes up to the parent.
+		if(node->leaf == true)
+		{
+			_leaf* l = (_leaf*)node;
+			uint i = _position(l, key);
+			if(i < l->n && l->keys[i] == key)
+			{
+				l->values[i] = value;
+				return false;
+			}
+			
+			if(l->n == _order)
+			{
+				_leaf* r = new _leaf;
+				r->n = l->n - _min;
+				std::move(l->keys + _min, l->keys + l->n, r->keys);
+				std::move(l->values + _min, l->values + l->n, r->values);
+				l->n = _min;
+				
+				r->next = l->next;
+				r->prev = l;
+				if(l->next != nullptr)
+					l->next->prev = r;
+				else
+					_last = r;
+				
+				l->next = r;
+				split = r;
+				
+				if(i > l->n)
+				{
+					i -= l->n;
+					l = r;
+				}
+			}
+			
+			std::move_backward(l->keys + i, l->keys + l->n, l->keys + l->n + 1);
+			std::move_backward(l->values + i, l->values + l->n, l->values + l->n + 1);
+			l->keys[i] = key;
+			l->values[i] = value;
+			l->n++;
+			
+			return true;
+		}
+		
+		_inner* p = (_inner*)node;
+		uint c = _child(p, key);
+		_node* childSplit = nullptr;
+		bool added = _insert(p->children[c], key, value, childSplit);
+		if(added == true)
+			p->sizes[c]++;
+		
+		if(childSplit == nullptr)
+			return added;
+		
+		// Add the new child after c, splitting p first if full.
+		p->sizes[c] = _count(p->children[c]);
+		uint at = c + 1;
+		_inner* q = p;
+		if(p->n == _order)
+		{
+			_inner* r = new _inner;
+			r->leaf = false;
+			r->n = p->n - _min;
+			std::move(p->keys + _min, p->keys + p->n, r->keys);
+			std::copy(p->children + _min, p->children + p->n, r->children);
+			std::copy(p->sizes + _min, p->sizes + p->n, r->sizes);
+			p->n = _min;
+			split = r;
+			
+			if(at > p->n)
+			{
+				at -= p->n;
+				q = r;
+			}
+		}
+		
+		std::move_backward(q->keys + at, q->keys + q->n, q->keys + q->n + 1);
+		std::copy_backward(q->children + at, q->children + q->n, q->children + q->n + 1);
+		std::copy_backward(q->sizes + at, q->sizes + q->n, q->sizes + q->n + 1);
+		q->keys[at] = childSplit->keys[0];
+		q->children[at] = childSplit;
+		q->sizes[at] = _count(childSplit);
+		q->n++;
+		
+		// An inner childSplit passed its smallest key up in keys[0], which it doesn't use.
+		return added;
+	}
+	
+	template <typename Key, typename Value>
+	bool bplus_tree<Key, Value>::remove(const Key& key, Key& result)
+	{
+		{
+			std::unique_lock<std::shared_mutex> ul(read_write_mutex);
+			
+			if(_remove(key) == false)
+				return false;
+			
+			result = key;
+			return true;
+		}
+	}
+	
+	template <typename Key, typename Value>
+	bool bplus_tree<Key, Value>::_remove(const Key& key)
+	{
+		if(_erase(_root, key) == false)
+			return false;
+		
+		N--;
+		
+		// The root down to a single child:  drop a level.
+		if(_root->leaf == false && _root->n == 1)
+		{
+			_inner* root = (_inner*)_root;
+			_root = root->children[0];
+			delete root;
+		}
+		
+		return true;
+	}
+	
+	template <typename Key, typename Value>
+	bool bplus_tree<Key, Value>::removeMin(Key& result)
+	{
+		{
+			std::unique_lock<std::shared_mutex> ul(read_write_mutex);
+			
+			if(N == 0)
+				return false;
+			
+			result = _first->keys[0];
+			return _remove(result);
+		}
+	}
+	
+	template <typename Key, typename Value>
+	bool bplus_tree<Key, Value>::removeMax(Key& result)
+	{
+		{
+			std::unique_lock<std::shared_mutex> ul(read_write_mutex);
+			
+			if(N == 0)
+				return false;
+			
+			result = _last->keys[_last->n - 1];
+			return _remove(result);
+		}
+	}
+	
+	template <typename Key, typename Value>
+	bool bplus_tree<Key, Value>::_erase(_node* node, const Key& key)
+	{
+		if(node->leaf == true)
+		{
+			_leaf* l = (_leaf*)node;
+			uint i = _position(l, key);
+			if(i == l->n || !(l->keys[i] == key))
+				return false;
+			
+			std::move(l->keys + i + 1, l->keys + l->n, l->keys + i);
+			std::move(l->values + i + 1, l->values + l->n, l->values + i);
+			l->n--;
+			
+			return true;
+		}
+		
+		_inner* p = (_inner*)node;
+		uint c = _child(p, key);
+		if(_erase(p->children[c], key) == false)
+			return false;
+		
+		p->sizes[c]--;
+		if(p->children[c]->n < _min)
+			_rebalance(p, c);
+		
+		return true;
+	}
+	
+	template <typename Key, typename Value>
+	void bplus_tree<Key, Value>::_rebalance(_inner* p, const uint& c)
+	{
+		// Child c of p is one short of half full:  take from a sibling with more than half, else merge with one.
+		_node* child = p->children[c];
+		_node* left = c > 0 ? p->children[c - 1] : nullptr;
+		_node* right = c + 1 < p->n ? p->children[c + 1] : nullptr;
+		
+		if(left != nullptr && left->n > _min)
+		{
+			// Move the last of left to the front of child.
+			uint moved = 1;
+			std::move_backward(child->keys, child->keys + child->n, child->keys + child->n + 1);
+			if(child->leaf == true)
+			{
+				_leaf* l = (_leaf*)left;
+				_leaf* d = (_leaf*)child;
+				std::move_backward(d->values, d->values + d->n, d->values + d->n + 1);
+				d->keys[0] = l->keys[l->n - 1];
+				d->values[0] = l->values[l->n - 1];
+				p->keys[c] = d->keys[0];
+			}
+			else
+			{
+				_inner* l = (_inner*)left;
+				_inner* d = (_inner*)child;
+				std::copy_backward(d->children, d->children + d->n, d->children + d->n + 1);
+				std::copy_backward(d->sizes, d->sizes + d->n, d->sizes + d->n + 1);
+				d->children[0] = l->children[l->n - 1];
+				d->sizes[0] = l->sizes[l->n - 1];
+				d->keys[1] = p->keys[c];
+				p->keys[c] = l->keys[l->n - 1];
+				moved = d->sizes[0];
+			}
+			
+			left->n--;
+			child->n++;
+			p->sizes[c - 1] -= moved;
+			p->sizes[c] += moved;
+		}
+		else if(right != nullptr && right->n > _min)
+		{
+			// Move the first of right to the back of child.
+			uint moved = 1;
+			if(child->leaf == true)
+			{
+				_leaf* r = (_leaf*)right;
+				_leaf* d = (_leaf*)child;
+				d->keys[d->n] = r->keys[0];
+				d->values[d->n] = r->values[0];
+				std::move(r->keys + 1, r->keys + r->n, r->keys);
+				std::move(r->values + 1, r->values + r->n, r->values);
+				p->keys[c + 1] = r->keys[0];
+			}
+			else
+			{
+				_inner* r = (_inner*)right;
+				_inner* d = (_inner*)child;
+				d->children[d->n] = r->children[0];
+				d->sizes[d->n] = r->sizes[0];
+				d->keys[d->n] = p->keys[c + 1];
+				p->keys[c + 1] = r->keys[1];
+				moved = r->sizes[0];
+				std::move(r->keys + 1, r->keys + r->n, r->keys);
+				std::copy(r->children + 1, r->children + r->n, r->children);
+				std::copy(r->sizes + 1, r->sizes + r->n, r->sizes);
+			}
+			
+			right->n--;
+			child->n++;
+			p->sizes[c] += moved;
+			p->sizes[c + 1] -= moved;
+		}
+		else if(left != nullptr)
+			_merge(p, c - 1);
+		else
+			_merge(p, c);
+	}
+	
+	template <typename Key, typename Value>
+	void bplus_tree<Key, Value>::_merge(_inner* p, const uint& c)
+	{
+		// Append child c+1 of p to child c, and drop it:  the two hold at most 2 _min - 1 <= _order.
+		_node* left = p->children[c];
+		_node* right = p->children[c + 1];
+		if(left->leaf == true)
+		{
+			_leaf* l = (_leaf*)left;
+			_leaf* r = (_leaf*)right;
+			std::move(r->keys, r->keys + r->n, l->keys + l->n);
+			std::move(r->values, r->values + r->n, l->values + l->n);
+			l->next = r->next;
+			if(r->next != nullptr)
+				r->next->prev = l;
+			else
+				_last = l;
+			
+			l->n += r->n;
+			delete r;
+		}
+		else
+		{
+			_inner* l = (_inner*)left;
+			_inner* r = (_inner*)right;
+			r->keys[0] = p->keys[c + 1];			// The separator comes down between the two.
+			std::move(r->keys, r->keys + r->n, l->keys + l->n);
+			std::copy(r->children, r->children + r->n, l->children + l->n);
+			std::copy(r->sizes, r->sizes + r->n, l->sizes + l->n);
+			l->n += r->n;
+			delete r;
+		}
+		
+		p->sizes[c] += p->sizes[c + 1];
+		std::move(p->keys + c + 2, p->keys + p->n, p->keys + c + 1);
+		std::copy(p->children + c + 2, p->children + p->n, p->children + c + 1);
+		std::copy(p->sizes + c + 2, p->sizes + p->n, p->sizes + c + 1);
+		p->n--;
+	}
+	
+	template <typename Key, typename Value>
+	template <typename KeyIterator, typename ValueIterator>
+	void bplus_tree<Key, Value>::bulk_load(KeyIterator key, const KeyIterator& end, ValueIterator value)
+	{
+		// Put the keys [key, end) with the values from value on, as if by put() in turn:  sort them with the keys present,
+		// and build the tree anew from the sorted keys.
+		{
+			std::unique_lock<std::shared_mutex> ul(read_write_mutex);
+			
+			uint n = N;
+			for(KeyIterator k = key; k != end; k++)
+				n++;
+			
+			Key* allKeys = new Key[n + 1];
+			Value* allValues = new Value[n + 1];
+			_gather(allKeys, allValues);
+			for(uint i = N; i < n; i++, key++, value++)
+			{
+				allKeys[i] = *key;
+				allValues[i] = *value;
+			}
+			
+			Key* sortedKeys = new Key[n + 1];
+			Value* sortedValues = new Value[n + 1];
+			uint m = _sort_unique(allKeys, allValues, n, sortedKeys, sortedValues);
+			_build(sortedKeys, sortedValues, m);
+			
+			delete[] allKeys;
+			delete[] allValues;
+			delete[] sortedKeys;
+			delete[] sortedValues;
+		}
+	}
+	
+	template <typename Key, typename Value>
+	uint bplus_tree<Key, Value>::_gather(Key* keys, Value* values) const
+	{
+		// Copy out the keys and values in order, by the chain of leaves.
+		uint n = 0;
+		for(const _leaf* l = _first; l != nullptr; l = l->next)
+		{
+			std::copy(l->keys, l->keys + l->n, keys + n);
+			std::copy(l->values, l->values + l->n, values + n);
+			n += l->n;
+		}
+		
+		return n;
+	}
+	
+	template <typename Key, typename Value>
+	void bplus_tree<Key, Value>::_build(Key* keys, Value* values, const uint& n)
+	{
+		// Replace the tree by one of the n sorted, distinct keys:  spread them evenly over as few leaves as hold them,
+		// so that each is at least half full, then the leaves over as few inner nodes, and so on up to a single root.
+		_destroy(_root);
+		N = n;
+		
+		uint count = (n + _order - 1) / _order;
+		if(count == 0)
+			count = 1;
+		
+		_node** level = new _node*[count];
+		_leaf* previous = nullptr;
+		for(uint i = 0, at = 0; i < count; i++)
+		{
+			_leaf* l = new _leaf;
+			l->n = n / count + (i < n % count ? 1 : 0);
+			std::move(keys + at, keys + at + l->n, l->keys);
+			std::move(values + at, values + at + l->n, l->values);
+			at += l->n;
+			
+			l->prev = previous;
+			if(previous != nullptr)
+				previous->next = l;
+			else
+				_first = l;
+			
+			previous = l;
+			level[i] = l;
+		}
+		
+		_last = previous;
+		
+		while(count > 1)
+		{
+			uint parents = (count + _order - 1) / _order;
+			_node** above = new _node*[parents];
+			for(uint i = 0, at = 0; i < parents; i++)
+			{
+				_inner* p = new _inner;
+				p->leaf = false;
+				p->n = count / parents + (i < count % parents ? 1 : 0);
+				for(uint c = 0; c < p->n; c++, at++)
+				{
+					p->children[c] = level[at];
+					p->sizes[c] = _count(level[at]);
+					p->keys[c] = level[at]->keys[0];
+				}
+				
+				above[i] = p;
+			}
+			
+			delete[] level;
+			level = above;
+			count = parents;
+		}
+		
+		_root = level[0];
+		delete[] level;
+	}
+	
+	template <typename Key, typename Value>
+	void bplus_tree<Key, Value>::clear()
+	{
+		{
+			std::unique_lock<std::shared_mutex> ul(read_write_mutex);
+			
+			_destroy(_root);
+			_first = _last = new _leaf;
+			_root = _first;
+			N = 0;
+		}
+	}
+	
+	template <typename Key, typename Value>
+	bool bplus_tree<Key, Value>::empty() const
+	{
+		{
+			std::shared_lock<std::shared_mutex> sl(read_write_mutex);
+			return N == 0;
+		}
+	}
+	
+	template <typename Key, typename Value>
+	uint bplus_tree<Key, Value>::size() const
+	{
+		{
+			std::shared_lock<std::shared_mutex> sl(read_write_mutex);
+			return N;
+		}
+	}
+	
+	template <typename Key, typename Value>
+	uint bplus_tree<Key, Value>::height() const
+	{
+		{
+			std::shared_lock<std::shared_mutex> sl(read_write_mutex);
+			
+			uint h = 1;
+			for(const _node* node = _root; node->leaf == false; node = ((const _inner*)node)->children[0])
+				h++;
+			
+			return h;
+		}
+	}
+	
+	template <typename Key, typename Value>
+	uint bplus_tree<Key, Value>::_rank(const Key& key) const
+	{
+		// The number of keys less than key:  those under the children left of the path to key, and left of it in its leaf.
+		uint rank = 0;
+		const _node* node = _root;
+		while(node->leaf == false)
+		{
+			const _inner* p = (const _inner*)node;
+			uint c = _child(p, key);
+			for(uint i = 0; i < c; i++)
+				rank += p->sizes[i];
+			
+			node = p->children[c];
+		}
+		
+		return rank + _position((const _leaf*)node, key);
+	}
+	
+	template <typename Key, typename Value>
+	const Key* bplus_tree<Key, Value>::_select(uint i) const
+	{
+		// The key of rank i, found by counting down the tree, or nullptr if i >= N.
+		if(i >= N)
+			return nullptr;
+		
+		const _node* node = _root;
+		while(node->leaf == false)
+		{
+			const _inner* p = (const _inner*)node;
+			uint c = 0;
+			while(i >= p->sizes[c])
+				i -= p->sizes[c++];
+			
+			node = p->children[c];
+		}
+		
+		return &node->keys[i];
+	}
+	
+	template <typename Key, typename Value>
+	uint bplus_tree<Key, Value>::rank(const Key& key) const
+	{
+		{
+			std::shared_lock<std::shared_mutex> sl(read_write_mutex);
+			return _rank(key);
+		}
+	}
+	
+	template <typename Key, typename Value>
+	bool bplus_tree<Key, Value>::select(const uint& i, Key& result) const
+	{
+		{
+			std::shared_lock<std::shared_mutex> sl(read_write_mutex);
+			
+			const Key* key = _select(i);
+			if(key == nullptr)
+				return false;
+			
+			result = *key;
+			return true;
+		}
+	}
+	
+	template <typename Key, typename Value>
+	bool bplus_tree<Key, Value>::min(Key& result) const
+	{
+		{
+			std::shared_lock<std::shared_mutex> sl(read_write_mutex);
+			
+			if(N == 0)
+				return false;
+			
+			result = _first->keys[0];
+			return true;
+		}
+	}
+	
+	template <typename Key, typename Value>
+	bool bplus_tree<Key, Value>::max(Key& result) const
+	{
+		{
+			std::shared_lock<std::shared_mutex> sl(read_write_mutex);
+			
+			if(N == 0)
+				return false;
+			
+			result = _last->keys[_last->n - 1];
+			return true;
+		}
+	}
+	
+	template <typename Key, typename Value>
+	bool bplus_tree<Key, Value>::floor(const Key& key, Key& key_floor) const
+	{
+		// The largest key less than or equal to key.
+		{
+			std::shared_lock<std::shared_mutex> sl(read_write_mutex);
+			
+			uint r = _rank(key);
+			const Key* found = _select(r);
+			if(found != nullptr && *found == key)
+			{
+				key_floor = *found;
+				return true;
+			}
+			
+			if(r == 0)
+				return false;
+			
+			key_floor = *_select(r - 1);
+			return true;
+		}
+	}
+	
+	template <typename Key, typename Value>
+	bool bplus_tree<Key, Value>::ceiling(const Key& key, Key& key_ceiling) const
+	{
+		// The smallest key larger than or equal to key.
+		{
+			std::shared_lock<std::shared_mutex> sl(read_write_mutex);
+			
+			const Key* found = _select(_rank(key));
+			if(found == nullptr)
+				return false;
+			
+			key_ceiling = *found;
+			return true;
+		}
+	}
+	
+	template <typename Key, typename Value>
+	uint bplus_tree<Key, Value>::size(const Key& low, const Key& high) const
+	{
+		// The number of keys in [low, high].
+		{
+			std::shared_lock<std::shared_mutex> sl(read_write_mutex);
+			
+			if(high < low)
+				return 0;
+			
+			uint r = _rank(high);
+			const Key* found = _select(r);
+			
+			return r - _rank(low) + (found != nullptr && *found == high ? 1 : 0);
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,394 @@
+#ifndef HASH_MAP_H
+#define HASH_MAP_H
+
+#include <cstring>
+#include <string>
+#include <utility>
+
+#include "_containers.h"
+
+namespace containers
+{
+	using uint = containers::uint;
+	
+	/*
+	 * A hash map from strings to Value, meant to intern names:  large numbers of keys, put once and looked up many times.
+	 * 
+	 * The keys are interned, copied back to back into one growing arena of characters, so that a key costs its length
+	 * and nothing per allocation.  The entries are numbered in the order of their put(), entry i having key(i) and
+	 * value(i), and are stored as parallel arrays:  where each key starts in the arena, its hash, and its value.
+	 * 
+	 * Lookup is by open addressing with linear probing, in a power of 2 table of entry numbers kept at most half full.
+	 * A slot is compared by the stored hash first, and the characters only when the hashes agree.  When the table fills,
+	 * it doubles and the entries are reinserted by their stored hashes, without hashing the keys again.  put(), get()
+	 * and contains() are O(1) on average, O(length) of the key, whatever the number of keys.
+	 * 
+	 * Keys are not removed:  an interned key keeps its number for the life of the map.  The storage is allocated with
+	 * new[] rather than by _allocator, so the map is not bound by its _max_size.  Unlike symbol_table, the map holds no
+	 * mutexes; threads sharing one must coordinate, as they must for iteration over symbol_table.
+	*/
+	
+	template <typename Value>
+	class hash_map
+	{
+	public:
+		// The big 5 + 1:
+		hash_map();
+		hash_map(const uint&);
+		hash_map(const hash_map&);
+		hash_map(hash_map&&) noexcept;
+		hash_map<Value>& operator=(const hash_map&);
+		hash_map<Value>& operator=(hash_map&&) noexcept;
+		~hash_map() noexcept;
+		
+		// getters:
+		bool get(const std::string&, Value&) const;
+		bool get(const char*, const uint&, Value&) const;
+		Value get(const std::string&) const;
+		
+		// setters:
+		void put(const std::string&, const Value&);
+		void put(const char*, const uint&, const Value&);
+		void clear();
+		
+		// info:
+		bool contains(const std::string&) const;
+		bool contains(const char*, const uint&) const;
+		uint find(const char*, const uint&) const;			// The number of the key's entry, or undefined_uint.
+		bool empty() const { return N == 0; }
+		uint size() const { return N; }
+		ulong arena() const { return _keyStart[N]; }			// The characters of all the keys.
+		
+		// The entries, in the order they were put:
+		std::string key(const uint& i) const { return std::string(_arena + _keyStart[i], _keyStart[i + 1] - _keyStart[i]); }
+		void key(const uint& i, const char*& b, const char*& e) const { b = _arena + _keyStart[i]; e = _arena + _keyStart[i + 1]; }
+		Value& value(const uint& i) { return _values[i]; }
+		const Value& value(const uint& i) const { return _values[i]; }
+	
+	private:
+		static ulong _hash(const char*, const uint&);
+		uint _slot(const char*, const uint&, const ulong&) const;
+		void _allocate(const uint&);
+		void _release();
+		void _copy(const hash_map&);
+		void _grow_entries();
+		void _grow_slots();
+		void _grow_arena(const ulong&);
+		
+		static constexpr const uint _empty = undefined_uint;
+		
+		uint* _slots = nullptr;				// Entry numbers, _empty if none.
+		uint _mask = 0;						// The number of slots, less one.
+		
+		ulong* _keyStart = nullptr;			// Entry i has the key _arena[_keyStart[i], _keyStart[i+1]).
+		ulong* _hashes = nullptr;
+		Value* _values = nullptr;
+		uint _capacity = 0;					// Entries allocated.
+		uint N = 0;							// Entries in [0, N).
+		
+		char* _arena = nullptr;
+		ulong _arenaCapacity = 0;
+	};
+	
+	template <typename Value>
+	hash_map<Value>::hash_map()
+	{
+		_allocate(default_size);
+	}
+	
+	template <typename Value>
+	hash_map<Value>::hash_map(const uint& size)
+	{
+		// Room for size keys without growing.
+		_allocate(size > default_size ? size : default_size);
+	}
+	
+	template <typename Value>
+	hash_map<Value>::hash_map(const hash_map<Value>& m)
+	{
+		_copy(m);
+	}
+	
+	template <typename Value>
+	hash_map<Value>::hash_map(hash_map<Value>&& m) noexcept
+	{
+		_allocate(default_size);
+		*this = std::move(m);
+	}
+	
+	template <typename Value>
+	hash_map<Value>& hash_map<Value>::operator=(const hash_map<Value>& m)
+	{
+		if(this != &m)
+		{
+			_release();
+			_copy(m);
+		}
+		
+		return *this;
+	}
+	
+	template <typename Value>
+	hash_map<Value>& hash_map<Value>::operator=(hash_map<Value>&& m) noexcept
+	{
+		std::swap(_slots, m._slots);
+		std::swap(_mask, m._mask);
+		std::swap(_keyStart, m._keyStart);
+		std::swap(_hashes, m._hashes);
+		std::swap(_values, m._values);
+		std::swap(_capacity, m._capacity);
+		std::swap(N, m.N);
+		std::swap(_arena, m._arena);
+		std::swap(_arenaCapacity, m._arenaCapacity);
+		
+		return *this;
+	}
+	
+	template <typename Value>
+	hash_map<Value>::~hash_map() noexcept
+	{
+		_release();
+	}
+	
+	template <typename Value>
+	void hash_map<Value>::_allocate(const uint& size)
+	{
+		// Slots for twice the entries, rounded up to a power of 2, and 8 characters per key to start with.
+		uint slots = 16;
+		while(slots < 2 * size)
+			slots *= 2;
+		
+		_slots = new uint[slots];
+		for(uint s = 0; s < slots; s++)
+			_slots[s] = _empty;
+		
+		_mask = slots - 1;
+		_capacity = size;
+		_keyStart = new ulong[_capacity + 1];
+		_keyStart[0] = 0;
+		_hashes = new ulong[_capacity];
+		_values = new Value[_capacity];
+		N = 0;
+		
+		_arenaCapacity = 8ul * size;
+		_arena = new char[_arenaCapacity];
+	}
+	
+	template <typename Value>
+	void hash_map<Value>::_release()
+	{
+		delete[] _slots;
+		delete[] _keyStart;
+		delete[] _hashes;
+		delete[] _values;
+		delete[] _arena;
+		
+		_slots = nullptr;
+		_keyStart = nullptr;
+		_hashes = nullptr;
+		_values = nullptr;
+		_arena = nullptr;
+		_mask = 0;
+		_capacity = 0;
+		_arenaCapacity = 0;
+		N = 0;
+	}
+	
+	template <typename Value>
+	void hash_map<Value>::_copy(const hash_map<Value>& m)
+	{
+		_mask = m._mask;
+		_slots = new uint[_mask + 1];
+		memcpy(_slots, m._slots, (_mask + 1) * sizeof(uint));
+		
+		_capacity = m._capacity;
+		N = m.N;
+		_keyStart = new ulong[_capacity + 1];
+		memcpy(_keyStart, m._keyStart, (N + 1) * sizeof(ulong));
+		_hashes = new ulong[_capacity];
+		memcpy(_hashes, m._hashes, N * sizeof(ulong));
+		_values = new Value[_capacity];
+		for(uint i = 0; i < N; i++)
+			_values[i] = m._values[i];
+		
+		_arenaCapacity = m._arenaCapacity;
+		_arena = new char[_arenaCapacity];
+		memcpy(_arena, m._arena, _keyStart[N]);
+	}
+	
+	template <typename Value>
+	void hash_map<Value>::clear()
+	{
+		for(uint s = 0; s <= _mask; s++)
+			_slots[s] = _empty;
+		
+		N = 0;
+	}
+	
+	template <typename Value>
+	ulong hash_map<Value>::_hash(const char* key, const uint& length)
+	{
+		// FNV-1a, 64 bits:  the low bits pick the slot.
+		ulong h = 14695981039346656037ul;
+		for(uint i = 0; i < length; i++)
+		{
+			h ^= (uchar)key[i];
+			h *= 1099511628211ul;
+		}
+		
+		return h ^ (h >> 32);
+	}
+	
+	template <typename Value>
+	uint hash_map<Value>::_slot(const char* key, const uint& length, const ulong& h) const
+	{
+		// Probe from the slot of the hash to the key's slot, or to the empty slot where it would go.
+		uint s = h & _mask;
+		for(uint i = _slots[s]; i != _empty; s = (s + 1) & _mask, i = _slots[s])
+			if(_hashes[i] == h && _keyStart[i + 1] - _keyStart[i] == length && memcmp(_arena + _keyStart[i], key, length) == 0)
+				break;
+		
+		return s;
+	}
+	
+	template <typename Value>
+	uint hash_map<Value>::find(const char* key, const uint& length) const
+	{
+		return _slots[_slot(key, length, _hash(key, length))];
+	}
+	
+	template <typename Value>
+	bool hash_map<Value>::get(const char* key, const uint& length, Value& result) const
+	{
+		uint i = find(key, length);
+		if(i == _empty)
+			return false;
+		
+		result = _values[i];
+		return true;
+	}
+	
+	template <typename Value>
+	bool hash_map<Value>::get(const std::string& key, Value& result) const
+	{
+		return get(key.data(), key.size(), result);
+	}
+	
+	template <typename Value>
+	Value hash_map<Value>::get(const std::string& key) const
+	{
+		// As with symbol_table, a key not in the map gets an initialized Value.
+		Value result{};
+		get(key, result);
+		
+		return result;
+	}
+	
+	template <typename Value>
+	bool hash_map<Value>::contains(const char* key, const uint& length) const
+	{
+		return find(key, length) != _empty;
+	}
+	
+	template <typename Value>
+	bool hash_map<Value>::contains(const std::string& key) const
+	{
+		return contains(key.data(), key.size());
+	}
+	
+	template <typename Value>
+	void hash_map<Value>::put(const char* key, const uint& length, const Value& value)
+	{
+		// Update the value if the key is in the map; else intern the key as entry N.
+		ulong h = _hash(key, length);
+		uint s = _slot(key, length, h);
+		if(_slots[s] != _empty)
+		{
+			_values[_slots[s]] = value;
+			return;
+		}
+		
+		if(N == _capacity)
+			_grow_entries();
+		
+		if(_keyStart[N] + length > _arenaCapacity)
+			_grow_arena(_keyStart[N] + length);
+		
+		memcpy(_arena + _keyStart[N], key, length);
+		_keyStart[N + 1] = _keyStart[N] + length;
+		_hashes[N] = h;
+		_values[N] = value;
+		_slots[s] = N;
+		N++;
+		
+		if(2 * N > _mask + 1)
+			_grow_slots();
+	}
+	
+	template <typename Value>
+	void hash_map<Value>::put(const std::string& key, const Value& value)
+	{
+		put(key.data(), key.size(), value);
+	}
+	
+	template <typename Value>
+	void hash_map<Value>::_grow_entries()
+	{
+		uint capacity = 2 * _capacity;
+		
+		ulong* keyStart = new ulong[capacity + 1];
+		memcpy(keyStart, _keyStart, (N + 1) * sizeof(ulong));
+		delete[] _keyStart;
+		_keyStart = keyStart;
+		
+		ulong* hashes = new ulong[capacity];
+		memcpy(hashes, _hashes, N * sizeof(ulong));
+		delete[] _hashes;
+		_hashes = hashes;
+		
+		Value* values = new Value[capacity];
+		for(uint i = 0; i < N; i++)
+			values[i] = std::move(_values[i]);
+		
+		delete[] _values;
+		_values = values;
+		_capacity = capacity;
+	}
+	
+	template <typename Value>
+	void hash_map<Value>::_grow_slots()
+	{
+		// Double the table, and reinsert the entries by their stored hashes:  all keys differ, so no compares.
+		uint slots = 2 * (_mask + 1);
+		delete[] _slots;
+		_slots = new uint[slots];
+		for(uint s = 0; s < slots; s++)
+			_slots[s] = _empty;
+		
+		_mask = slots - 1;
+		for(uint i = 0; i < N; i++)
+		{
+			uint s = _hashes[i] & _mask;
+			while(_slots[s] != _empty)
+				s = (s + 1) & _mask;
+			
+			_slots[s] = i;
+		}
+	}
+	
+	template <typename Value>
+	void hash_map<Value>::_grow_arena(const ulong& needed)
+	{
+		ulong capacity = 2 * _arenaCapacity;
+		if(capacity < needed)
+			capacity = needed;
+		
+		char* arena = new char[capacity];
+		memcpy(arena, _arena, _keyStart[N]);
+		delete[] _arena;
+		_arena = arena;
+		_arenaCapacity = capacity;
+	}
+}
+
+#endif
@@ -230,6 +230,7 @@ namespace containers
 			{
 				// Here, enqueue-ing n would exceed the internal size of the queue, so first expand it.
 				_Q = pal->resizeTo(_Q, _size*2);
+				_size = _size*2;
 			}
 			
 			_Q[_tail] = *pn;
@@ -251,6 +252,7 @@ namespace containers
 			{
 				// Here, enqueue-ing n would exceed the internal size of the queue, so first expand it.
 				_Q = pal->resizeTo(_Q, _size*2);
+				_size = _size*2;
 			}
 
 			_Q[_tail] = n;
@@ -272,6 +274,7 @@ namespace containers
 			{
 				// Enqueue-ing n would exceed the internal size of the queue, so first expand it.
 				_Q = pal->resizeTo(_Q, _size*2);
+				_size = _size*2;
 			}
 			
 			_Q[_tail] = n;
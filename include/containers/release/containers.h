@@ -6,6 +6,8 @@
 #include "containers/stack.h"
 #include "containers/queue.h"
 #include "containers/symbol_table.h"
+#include "containers/bplus_tree.h"
+#include "containers/hash_map.h"
 #include "containers/pq.h"
 #include "containers/impq.h"
 #include "containers/_allocator.h"
@@ -2,6 +2,7 @@
 #define SYMBOL_TABLE_H
 
 #include <mutex>
+#include <shared_mutex>
 #include <condition_variable>
 
 #include "_containers.h"
@@ -22,7 +23,12 @@ namespace containers
      * The range of indices is [0, N).  The put(), delete(), and deleteMin() are O(N), while the get(),
      * contains(), floor(), ceiling() are O(log_2 N) by virtue of using rank().
      * 
-     * As put() is O(N), this container is not ideal for large data sets.  Caveat emptor!
+     * As put() is O(N), this container is not ideal for large data sets.  Caveat emptor!  To fill it with many keys
+     * at once, bulk_load() them instead:  they are sorted along with the keys already present, in O(N log N).  For
+     * updates in O(log N), see bplus_tree.
+     * 
+     * The getters hold read_write_mutex shared, thus lookups from any number of threads run at once, and the setters
+     * hold it alone.  For a table no longer written to, freeze() returns an immutable copy, which needs no locks at all.
      * 
     */
     
@@ -45,6 +51,8 @@ namespace containers
 
         // setters:
         void put(const Key&, const Value&);
+        template <typename KeyIterator, typename ValueIterator>
+        void bulk_load(KeyIterator, const KeyIterator&, ValueIterator);
         bool remove(const Key&, Key&);
         bool removeMin(Key&);
         bool removeMax(Key&);
@@ -62,12 +70,18 @@ namespace containers
         uint rank(const Key&) const;
         bool select(const uint&, Key&) const;
         
+        class frozen;
+        frozen freeze() const;
+
     private:
 
 		static _allocator<Key>* const pal_keys;		// Constant pointer to type Key allocator.
 		static _allocator<Value>* const pal_values;	// Constant pointer to type Value allocator.
 		
         void _expand();
+        uint _rank(const Key&) const;
+        bool _contains(const Key&) const;
+        bool _remove(const Key&);
 
         bool _allocated = false;
         
@@ -76,13 +90,9 @@ namespace containers
         Key* keys = nullptr;
         Value* values = nullptr;
 
-        // With mutable, we can modify these variables even in a const setting, namely in our const getters.
-		// Note that in order to prevent races, we employ 5 different mutexes.
-		mutable std::mutex read_write_mutex;		// Used by getters and setters.
-		mutable std::mutex resize_mutex;			// Used by the _resize() function.
-		mutable std::mutex initialize_mutex;		// Used by _initialize().
-        mutable std::mutex remove_mutex;            // Used by remove(), which calls contains() that uses the read_write_mutex.
-        mutable std::mutex rank_mutex;              // Prevents double unique locks, as both remove() and put() use rank(), and lock the read_write_mutex.
+        // With mutable, we can modify the mutex even in a const setting, namely in our const getters.
+		// The getters lock it shared, the setters unique.  The private functions assume it locked, and don't lock it again.
+		mutable std::shared_mutex read_write_mutex;
     public:                                               
         // Embedded iterator class for our symbol table class, iterating over the keys array.  Note that this is not thread safe.  To ensure thread safety,
         // the caller must coordinate its threads.
@@ -159,7 +169,44 @@ namespace containers
 		
         // Return iterators for keys [low, high] or [low, high) if high is not present.
 		void getkeys(const Key& low, const Key& high, iterator& begin, iterator& end) const;
-		                                            
+		
+		// An immutable copy of a symbol table, made by freeze().  Having no setters, it has no mutex either:  any number of
+		// threads may look it up at once, each lookup a binary search and nothing more.
+		class frozen
+		{
+		public:
+			frozen() = default;
+			frozen(const frozen&);
+			frozen(frozen&&) noexcept;
+			frozen& operator=(const frozen&);
+			frozen& operator=(frozen&&) noexcept;
+			~frozen() noexcept;
+			
+			bool get(const Key&, Value&) const;
+			Value get(const Key&) const;
+			
+			bool contains(const Key&) const;
+			bool empty() const { return N == 0; }
+			uint size() const { return N; }
+			uint size(const Key&, const Key&) const;
+			bool min(Key&) const;
+			bool max(Key&) const;
+			bool floor(const Key&, Key&) const;
+			bool ceiling(const Key&, Key&) const;
+			uint rank(const Key&) const;
+			bool select(const uint&, Key&) const;
+			
+			const_iterator cbegin() const { return const_iterator(keys); }
+			const_iterator cend() const { return const_iterator(keys + N); }
+		
+		private:
+			friend class symbol_table;
+			frozen(const Key*, const Value*, const uint&);
+			
+			Key* keys = nullptr;
+			Value* values = nullptr;
+			uint N = 0;
+		};
     };
 	
 	template <typename Key, typename Value>
@@ -208,7 +255,7 @@ namespace containers
     symbol_table<Key, Value>& symbol_table<Key, Value>::operator=(const symbol_table<Key, Value>& st)
     {
         {
-            std::unique_lock<std::mutex> l(read_write_mutex);
+            std::unique_lock<std::shared_mutex> l(read_write_mutex);
             
 			_size = st._size;
 			keys = pal_keys->copyFromResize(st.keys, keys);
@@ -222,7 +269,7 @@ namespace containers
     symbol_table<Key, Value>& symbol_table<Key, Value>::operator=(symbol_table<Key, Value>&& st) noexcept
     {
         {
-            std::unique_lock<std::mutex> l(read_write_mutex);
+            std::unique_lock<std::shared_mutex> l(read_write_mutex);
             
 			int size = _size;
             _size = st._size;
@@ -250,23 +297,17 @@ namespace containers
     template <typename Key, typename Value>
     void symbol_table<Key, Value>::_expand()
     {
-        // This is called internally, when we exceed the storage space.  Expand and copy.
-		{
-			// Our lock_guard is locked once and discarded (unlocked) by desctruction.
-			std::lock_guard<std::mutex> l(resize_mutex);
-
-			keys = pal_keys->resizeTo(keys, _size*2);
-			values = pal_values->resizeTo(values, _size*2);
-			_size = _size*2;
-        }
+        // This is called internally by put(), holding read_write_mutex, when we exceed the storage space.  Expand and copy.
+		keys = pal_keys->resizeTo(keys, _size*2);
+		values = pal_values->resizeTo(values, _size*2);
+		_size = _size*2;
     }
 
     template <typename Key, typename Value>
     void symbol_table<Key, Value>::clear()
     {
         {
-			// Lock the mutex.  _initialize has its own, so no race occurs.
-			std::unique_lock<std::mutex> ul(read_write_mutex);
+			std::unique_lock<std::shared_mutex> ul(read_write_mutex);
 
 			pal_keys->clear(keys);
 			pal_values->clear(values);
@@ -277,7 +318,7 @@ namespace containers
     uint symbol_table<Key, Value>::size() const
     {
         {
-            std::unique_lock<std::mutex> ul(read_write_mutex);
+            std::shared_lock<std::shared_mutex> sl(read_write_mutex);
             return N;
         }
     }
@@ -286,17 +327,17 @@ namespace containers
     uint symbol_table<Key, Value>::size(const Key& low, const Key& high) const
     {
         {
-			std::unique_lock<std::mutex> ul(read_write_mutex);
+			std::shared_lock<std::shared_mutex> sl(read_write_mutex);
             
             if(N == 0)
                 return 0;
             
             if(high < 0)
                 return 0;
-            else if(contains(high))
-                return rank(high) - rank(low) + 1;
+            else if(_contains(high))
+                return _rank(high) - _rank(low) + 1;
             else
-                return rank(high) - rank(low);
+                return _rank(high) - _rank(low);
         }
     }
     
@@ -309,12 +350,12 @@ namespace containers
         */
         
         {
-            std::unique_lock<std::mutex> ul(read_write_mutex);
+            std::shared_lock<std::shared_mutex> sl(read_write_mutex);
             
             if(N == 0)
                 return Value{};
             
-            uint i = rank(key);
+            uint i = _rank(key);
             if(i < N && key == keys[i])
                 return values[i];
             else
@@ -326,12 +367,12 @@ namespace containers
     bool symbol_table<Key, Value>::get(const Key& key, Value& result) const
     {
         {
-            std::unique_lock<std::mutex> ul(read_write_mutex);
+            std::shared_lock<std::shared_mutex> sl(read_write_mutex);
         
             if(N == 0)
                 return false;
             
-            uint i = rank(key);     // O(log_2 N) => get() == O(log_2 N)
+            uint i = _rank(key);    // O(log_2 N) => get() == O(log_2 N)
             if(i < N && keys[i] == key)
             {
                 result = values[i];
@@ -349,12 +390,12 @@ namespace containers
         // rank() tells us where to update the value if it is in the table, or where to go to add the value if not in the table.
         
         {
-            std::unique_lock<std::mutex> ul(read_write_mutex);
+            std::unique_lock<std::shared_mutex> ul(read_write_mutex);
         
             if(N == _size)
                 _expand();
             
-            uint i = rank(key);             // O(log_2 N)
+            uint i = _rank(key);            // O(log_2 N)
             
             // Update the value.
             if(i < N  && keys[i] == key)
@@ -378,63 +419,127 @@ namespace containers
         }
     }
     
+    template <typename Key, typename Value>
+    template <typename KeyIterator, typename ValueIterator>
+    void symbol_table<Key, Value>::bulk_load(KeyIterator key, const KeyIterator& end, ValueIterator value)
+    {
+        // Put the keys [key, end) with the values from value on, as if by put() in turn, but sorting them all at once:
+        // O(N log N) rather than O(N) a key.
+
+        {
+            std::unique_lock<std::shared_mutex> ul(read_write_mutex);
+
+            uint n = N;
+            for(KeyIterator k = key; k != end; k++)
+                n++;
+
+            Key* allKeys = new Key[n];
+            Value* allValues = new Value[n];
+            for(uint i = 0; i < N; i++)
+            {
+                allKeys[i] = keys[i];
+                allValues[i] = values[i];
+            }
+
+            for(uint i = N; i < n; i++, key++, value++)
+            {
+                allKeys[i] = *key;
+                allValues[i] = *value;
+            }
+
+            Key* sortedKeys = new Key[n];
+            Value* sortedValues = new Value[n];
+            uint m = _sort_unique(allKeys, allValues, n, sortedKeys, sortedValues);
+
+            // Leave room past the last key, as ceiling() reads there.
+            if(m >= _size)
+            {
+                keys = pal_keys->resizeTo(keys, m + 1);
+                values = pal_values->resizeTo(values, m + 1);
+                _size = m + 1;
+            }
+
+            for(uint i = 0; i < m; i++)
+            {
+                keys[i] = std::move(sortedKeys[i]);
+                values[i] = std::move(sortedValues[i]);
+            }
+
+            N = m;
+
+            delete[] allKeys;
+            delete[] allValues;
+            delete[] sortedKeys;
+            delete[] sortedValues;
+        }
+    }
+
     template <typename Key, typename Value>
     bool symbol_table<Key, Value>::contains(const Key& key) const
     {
         {
-            std::unique_lock<std::mutex> ul(read_write_mutex);
-            
-            if(keys[rank(key)] == key)          // O(log_2 N) => contains() == O(log_2 N)
-                return true;
-            
-            return false;
+            std::shared_lock<std::shared_mutex> sl(read_write_mutex);
+            return _contains(key);
         }
     }
+
+    template <typename Key, typename Value>
+    bool symbol_table<Key, Value>::_contains(const Key& key) const
+    {
+        uint i = _rank(key);                    // O(log_2 N) => contains() == O(log_2 N)
+
+        return i < N && keys[i] == key;
+    }
     
     template <typename Key, typename Value>
     uint symbol_table<Key, Value>::rank(const Key& key) const
     {
         {
-            std::unique_lock<std::mutex> ul(rank_mutex);
-         
-            /* Use non-recursive binary search to return the number of keys smaller than key, namely the index of its ceiling.
-             * If the key is present, then the number of keys smaller than key are in [0, rank(key) - 1].  Else return the place
-			 * the key should be in.  
-             * 
-             * Decompose the interval [low, high] to [low, mid-1], [mid] and [mid+1, high]; and adjust low and high by +1/-1 respectively,
-             * until we converge on the rank, located at mid or at low.  This occurs when key == keys[mid] or when low > high, by one.
-             */
-            
-            if(N == 0)				// Empty container, so give the first spot to key.
-                return 0;
-            
-            // Note that we need to use signed int here, as the condition in the while loop needs to be violated to exit.
-            int low = 0;
-            int high = N - 1;       // The rank of a key within the container can never equal N. Otherwise, it is N if key > max(keys).
-            int mid = 0;
-            
-            while(low <= high)                  
-            {
-                mid = low + (high - low) / 2;
-                if(key < keys[mid])
-                    high = mid - 1;
-                else if(key > keys[mid])
-                    low = mid + 1;
-                else
-                    return mid;     // The key is within the container.
-            }
-            
-            // The key is not in the container.  If key > max(keys), return N.  If key < min(keys) return 0.  Else return
-            // the index it would have if key was in the container.
-            return low;
+            std::shared_lock<std::shared_mutex> sl(read_write_mutex);
+            return _rank(key);
+        }
+    }
+
+    template <typename Key, typename Value>
+    uint symbol_table<Key, Value>::_rank(const Key& key) const
+    {
+        /* Use non-recursive binary search to return the number of keys smaller than key, namely the index of its ceiling.
+         * If the key is present, then the number of keys smaller than key are in [0, rank(key) - 1].  Else return the place
+         * the key should be in.  
+         * 
+         * Decompose the interval [low, high] to [low, mid-1], [mid] and [mid+1, high]; and adjust low and high by +1/-1 respectively,
+         * until we converge on the rank, located at mid or at low.  This occurs when key == keys[mid] or when low > high, by one.
+         */
+
+        if(N == 0)				// Empty container, so give the first spot to key.
+            return 0;
+
+        // Note that we need to use signed int here, as the condition in the while loop needs to be violated to exit.
+        int low = 0;
+        int high = N - 1;       // The rank of a key within the container can never equal N. Otherwise, it is N if key > max(keys).
+        int mid = 0;
+
+        while(low <= high)                  
+        {
+            mid = low + (high - low) / 2;
+            if(key < keys[mid])
+                high = mid - 1;
+            else if(key > keys[mid])
+                low = mid + 1;
+            else
+                return mid;     // The key is within the container.
         }
+
+        // The key is not in the container.  If key > max(keys), return N.  If key < min(keys) return 0.  Else return
+        // the index it would have if key was in the container.
+        return low;
     }
     
     template <typename Key, typename Value>
     bool symbol_table<Key, Value>::min(Key& result) const
     {
         {
-            std::unique_lock<std::mutex> ul(read_write_mutex);  
+            std::shared_lock<std::shared_mutex> sl(read_write_mutex);
             
             if(N == 0)
                 return false;
@@ -448,7 +553,7 @@ namespace containers
     bool symbol_table<Key, Value>::max(Key& result) const
     {
         {
-            std::unique_lock<std::mutex> ul(read_write_mutex);  
+            std::shared_lock<std::shared_mutex> sl(read_write_mutex);
             
             if(N == 0)
                 return false;
@@ -462,7 +567,7 @@ namespace containers
     bool symbol_table<Key, Value>::select(const uint& key, Key& result) const
     {
         {
-            std::unique_lock<std::mutex> ul(read_write_mutex);  
+            std::shared_lock<std::shared_mutex> sl(read_write_mutex);
             
             if(N == 0)
                 return false;
@@ -486,11 +591,11 @@ namespace containers
     bool symbol_table<Key, Value>::ceiling(const Key& key, Key& key_ceiling) const
     {
         {
-            std::unique_lock<std::mutex> ul(read_write_mutex);  
+            std::shared_lock<std::shared_mutex> sl(read_write_mutex);
             if(N == 0)
                 return false;                   // Empty container!
             
-            uint ceil = rank(key);              // rank(key) == number of keys less than key, which equals the index of the ceiling, if the key is present.
+            uint ceil = _rank(key);             // rank(key) == number of keys less than key, which equals the index of the ceiling, if the key is present.
             key_ceiling = keys[ceil];
             return true;
         }
@@ -501,11 +606,11 @@ namespace containers
     bool symbol_table<Key, Value>::floor(const Key& key, Key& key_floor) const
     {
         {
-            std::unique_lock<std::mutex> ul(read_write_mutex);
+            std::shared_lock<std::shared_mutex> sl(read_write_mutex);
             if(N == 0)                  
                 return false;                   // Empty container!
             
-            uint ceiling = rank(key);           // rank(key) == number of keys less than key == index of ceiling key, if present.
+            uint ceiling = _rank(key);          // rank(key) == number of keys less than key == index of ceiling key, if present.
             
             if(ceiling == 0 or ceiling == N)
                 return false;                   // These two cases occur when the key is not in the container, and key < min(keys), or > max(keys), respectively.
@@ -523,48 +628,69 @@ namespace containers
     bool symbol_table<Key, Value>::remove(const Key& key, Key& result)
     {
         {
-            std::unique_lock<std::mutex> mlock(remove_mutex);
+            std::unique_lock<std::shared_mutex> ul(read_write_mutex);
             
-            // Check if the key pair is in the container.
-            if(N == 0 or contains(key) == false)
+            if(_remove(key) == false)
                 return false;
             
-            // Find ceiling of key.
-            Key k;
-            get(key, k);
-            uint i = rank(key);     // O(log_2 N)
-            
-            // From put():  i = rank(key), and move all keys of greater rank to the right:   [i, N) -> [i+1, N].  We must thus reverse this.
-            for(int j = i; j < N; i++)      // [i, N) => O(N), => remove() == O(N), as O(N) > O(log_2 N)
-            {
-                keys[j - 1] = keys[j];
-                values[j - 1] = values[j];
-            }
-            
-            N--;
-            
-            result = k;
+            result = key;
             return true;
         }
     }
     
+    template <typename Key, typename Value>
+    bool symbol_table<Key, Value>::_remove(const Key& key)
+    {
+        // Check if the key pair is in the container.
+        uint i = _rank(key);        // O(log_2 N)
+        if(i >= N || keys[i] != key)
+            return false;
+
+        // From put():  i = rank(key), and move all keys of greater rank to the right:   [i, N) -> [i+1, N].  We must thus reverse this.
+        for(uint j = i + 1; j < N; j++)     // [i+1, N) => O(N), => remove() == O(N), as O(N) > O(log_2 N)
+        {
+            keys[j - 1] = keys[j];
+            values[j - 1] = values[j];
+        }
+
+        N--;
+
+        return true;
+    }
+
     template <typename Key, typename Value>
     bool symbol_table<Key, Value>::removeMin(Key& result)
     {
-        return remove(min(), result);
+        {
+            std::unique_lock<std::shared_mutex> ul(read_write_mutex);
+
+            if(N == 0)
+                return false;
+
+            result = keys[0];
+            return _remove(result);
+        }
     }
     
     template <typename Key, typename Value>
     bool symbol_table<Key, Value>::removeMax(Key& result)
     {
-        return remove(max(), result);
+        {
+            std::unique_lock<std::shared_mutex> ul(read_write_mutex);
+
+            if(N == 0)
+                return false;
+
+            result = keys[N-1];
+            return _remove(result);
+        }
     }
     
     template <typename Key, typename Value>
     bool symbol_table<Key, Value>::empty() const
     {
         {
-            std::unique_lock<std::mutex> ul(read_write_mutex);  
+            std::shared_lock<std::shared_mutex> sl(read_write_mutex);
             
             return N == 0;
         }
@@ -580,6 +706,173 @@ namespace containers
         else
             end = iterator(keys[rank(high)]);       // [end, high], with rank(high) = ceiling(high)
     }
+
+    template <typename Key, typename Value>
+    typename symbol_table<Key, Value>::frozen symbol_table<Key, Value>::freeze() const
+    {
+        {
+            std::shared_lock<std::shared_mutex> sl(read_write_mutex);
+            return frozen(keys, values, N);
+        }
+    }
+
+    template <typename Key, typename Value>
+    symbol_table<Key, Value>::frozen::frozen(const Key* k, const Value* v, const uint& n)
+    {
+        // Copy the keys and values out of the allocator, so that the copy outlives the table, and is bound by nothing.
+        N = n;
+        keys = new Key[N + 1];
+        values = new Value[N + 1];
+        for(uint i = 0; i < N; i++)
+        {
+            keys[i] = k[i];
+            values[i] = v[i];
+        }
+    }
+
+    template <typename Key, typename Value>
+    symbol_table<Key, Value>::frozen::frozen(const frozen& f) : frozen(f.keys, f.values, f.N)
+    {
+    }
+
+    template <typename Key, typename Value>
+    symbol_table<Key, Value>::frozen::frozen(frozen&& f) noexcept
+    {
+        *this = std::move(f);
+    }
+
+    template <typename Key, typename Value>
+    typename symbol_table<Key, Value>::frozen& symbol_table<Key, Value>::frozen::operator=(const frozen& f)
+    {
+        if(this != &f)
+            *this = frozen(f);
+
+        return *this;
+    }
+
+    template <typename Key, typename Value>
+    typename symbol_table<Key, Value>::frozen& symbol_table<Key, Value>::frozen::operator=(frozen&& f) noexcept
+    {
+        std::swap(keys, f.keys);
+        std::swap(values, f.values);
+        std::swap(N, f.N);
+
+        return *this;
+    }
+
+    template <typename Key, typename Value>
+    symbol_table<Key, Value>::frozen::~frozen() noexcept
+    {
+        delete[] keys;
+        delete[] values;
+    }
+
+    template <typename Key, typename Value>
+    uint symbol_table<Key, Value>::frozen::rank(const Key& key) const
+    {
+        // The number of keys less than key, as symbol_table::rank().
+        return std::lower_bound(keys, keys + N, key) - keys;
+    }
+
+    template <typename Key, typename Value>
+    bool symbol_table<Key, Value>::frozen::get(const Key& key, Value& result) const
+    {
+        uint i = rank(key);
+        if(i < N && keys[i] == key)
+        {
+            result = values[i];
+            return true;
+        }
+
+        return false;
+    }
+
+    template <typename Key, typename Value>
+    Value symbol_table<Key, Value>::frozen::get(const Key& key) const
+    {
+        Value result{};
+        get(key, result);
+
+        return result;
+    }
+
+    template <typename Key, typename Value>
+    bool symbol_table<Key, Value>::frozen::contains(const Key& key) const
+    {
+        uint i = rank(key);
+
+        return i < N && keys[i] == key;
+    }
+
+    template <typename Key, typename Value>
+    uint symbol_table<Key, Value>::frozen::size(const Key& low, const Key& high) const
+    {
+        // The number of keys in [low, high].
+        if(high < low)
+            return 0;
+
+        return (contains(high) ? rank(high) + 1 : rank(high)) - rank(low);
+    }
+
+    template <typename Key, typename Value>
+    bool symbol_table<Key, Value>::frozen::min(Key& result) const
+    {
+        if(N == 0)
+            return false;
+
+        result = keys[0];
+        return true;
+    }
+
+    template <typename Key, typename Value>
+    bool symbol_table<Key, Value>::frozen::max(Key& result) const
+    {
+        if(N == 0)
+            return false;
+
+        result = keys[N-1];
+        return true;
+    }
+
+    template <typename Key, typename Value>
+    bool symbol_table<Key, Value>::frozen::select(const uint& i, Key& result) const
+    {
+        if(i >= N)
+            return false;
+
+        result = keys[i];
+        return true;
+    }
+
+    template <typename Key, typename Value>
+    bool symbol_table<Key, Value>::frozen::floor(const Key& key, Key& key_floor) const
+    {
+        // The largest key less than or equal to key.
+        uint i = rank(key);
+        if(i < N && keys[i] == key)
+        {
+            key_floor = key;
+            return true;
+        }
+
+        if(i == 0)
+            return false;
+
+        key_floor = keys[i-1];
+        return true;
+    }
+
+    template <typename Key, typename Value>
+    bool symbol_table<Key, Value>::frozen::ceiling(const Key& key, Key& key_ceiling) const
+    {
+        // The smallest key larger than or equal to key.
+        uint i = rank(key);
+        if(i == N)
+            return false;
+
+        key_ceiling = keys[i];
+        return true;
+    }
 }
 
 #endif
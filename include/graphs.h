@@ -7,8 +7,10 @@
 // Graphs header files meant for clients.
 #include "graphs/acyclic_lp.h"
 #include "graphs/acyclic_sp.h"
+#include "graphs/acyclic_workspace.h"
 #include "graphs/base_graph.h"
 #include "graphs/breadth_first_paths.h"
+#include "graphs/compressed_digraph.h"
 #include "graphs/depth_first_order.h"
 #include "graphs/depth_first_search.h"
 #include "graphs/directed_dfs_multi.h"
@@ -18,7 +20,9 @@
 #include "graphs/edge_weighted_digraph.h"
 #include "graphs/edge_weighted_graph.h"
 #include "graphs/graph.h"
+#include "graphs/graph_version.h"
 #include "graphs/topological.h"
+#include "graphs/visited_set.h"
 
 namespace graphs
 {
@@ -27,8 +31,13 @@ namespace graphs
 	class edge;
 	class graph;
 	class digraph;
+	class compressed_digraph;
 	class edge_weighted_digraph;
 	class edge_weighted_graph;
+	class acyclic_workspace;
+	class visited_set;
+	class graph_version;
+	class graph_observer;
 	
 	using ewdg = edge_weighted_digraph;
 	using ewg = edge_weighted_graph;
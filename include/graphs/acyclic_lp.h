@@ -5,6 +5,7 @@
 #include "edge_weighted_digraph.h"
 #include "edge.h"
 #include "topological.h"
+#include "acyclic_workspace.h"
 
 namespace graphs
 {
@@ -19,6 +20,9 @@ namespace graphs
 	 * Also change hasPathTo() to use neginf.
 	 * 
 	 * O(E+V).  
+	 * 
+	 * The arrays and the topological order live in an acyclic_workspace.  Either pass one in to
+	 * share it across objects, or the object creates its own, which operator() then reuses.
 	*/
 	
 	class acyclic_LP
@@ -26,11 +30,13 @@ namespace graphs
 		
 	private:
 		
-		double* _distTo = nullptr;
+		double* _distTo = nullptr;				// Owned by p_workspace.
 		edge* _edgeTo = nullptr;
+		acyclic_workspace* p_workspace = nullptr;
+		bool _ownsWorkspace = false;
 		
 		void relax(const edge_weighted_digraph&, const uint&);
-		void _initialize(const uint& v);
+		void _initialize(const edge_weighted_digraph&, const uint&);
 		
 	public:
 		
@@ -41,11 +47,13 @@ namespace graphs
 		acyclic_LP& operator=(acyclic_LP&&) = delete;
 		
 		acyclic_LP(const edge_weighted_digraph&, const uint&);
-		~acyclic_LP() { delete[] _distTo; delete[] _edgeTo; }
+		acyclic_LP(const edge_weighted_digraph&, const uint&, acyclic_workspace&);
+		acyclic_LP(acyclic_workspace&);
+		~acyclic_LP() { if(_ownsWorkspace == true) delete p_workspace; }
 		
 		void operator()(const edge_weighted_digraph&, const uint&);
 		
-		bool hasPathTo(const uint& v) const { return _distTo[v] != neginf; }
+		bool hasPathTo(const uint& v) const { return _distTo != nullptr && _distTo[v] != neginf; }
 		double distance(const uint& v) const { return _distTo[v]; }
 		epath getPathTo(const uint&) const;
 	};
@@ -5,6 +5,7 @@
 #include "edge_weighted_digraph.h"
 #include "edge.h"
 #include "topological.h"
+#include "acyclic_workspace.h"
 
 namespace graphs
 {
@@ -19,16 +20,21 @@ namespace graphs
 	 * only once due to the aforementioned nature of that order.
 	 * 
 	 * O(E+V)
+	 * 
+	 * The arrays and the topological order live in an acyclic_workspace.  Either pass one in to
+	 * share it across objects, or the object creates its own, which operator() then reuses.
 	*/
 	
 	class acyclic_SP
 	{
 	private:
 		void relax(const edge_weighted_digraph&, const uint&);
-		void _initialize(const uint& v);
+		void _initialize(const edge_weighted_digraph&, const uint&);
 		
-		double* _distTo = nullptr;
+		double* _distTo = nullptr;				// Owned by p_workspace.
 		edge* _edgeTo = nullptr;
+		acyclic_workspace* p_workspace = nullptr;
+		bool _ownsWorkspace = false;
 		
 	public:
 		acyclic_SP() = delete;
@@ -38,11 +44,13 @@ namespace graphs
 		acyclic_SP& operator=(acyclic_SP&&) = delete;
 		
 		acyclic_SP(const edge_weighted_digraph&, const uint&);
-		~acyclic_SP() { delete[] _distTo; delete[] _edgeTo; }
+		acyclic_SP(const edge_weighted_digraph&, const uint&, acyclic_workspace&);
+		acyclic_SP(acyclic_workspace&);
+		~acyclic_SP() { if(_ownsWorkspace == true) delete p_workspace; }
 		
 		void operator()(const edge_weighted_digraph&, const uint&);
 		
-		bool hasPathTo(const uint& v) const { return _distTo[v] != inf; }
+		bool hasPathTo(const uint& v) const { return _distTo != nullptr && _distTo[v] != inf; }
 		double distance(const uint& v) const { return _distTo[v]; }
 		epath getPathTo(const uint&) const;
 	};
@@ -0,0 +1,71 @@
+#ifndef ACYCLIC_WORKSPACE_H
+#define ACYCLIC_WORKSPACE_H
+
+#include "_graphs.h"
+#include "edge.h"
+#include "edge_weighted_digraph.h"
+#include "visited_set.h"
+
+namespace graphs
+{
+	/*
+	 * Acyclic workspace:
+	 * 
+	 * The working storage of acyclic_SP and acyclic_LP, held apart from them so that it may be
+	 * reused across querries:  the _distTo[] and _edgeTo[] arrays, and the topological order of
+	 * the last graph seen.
+	 * 
+	 * order() caches the order keyed by the graph's address and version(), and only recomputes it
+	 * once the graph changed.  The computation is an iterative DFS over arrays owned by the
+	 * workspace, with the same visiting sequence as topological (reverse postorder, vertices and
+	 * adjacency lists in order), and a cycle check as directed_cycle does.  An empty order means
+	 * the graph has a cycle.
+	 * 
+	 * All storage grows with reserve() and is never released before destruction.  Thus once the
+	 * workspace has seen the largest graph, querries make no heap allocations at all.
+	 * 
+	 * An algorithm object borrowing a workspace keeps its results there, so two objects sharing
+	 * one workspace overwrite each other's results.
+	*/
+	
+	class acyclic_workspace
+	{
+	public:
+		acyclic_workspace() = default;
+		acyclic_workspace(const acyclic_workspace&) = delete;
+		acyclic_workspace(acyclic_workspace&&) = delete;
+		acyclic_workspace& operator=(const acyclic_workspace&) = delete;
+		acyclic_workspace& operator=(acyclic_workspace&&) = delete;
+		~acyclic_workspace() { delete[] _distTo; delete[] _edgeTo; delete[] _order; delete[] _stack; delete[] _next; delete[] _end; }
+		
+		void reserve(const uint&);
+		void order(const edge_weighted_digraph&, const uint*&, const uint*&);
+		
+		double* distTo() const { return _distTo; }
+		edge* edgeTo() const { return _edgeTo; }
+		uint capacity() const { return _capacity; }
+		uint orders_computed() const { return _computed; }
+		uint reservations() const { return _reserved; }		// The times reserve() had to grow the storage.
+	
+	private:
+		void _compute_order(const edge_weighted_digraph&);
+		
+		double* _distTo = nullptr;
+		edge* _edgeTo = nullptr;
+		uint* _order = nullptr;					// Cached topological order, _orderCount entries.
+		uint* _stack = nullptr;					// DFS vertex stack,
+		adje_citer* _next = nullptr;			// with each vertex's next and
+		adje_citer* _end = nullptr;				// end adjacency iterators.
+		visited_set _marked;
+		visited_set _onStack;
+		
+		const edge_weighted_digraph* p_g = nullptr;		// Graph and version the order was computed for.
+		ulong _version = 0;
+		uint _orderCount = 0;
+		uint _capacity = 0;
+		uint _computed = 0;
+		uint _reserved = 0;
+	};
+}
+
+#endif
@@ -8,10 +8,11 @@
 
 
 #include "_graphs.h"
+#include "graph_version.h"
 
 namespace graphs
 {
-	class base_graph
+	class base_graph : public graph_version
 	{
 		
 	public:
@@ -3,6 +3,8 @@
 
 #include "_graphs.h"
 #include "base_graph.h"
+#include "compressed_digraph.h"
+#include "visited_set.h"
 #include "containers.h"
 
 namespace graphs
@@ -17,10 +19,12 @@ namespace graphs
 	 * 		pop a vertex off the queue.
 	 * 		For each of its unmarked vertices,
 	 * 			_edgeTo[w] = v;		// Establish the v->w edge.
-	 * 			_marked[w] = true;
+	 * 			_marked.set(w);
 	 * 
 	 * 			queue.enqueue(w);
 	 * O(V+E).
+	 * 
+	 * A compressed_digraph is searched alike, its neighbours decoded as they are reached.
 	*/
 	
 	class breadth_first_paths
@@ -34,16 +38,20 @@ namespace graphs
 		breadth_first_paths& operator=(breadth_first_paths&&) = delete;
 		
 		breadth_first_paths(const base_graph&, uint);
-		~breadth_first_paths() { delete[] _marked; delete[] _edgeTo; }
+		breadth_first_paths(const compressed_digraph&, uint);
+		~breadth_first_paths() { delete[] _edgeTo; }
 		
-		bool hasPathTo(uint v) const { if(_marked == nullptr) return false; else return _marked[v]; }
+		bool hasPathTo(uint v) const { if(v >= _marked.size()) return false; else return _marked.test(v); }
 		void operator()(const base_graph&, uint);
+		void operator()(const compressed_digraph&, uint);
 		path pathTo(const uint& s, const uint& v) const;
 		
 	private:
-		void bfs(const base_graph&, uint);
+		void _prepare(const uint&);
+		template <typename Iterator, typename Graph>
+		void bfs(const Graph&, uint);
 		
-		bool* _marked = nullptr;
+		visited_set _marked;
 		uint* _edgeTo = nullptr;
 		uint _size = 0;
 	};
@@ -0,0 +1,114 @@
+#ifndef COMPRESSED_DIGRAPH_H
+#define COMPRESSED_DIGRAPH_H
+
+#include <iterator>
+
+#include "_graphs.h"
+#include "digraph.h"
+
+namespace graphs
+{
+	/*
+	 * Compressed digraph:
+	 * 
+	 * An immutable digraph keeping its adjacency lists as one stream of bytes, for digraphs too large for the lists of
+	 * digraph, where each edge is a list node of its own.  The neighbours of each vertex are sorted, and each is stored
+	 * as its difference from the one before it (the first as is), in a varint:  7 bits to a byte, the high bit set on
+	 * all the bytes but the last.  The neighbours of a vertex being near one another in most graphs, an edge takes a
+	 * byte or two, rather than the 4 of a uint, or the 16 of a list node and the allocation around it.  A vertex costs
+	 * the offset of its neighbours in the stream.
+	 * 
+	 * adj() returns iterators which decode the stream as they go, so that breadth_first_paths and depth_first_search
+	 * walk a compressed_digraph as they walk a digraph, without expanding it.  The neighbours come in increasing order,
+	 * whereas a digraph gives them latest added first, thus the paths found may differ, but not their lengths for
+	 * breadth_first_paths.  Parallel edges are kept, as differences of 0.
+	 * 
+	 * It is built from a digraph, or from compressed sparse rows, such as parallel_edge_reader::CSR() makes, so that an
+	 * edge list need never become a digraph at all (see parallel_edge_reader::CDG()).  Being immutable, it may be shared
+	 * by any number of threads.
+	*/
+	
+	class compressed_digraph
+	{
+	public:
+		// A forward iterator over the neighbours of a vertex, decoding each as it is reached.
+		class iterator
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using difference_type = std::ptrdiff_t;
+			using value_type = uint;
+			using pointer = const uint*;
+			using reference = const uint&;
+			
+			iterator() {};
+			
+			reference operator*() const { return _w; }
+			pointer operator->() const { return &_w; }
+			iterator& operator++() { _p += _length; _decode(_w); return *this; }
+			iterator operator++(int) { iterator it = *this; ++*this; return it; }
+			
+			bool operator==(const iterator& rhs) const { return _p == rhs._p; }
+			bool operator!=(const iterator& rhs) const { return _p != rhs._p; }
+		
+		private:
+			friend class compressed_digraph;
+			
+			// The stream is padded, so that decoding past the last neighbour, as the end is not known here, is harmless.
+			iterator(const uchar* p) : _p(p) { _decode(0); }
+			
+			void _decode(const uint previous)
+			{
+				uint delta = 0;
+				uchar byte = 0;
+				_length = 0;
+				do
+				{
+					byte = _p[_length];
+					delta |= (uint)(byte & 0x7f) << (7 * _length++);
+				}
+				while(byte & 0x80);
+				
+				_w = previous + delta;
+			}
+			
+			const uchar* _p = nullptr;		// The bytes of the current neighbour,
+			uint _length = 0;				// their number,
+			uint _w = 0;					// and the neighbour they make.
+		};
+		
+		compressed_digraph() noexcept {};
+		compressed_digraph(const digraph&);
+		compressed_digraph(const uint& V, const uint* edgeStart, const uint* targets);
+		compressed_digraph(const compressed_digraph&);
+		compressed_digraph(compressed_digraph&&) noexcept;
+		compressed_digraph& operator=(const compressed_digraph&);
+		compressed_digraph& operator=(compressed_digraph&&) noexcept;
+		~compressed_digraph() noexcept;
+		
+		// Return iterators at the neighbours of v.
+		void adj(const uint& v, iterator& begin, iterator& end) const;
+		
+		bool ready() const { return _V > 0; }
+		std::string str() const;
+		uint V() const { return _V; }
+		uint E() const { return _E; }
+		uint degree(const uint&) const;
+		ulong bytes() const { return (_V + 1ul) * sizeof(ulong) + _size; }		// The memory held.
+	
+	private:
+		template <typename Degree, typename Fill>
+		void _build(const uint&, const uint&, const Degree&, const Fill&);
+		void _release();
+		
+		static constexpr const uint _padding = 8;		// Zero bytes past the stream.
+		
+		ulong* _offsets = nullptr;		// The neighbours of v are in _stream[_offsets[v], _offsets[v+1]).
+		uchar* _stream = nullptr;
+		ulong _size = 0;				// The bytes of the stream, padding included.
+		uint _V = 0;
+		uint _E = 0;
+	};
+}
+
+#endif
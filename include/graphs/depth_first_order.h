@@ -6,6 +6,7 @@
 #include "digraph.h"
 #include "edge.h"
 #include "edge_weighted_digraph.h"
+#include "visited_set.h"
 
 namespace graphs
 {
@@ -14,7 +15,7 @@ namespace graphs
 		/*
 		 * Depth First Search Order:
 		 * 
-		 * Create a bool array _marked[], and a vertex array _edgeTo[].
+		 * Create a visited_set _marked, and a vertex array _edgeTo[].
 		 * Starting with vertex s,
 		 * 		Mark vertex having been visited as true
 		 * 		Obtain its adjacency vertices
@@ -27,6 +28,10 @@ namespace graphs
 		 * 		Pre = matches the dfs calls.
 		 * 		Post = matches the order that dfs calls finish.
 		 * 		reversePost = the reverse (via a stack) of the Post order.
+		 * 
+		 * The orders are kept in arrays which only grow, so that once the largest digraph was seen,
+		 * operator() makes no heap allocations:  preorder(), postorder() and reversePostorder() give
+		 * them as ranges.  Pre(), Post() and ReversePost() copy them into lists, as they always did.
 		*/
 		
 	public:
@@ -40,13 +45,17 @@ namespace graphs
 		depth_first_order(digraph&&);
 		depth_first_order(const edge_weighted_digraph&);
 		depth_first_order(edge_weighted_digraph&&);
-		~depth_first_order() { delete[] _marked; delete _pre; delete _post; delete _reversePost;};
+		~depth_first_order() { delete[] _pre; delete[] _post; delete[] _reversePost; };
 		
 		void operator()(const digraph&);
 		void operator()(const edge_weighted_digraph&);
-		pre Pre() const { return *_pre; }
-		post Post() const { return *_post; }
-		rpost ReversePost() const { return *_reversePost; }
+		pre Pre() const;
+		post Post() const;
+		rpost ReversePost() const;
+		
+		void preorder(const uint*& begin, const uint*& end) const { begin = _pre; end = _pre + _size; }
+		void postorder(const uint*& begin, const uint*& end) const { begin = _post; end = _post + _size; }
+		void reversePostorder(const uint*& begin, const uint*& end) const { begin = _reversePost; end = _reversePost + _size; }
 		
 	private:
 		void dfs(const digraph&, const uint&);
@@ -54,11 +63,14 @@ namespace graphs
 		
 		void _initialize(const uint&);
 		
-		bool* _marked = nullptr;
-		pre* _pre = nullptr;
-		post* _post = nullptr;
-		rpost* _reversePost = nullptr;
+		visited_set _marked;
+		uint* _pre = nullptr;				// The vertices in the order of the dfs() calls,
+		uint* _post = nullptr;				// in the order they return,
+		uint* _reversePost = nullptr;		// and in the reverse of that, filled from the end.
 		
+		uint _preCount = 0;
+		uint _postCount = 0;
+		uint _capacity = 0;
 		uint _size = 0;
 	};
 }
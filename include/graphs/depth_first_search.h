@@ -3,6 +3,8 @@
 
 #include "_graphs.h"
 #include "base_graph.h"
+#include "compressed_digraph.h"
+#include "visited_set.h"
 #include "containers.h"
 
 namespace graphs
@@ -12,7 +14,7 @@ namespace graphs
 	/*
 	 * Depth First Search:
 	 * 
-	 * Create a bool array _marked[], and a vertex array _edgeTo[].
+	 * Create a visited_set _marked, and a vertex array _edgeTo[].
 	 * Starting with vertex s,
 	 * 		Mark vertex having been visited as true
 	 * 		Obtain its adjacency vertices
@@ -26,6 +28,8 @@ namespace graphs
 	* 		for(uint x = v; x. != x; x = _edgeTo[x])
 	* 			stack.push(x);
 	* The _edgeTo vertex entries are all assigned the value undefined_uint to terminate this loop.
+	* 
+	* A compressed_digraph is searched alike, its neighbours decoded as they are reached.
 	*/
 	
 	class depth_first_search
@@ -39,20 +43,26 @@ namespace graphs
 		
 		depth_first_search(const base_graph&, const uint&);
 		depth_first_search(const base_graph& g, const arui&);
-		~depth_first_search() { delete[] _marked; delete[] _edgeTo; }
+		depth_first_search(const compressed_digraph&, const uint&);
+		depth_first_search(const compressed_digraph& g, const arui&);
+		~depth_first_search() { delete[] _edgeTo; }
 		
-		bool marked(const uint& w) const { return _marked[w]; }
-		bool hasPathTo(const uint& v) const { return _marked[v]; }
+		bool marked(const uint& w) const { return _marked.test(w); }
+		bool hasPathTo(const uint& v) const { return _marked.test(v); }
 		int count() const { return _count; }
 		void operator()(const base_graph&, const uint&);
 		void operator()(const base_graph& g, const arui&);
+		void operator()(const compressed_digraph&, const uint&);
+		void operator()(const compressed_digraph& g, const arui&);
 		void pathTo(path&, const uint&, const uint&);
 		
 	private:
-		void dfs(const base_graph&, const uint&);
+		void _prepare(const uint&);
+		template <typename Iterator, typename Graph>
+		void dfs(const Graph&, const uint&);
 		void dfs(const base_graph&, const arui&);
 		
-		bool* _marked = nullptr;
+		visited_set _marked;
 		uint* _edgeTo = nullptr;
 		int _count = 0;
 		uint _size = 0;
@@ -6,6 +6,7 @@
 #include "containers.h"
 #include "edge.h"
 #include "edge_weighted_digraph.h"
+#include "visited_set.h"
 
 namespace graphs
 {
@@ -14,8 +15,8 @@ namespace graphs
 	 * 
 	 * Does graph contain a directed cycle?
 	 * 
-	 * Use two bool arrays and one uint array for the algorithm:  _marked[] _onStack[] and _marked[],
-	 * with _marked[] and _edgeTo[] inherited from the original DFS implementation.
+	 * Use two visited_sets and one uint array for the algorithm:  _marked, _onStack and _edgeTo[],
+	 * with _marked and _edgeTo[] inherited from the original DFS implementation.
 	 * 
 	 * In the DFS routine, continue marking vertices as visited and place them on the stack, until we
 	 * encounter a vertex already marked as on the stack.
@@ -42,7 +43,7 @@ namespace graphs
 		
 		directed_cycle(const digraph&);
 		directed_cycle(const edge_weighted_digraph&);
-		~directed_cycle() { delete _marked; delete _edgeTo; delete _onStack; delete p_cycle; delete p_cycle_e; delete _edgeTo_e; }
+		~directed_cycle() { delete _edgeTo; delete p_cycle; delete p_cycle_e; delete _edgeTo_e; }
 		
 		void operator()(const digraph&);
 		void operator()(const edge_weighted_digraph&);
@@ -56,10 +57,10 @@ namespace graphs
 		void dfs(const edge_weighted_digraph&, const uint&);
 		void _initialize(const uint&);
 		
-		containers::array<bool>* _marked = nullptr;
+		visited_set _marked;
 		arui* _edgeTo = nullptr;
 		are* _edgeTo_e = nullptr;
-		containers::array<bool>* _onStack = nullptr;
+		visited_set _onStack;
 		cyclic_path* p_cycle = nullptr;
 		cyclic_path_e* p_cycle_e = nullptr;
 		
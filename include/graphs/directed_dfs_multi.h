@@ -3,6 +3,7 @@
 
 #include "_graphs.h"
 #include "digraph.h"
+#include "visited_set.h"
 #include "containers.h"
 
 namespace graphs
@@ -16,13 +17,14 @@ namespace graphs
 	 * For each vertex provided to operator()(path), run DFS on it.
 	 * Querry results with marked().
 	 * 
-	 * Create a bool array _marked[], and a vertex array _edgeTo[], for each vertex 
-	 * in the path passed to operator()().
+	 * Mark the vertices reachable from each vertex in the path passed to operator()() in the
+	 * visited_set _marked.  As it is cleared in constant time, the cost of a call is
+	 * proportional to the vertices reached, not to the size of the graph.  The marked vertices
+	 * may be walked in order via visited().find_next_set().
 	 * Starting with vertex s,
 	 * 		Mark vertex having been visited as true
 	 * 		Obtain its adjacency vertices
 	 * 			For each of their unmarked vertices w
-	 * 				Mark their _edgeTo[] entry, designating that the edge v->w exists.
 	 * 				Call dfs(g, w)
 	 * 
 	 * O(sum(degrees of the vertices), as ALL vertices are visited.
@@ -45,6 +47,7 @@ namespace graphs
 		~directed_DFS_multi();
 		
 		bool marked(const uint&) const;
+		const visited_set& visited() const { return _marked; }
 		int count() const { return _count; }
 		
 		void setGraph(const digraph&);
@@ -59,8 +62,7 @@ namespace graphs
 		void _allocate(const digraph&);
 		void _reset();
 
-		bool* _marked = nullptr;
-		uint* _edgeTo = nullptr;
+		visited_set _marked;
 		digraph* p_g = nullptr;
 
 		uint _count = 0;
@@ -6,10 +6,13 @@
 
 #include "_graphs.h"
 #include "edge.h"
+#include "graph_version.h"
 
 namespace graphs
 {
-	class edge_weighted_digraph
+	// Versioning and change tracking are inherited from graph_version.
+	
+	class edge_weighted_digraph : public graph_version
 	{
 	public:
 		edge_weighted_digraph() noexcept;
@@ -3,6 +3,7 @@
 
 #include "_graphs.h"
 #include "edge.h"
+#include "graph_version.h"
 
 #include <sstream>
 
@@ -17,11 +18,13 @@ namespace graphs
 	 * (reverse list) of edge pointers.  We save about 50% of storage.  Note that for the
 	 * digraph variant, each vertex needs to store a copy of an edge, in the case that both
 	 * point to one another (possibly forming a cycle).
+	 * 
+	 * Versioning and change tracking are inherited from graph_version.
 	*/
 	
 	using namespace std;
 	
-	class edge_weighted_graph
+	class edge_weighted_graph : public graph_version
 	{
 		
 	public:
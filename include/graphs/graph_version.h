@@ -0,0 +1,99 @@
+#ifndef GRAPH_VERSION_H
+#define GRAPH_VERSION_H
+
+#include <atomic>
+
+#include "_graphs.h"
+
+namespace graphs
+{
+	class graph_version;
+	
+	// One entry of the change log, and the argument passed to observers.
+	struct graph_change
+	{
+		enum change_type : uchar { ADD_EDGE, CLEAR, ASSIGN };
+		
+		change_type type = ADD_EDGE;
+		uint v = undefined_uint;				// The edge, for ADD_EDGE.
+		uint w = undefined_uint;
+		double weight = 0.0;
+		ulong version = 0;						// The graph's version after the change.
+	};
+	
+	/*
+	 * Interface for caches of derived results (e.g. topological) that want to learn about
+	 * changes of a graph right away.  graphChanged() is called after every change,
+	 * graphDestroyed() from the graph's destructor, when only the graph's address is still
+	 * meaningful.  Neither may subscribe or unsubscribe.
+	*/
+	
+	class graph_observer
+	{
+	public:
+		virtual ~graph_observer() {}
+		virtual void graphChanged(const graph_version&, const graph_change&) = 0;
+		virtual void graphDestroyed(const graph_version&) = 0;
+	};
+	
+	/*
+	 * Graph versioning and change tracking, inherited by base_graph, edge_weighted_digraph and
+	 * edge_weighted_graph:
+	 * 
+	 * 		version() changes with every change of the graph.  Versions are drawn from one process
+	 * 		wide counter, so no two states of any two graphs share one, and an algorithm object
+	 * 		may compare a saved version to tell in O(1) whether its results are stale.
+	 * 
+	 * 		With setLogging(true), changes are also appended to a log.  changesSince(version)
+	 * 		returns the changes made after that version, so that results may be updated
+	 * 		incrementally.  It fails if the log does not reach back that far.
+	 * 
+	 * 		Observers subscribed via subscribe() are notified of every change.  As observing does
+	 * 		not change the graph, subscribing works on const graphs.
+	 * 
+	 * A copy is a new graph:  it gets its own version, and neither the log nor the observers are
+	 * copied.
+	*/
+	
+	class graph_version
+	{
+	public:
+		ulong version() const { return _version; }
+		
+		void subscribe(graph_observer*) const;
+		void unsubscribe(graph_observer*) const;
+		
+		void setLogging(const bool&);
+		bool logging() const { return _logging; }
+		void clearLog();
+		uint logSize() const { return _logCount; }
+		const graph_change& logEntry(const uint& i) const { return _log[i]; }
+		bool changesSince(const ulong&, const graph_change*&, const graph_change*&) const;
+	
+	protected:
+		graph_version() noexcept { _version = ++_versions; }
+		graph_version(const graph_version&) noexcept { _version = ++_versions; }
+		graph_version& operator=(const graph_version&) noexcept { return *this; }
+		~graph_version() noexcept;
+		
+		// To be called by the derived class after each change.
+		void _changed(const graph_change::change_type&, const uint& v=undefined_uint, const uint& w=undefined_uint, const double& weight=0.0);
+	
+	private:
+		static std::atomic<ulong> _versions;
+		
+		ulong _version = 0;
+		ulong _logStart = 0;						// The version the log starts after.
+		
+		graph_change* _log = nullptr;
+		uint _logCount = 0;
+		uint _logCapacity = 0;
+		bool _logging = false;
+		
+		mutable graph_observer** p_observers = nullptr;
+		mutable uint _observerCount = 0;
+		mutable uint _observerCapacity = 0;
+	};
+}
+
+#endif
@@ -7,6 +7,7 @@
 #include "depth_first_order.h"
 #include "edge.h"
 #include "edge_weighted_digraph.h"
+#include "graph_version.h"
 
 #include "containers.h"
 
@@ -28,9 +29,13 @@ namespace graphs
 	 * which is the Topological order.
 	 * 
 	 * Running time order is proportional to the running time of DFS, namely O(V+E).
+	 * 
+	 * The order subscribes to the graph it was computed for (see graph_version):  once the graph
+	 * changes, stale() turns true, and refresh() recomputes the order from the same graph.  If the
+	 * graph is destroyed first, the order keeps its last result and refresh() does nothing.
 	*/
 	
-	class topological
+	class topological : public graph_observer
 	{
 		
 	public:
@@ -42,7 +47,7 @@ namespace graphs
 		topological() { _order = new path; };
 		topological(const digraph&);
 		topological(const edge_weighted_digraph&);
-		~topological() { delete _order; };
+		~topological() { _unwatch(); delete _order; };
 		
 		void operator()(const digraph&);
 		void operator()(const edge_weighted_digraph&);
@@ -50,8 +55,21 @@ namespace graphs
 		bool isDAG() const { return _order->size() != 0; }		// If we have a cycle, then _order would be empty!
 		path order() const { return *_order; }
 		
+		bool stale() const { return _stale; }
+		void refresh();
+		
+		void graphChanged(const graph_version&, const graph_change&) override { _stale = true; }
+		void graphDestroyed(const graph_version&) override { p_dg = nullptr; p_ewdg = nullptr; p_source = nullptr; }
+	
 	private:
+		void _watch(const graph_version&);
+		void _unwatch();
+		
 		path* _order = nullptr;
+		const digraph* p_dg = nullptr;					// The graph the order was computed for,
+		const edge_weighted_digraph* p_ewdg = nullptr;	// either one or the other.
+		const graph_version* p_source = nullptr;
+		bool _stale = false;
 	};
 }
 
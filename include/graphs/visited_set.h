@@ -0,0 +1,62 @@
+#ifndef VISITED_SET_H
+#define VISITED_SET_H
+
+#include "_graphs.h"
+
+namespace graphs
+{
+	/*
+	 * Visited set:
+	 * 
+	 * The _marked[] (and _onStack[]) arrays of the traversal classes, packed one bit per vertex
+	 * into 64-bit words.
+	 * 
+	 * Each word carries an epoch stamp, and is only considered part of the set if its stamp
+	 * equals the current epoch.  A word with a stale stamp reads as all zero, and is zeroed on the
+	 * first write.  Thus clear() is a single increment, instead of resetting V entries, which makes
+	 * repeated traversals over a small part of a large graph (e.g. the NFA's per character DFS)
+	 * proportional to the vertices actually visited.  Only when the epoch wraps around are the
+	 * stamps reset.
+	 * 
+	 * Including the stamps, a vertex costs 1.5 bits instead of the 8 of a bool.
+	 * 
+	 * resize() keeps the allocation if it is large enough, so one object may be reused across
+	 * graphs.  find_next_set() and find_next_unset() return size() if there is no such vertex.
+	*/
+	
+	class visited_set
+	{
+	public:
+		visited_set() = default;
+		visited_set(const uint& V) { resize(V); }
+		~visited_set() { delete[] _words; delete[] _epochs; }
+		
+		visited_set(const visited_set&) = delete;
+		visited_set(visited_set&&) = delete;
+		visited_set& operator=(const visited_set&) = delete;
+		visited_set& operator=(visited_set&&) = delete;
+		
+		bool test(const uint& v) const { return (_word(v >> 6) >> (v & 63)) & 1; }
+		void set(const uint& v) { _touch(v >> 6); _words[v >> 6] |= 1ul << (v & 63); }
+		void reset(const uint& v) { _touch(v >> 6); _words[v >> 6] &= ~(1ul << (v & 63)); }
+		
+		void clear();
+		void resize(const uint&);
+		uint size() const { return _size; }
+		uint count() const;
+		uint find_next_set(const uint&) const;
+		uint find_next_unset(const uint&) const;
+	
+	private:
+		ulong _word(const uint& w) const { return _epochs[w] == _epoch ? _words[w] : 0; }
+		void _touch(const uint& w) { if(_epochs[w] != _epoch) { _epochs[w] = _epoch; _words[w] = 0; } }
+		
+		ulong* _words = nullptr;
+		uint* _epochs = nullptr;
+		uint _epoch = 1;
+		uint _size = 0;				// Number of vertices.
+		uint _capacity = 0;			// Number of allocated words.
+	};
+}
+
+#endif
@@ -0,0 +1,279 @@
+#include <cstring>
+
+#include "binary_graph.h"
+
+namespace algorithms
+{
+	static const char graph_magic[4] = {'G', 'R', 'P', 'H'};
+	
+	binary_graph::binary_graph() noexcept
+	{
+		static_assert(sizeof(_header) == 64, "The header keeps the sections after it aligned.");
+	}
+	
+	binary_graph::binary_graph(const std::string& filename) noexcept
+	{
+		load(filename);
+	}
+	
+	binary_graph::~binary_graph() noexcept
+	{
+		unload();
+	}
+	
+	bool binary_graph::write(const std::string& filename, const digraph& g)
+	{
+		return _write(filename, DIGRAPH, g.V(), g.E(), [&g](const uint& v, auto put)
+		{
+			adj_citer begin, end;
+			g.adj(v, begin, end);
+			for(adj_citer w = begin; w != end; w++)
+				put(*w, 0.0);
+		});
+	}
+	
+	bool binary_graph::write(const std::string& filename, const graph& g)
+	{
+		return _write(filename, GRAPH, g.V(), g.E(), [&g](const uint& v, auto put)
+		{
+			adj_citer begin, end;
+			g.adj(v, begin, end);
+			for(adj_citer w = begin; w != end; w++)
+				put(*w, 0.0);
+		});
+	}
+	
+	bool binary_graph::write(const std::string& filename, const edge_weighted_digraph& g)
+	{
+		return _write(filename, EDGE_WEIGHTED_DIGRAPH, g.V(), g.E(), [&g](const uint& v, auto put)
+		{
+			adje_citer begin, end;
+			g.adj(v, begin, end);
+			for(adje_citer e = begin; e != end; e++)
+				put((*e).to(), (*e).weight);
+		});
+	}
+	
+	bool binary_graph::write(const std::string& filename, const edge_weighted_graph& g)
+	{
+		return _write(filename, EDGE_WEIGHTED_GRAPH, g.V(), g.E(), [&g](const uint& v, auto put)
+		{
+			adjpe_citer begin, end;
+			g.adj(v, begin, end);
+			for(adjpe_citer e = begin; e != end; e++)
+				put((*e)->other(v), (*e)->weight);
+		});
+	}
+	
+	template <typename Neighbours>
+	bool binary_graph::_write(const std::string& filename, const kind& type, const uint& V, const uint& E, const Neighbours& neighbours)
+	{
+		// The offsets first, as the header holds their total.
+		ulong* edgeStart = new ulong[V + 1];
+		edgeStart[0] = 0;
+		for(uint v = 0; v < V; v++)
+		{
+			ulong degree = 0;
+			neighbours(v, [&degree](const uint&, const double&) { degree++; });
+			edgeStart[v + 1] = edgeStart[v] + degree;
+		}
+		
+		int fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+		if(fd == -1)
+		{
+			int error = errno;
+			cerr << "binary_graph::write():  Failed to open " << filename << ":  " << strerror(error) << endl;
+			delete[] edgeStart;
+			return false;
+		}
+		
+		// Gather the output into a buffer, and write it out when full.
+		char* buffer = new char[_buffer_size];
+		ulong used = 0;
+		bool written = true;
+		auto out = [&](const void* data, const ulong& bytes)
+		{
+			if(used + bytes > _buffer_size)
+			{
+				written = written && _put(fd, buffer, used);
+				used = 0;
+			}
+			
+			memcpy(buffer + used, data, bytes);
+			used += bytes;
+		};
+		
+		_header header = {};
+		memcpy(header.magic, graph_magic, sizeof(graph_magic));
+		header.version = version;
+		header.kind = type;
+		header.order = _order;
+		header.V = V;
+		header.E = E;
+		header.entries = edgeStart[V];
+		
+		const ulong zero = 0;
+		const ulong entries = edgeStart[V];
+		out(&header, sizeof(header));
+		for(uint v = 0; v <= V; v++)
+			out(edgeStart + v, sizeof(ulong));
+		
+		for(uint v = 0; v < V; v++)
+			neighbours(v, [&out](const uint& w, const double&) { out(&w, sizeof(uint)); });
+		
+		out(&zero, _padded(entries * sizeof(uint)) - entries * sizeof(uint));
+		if(type == EDGE_WEIGHTED_DIGRAPH || type == EDGE_WEIGHTED_GRAPH)
+			for(uint v = 0; v < V; v++)
+				neighbours(v, [&out](const uint&, const double& weight) { out(&weight, sizeof(double)); });
+		
+		written = written && _put(fd, buffer, used);
+		if(close(fd) != 0)
+			written = false;
+		
+		if(written == false)
+			cerr << "binary_graph::write():  Failed writing " << filename << "." << endl;
+		
+		delete[] buffer;
+		delete[] edgeStart;
+		
+		return written;
+	}
+	
+	bool binary_graph::_put(const int& fd, const void* data, const ulong& bytes)
+	{
+		// write() may write less than asked, thus write until all is out.
+		const char* p = (const char*)data;
+		for(ulong left = bytes; left > 0; )
+		{
+			ssize_t n = ::write(fd, p, left);
+			if(n == -1 && errno == EINTR)
+				continue;
+			
+			if(n <= 0)
+			{
+				int error = errno;
+				cerr << "binary_graph::write():  " << strerror(error) << endl;
+				return false;
+			}
+			
+			p += n;
+			left -= n;
+		}
+		
+		return true;
+	}
+	
+	bool binary_graph::load(const std::string& filename)
+	{
+		unload();
+		
+		if(_in.map(filename) == false)
+		{
+			cerr << "binary_graph::load():  Failed to map " << filename << "." << endl;
+			return false;
+		}
+		
+		_header header;
+		if(_in.size() < sizeof(header) || memcmp(_in.begin(), graph_magic, sizeof(graph_magic)) != 0)
+		{
+			cerr << "binary_graph::load():  " << filename << " is not a binary graph file." << endl;
+			_in.unmap();
+			return false;
+		}
+		
+		memcpy(&header, _in.begin(), sizeof(header));
+		if(header.order != _order)
+		{
+			cerr << "binary_graph::load():  " << filename << " was written in another byte order." << endl;
+			_in.unmap();
+			return false;
+		}
+		
+		if(header.version != version)
+		{
+			cerr << "binary_graph::load():  " << filename << " is of version " << header.version << ", not " << version << "." << endl;
+			_in.unmap();
+			return false;
+		}
+		
+		// The size the header makes for, compared in a way that can't overflow.
+		const bool weighted = header.kind == EDGE_WEIGHTED_DIGRAPH || header.kind == EDGE_WEIGHTED_GRAPH;
+		const bool directed = header.kind == DIGRAPH || header.kind == EDGE_WEIGHTED_DIGRAPH;
+		const ulong offsets = sizeof(header) + ((ulong)header.V + 1) * sizeof(ulong);
+		const ulong perEntry = sizeof(uint) + (weighted ? sizeof(double) : 0);
+		if(header.kind > EDGE_WEIGHTED_GRAPH || _in.size() < offsets || header.entries > (_in.size() - offsets) / perEntry
+			|| _in.size() != offsets + _padded(header.entries * sizeof(uint)) + (weighted ? header.entries * sizeof(double) : 0)
+			|| header.entries != (directed ? 1ul : 2ul) * header.E)
+		{
+			cerr << "binary_graph::load():  " << filename << " is truncated or corrupt." << endl;
+			_in.unmap();
+			return false;
+		}
+		
+		const ulong* edgeStart = (const ulong*)(_in.begin() + sizeof(header));
+		bool sorted = edgeStart[0] == 0 && edgeStart[header.V] == header.entries;
+		for(uint v = 0; v < header.V && sorted == true; v++)
+			sorted = edgeStart[v] <= edgeStart[v + 1];
+		
+		if(sorted == false)
+		{
+			cerr << "binary_graph::load():  The offsets of " << filename << " are corrupt." << endl;
+			_in.unmap();
+			return false;
+		}
+		
+		// The mapping was advised for a sequential read, whereas a graph is walked all over.
+		madvise((void*)_in.begin(), _in.size(), MADV_NORMAL);
+		
+		_kind = (kind)header.kind;
+		_V = header.V;
+		_E = header.E;
+		_entries = header.entries;
+		_edgeStart = edgeStart;
+		_targets = (const uint*)(_in.begin() + offsets);
+		_weights = weighted ? (const double*)(_in.begin() + offsets + _padded(_entries * sizeof(uint))) : nullptr;
+		
+		return true;
+	}
+	
+	void binary_graph::unload()
+	{
+		_in.unmap();
+		_edgeStart = nullptr;
+		_targets = nullptr;
+		_weights = nullptr;
+		_kind = DIGRAPH;
+		_V = 0;
+		_E = 0;
+		_entries = 0;
+	}
+	
+	bool binary_graph::verify() const
+	{
+		if(ready() == false)
+			return false;
+		
+		for(ulong i = 0; i < _entries; i++)
+		{
+			if(_targets[i] >= _V)
+			{
+				cerr << "binary_graph::verify():  Vertex " << _targets[i] << " out of [0, " << _V << ")." << endl;
+				return false;
+			}
+		}
+		
+		return true;
+	}
+	
+	void binary_graph::adj(const uint& v, const uint*& begin, const uint*& end) const
+	{
+		begin = _targets + _edgeStart[v];
+		end = _targets + _edgeStart[v + 1];
+	}
+	
+	void binary_graph::adj(const uint& v, const uint*& begin, const uint*& end, const double*& weights) const
+	{
+		adj(v, begin, end);
+		weights = _weights != nullptr ? _weights + _edgeStart[v] : nullptr;
+	}
+}
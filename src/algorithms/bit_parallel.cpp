@@ -0,0 +1,157 @@
+#include "bit_parallel.h"
+
+namespace algorithms
+{
+	bit_parallel::bit_parallel(directed_DFS_multi& closure, const ulong* bytes, const uint& M) noexcept
+	{
+		_M = M;
+		_V = M + 1;
+		_words = (_V + 63) / 64;
+		
+		_masks = new ulong[256 * _words];
+		for(uint i = 0; i < 256 * _words; i++)
+			_masks[i] = 0;
+		
+		// Transpose the bytes per state into positions per byte, and collect the positions.
+		ulong positions[max_words] = {0};
+		for(uint v = 0; v < _M; v++)
+			for(uint c = 0; c < 256; c++)
+				if(((bytes[4*v + (c >> 6)] >> (c & 63)) & 1) != 0)
+				{
+					_masks[c * _words + (v >> 6)] |= 1ul << (v & 63);
+					positions[v >> 6] |= 1ul << (v & 63);
+				}
+		
+		// The first positions, those reached from the start state, and the follow set of each position v, those reached
+		// from v+1.  v is a last position if v+1 reaches M.
+		ulong* follow = new ulong[_V * _words];
+		for(uint i = 0; i < _V * _words; i++)
+			follow[i] = 0;
+		
+		for(uint v = 0; v < _V; v++)
+		{
+			closure(v);
+			ulong* reached = v == 0 ? _first : follow + (v - 1) * _words;
+			const visited_set& marked = closure.visited();
+			for(uint w = marked.find_next_set(0); w < _V; w = marked.find_next_set(w+1))
+				reached[w >> 6] |= (1ul << (w & 63)) & positions[w >> 6];
+			
+			if(marked.find_next_set(_M) == _M)
+			{
+				if(v == 0)
+					_empty = true;
+				else
+					_last[(v - 1) >> 6] |= (1ul << ((v - 1) & 63)) & positions[(v - 1) >> 6];
+			}
+		}
+		
+		// The follow table of each chunk:  a value's entry is that of the value without its lowest bit, and the follow
+		// set of the position of that bit.
+		_follow = new ulong[_words * _chunks * 256 * _words];
+		for(uint chunk = 0; chunk < _words * _chunks; chunk++)
+		{
+			ulong* table = _follow + chunk * 256 * _words;
+			for(uint u = 0; u < _words; u++)
+				table[u] = 0;
+			
+			for(uint b = 1; b < 256; b++)
+			{
+				uint v = 8 * chunk + __builtin_ctz(b);
+				const ulong* rest = table + (b & (b - 1)) * _words;
+				for(uint u = 0; u < _words; u++)
+					table[b * _words + u] = rest[u] | (v < _M ? follow[v * _words + u] : 0);
+			}
+		}
+		
+		delete[] follow;
+	}
+	
+	bit_parallel::~bit_parallel() noexcept
+	{
+		delete[] _masks;
+		delete[] _follow;
+	}
+	
+	template <typename Iterator>
+	bool bit_parallel::_run(Iterator i, const Iterator& end) const
+	{
+		if(i == end)
+			return _empty;
+		
+		if(_words == 1)
+		{
+			// The common case, a single word.
+			ulong D = _first[0] & _masks[(uchar)*i];
+			for(i++; i != end && D != 0; i++)
+			{
+				ulong F = 0;
+				for(uint chunk = 0; D != 0; chunk++, D >>= 8)
+					if((D & 255) != 0)
+						F |= _follow[chunk * 256 + (D & 255)];
+				
+				D = F & _masks[(uchar)*i];
+			}
+			
+			return (D & _last[0]) != 0;
+		}
+		
+		ulong D[max_words];
+		ulong F[max_words];
+		const ulong* mask = _masks + (uchar)*i * _words;
+		bool alive = false;
+		for(uint w = 0; w < _words; w++)
+		{
+			D[w] = _first[w] & mask[w];
+			alive |= D[w] != 0;
+		}
+		
+		for(i++; i != end && alive == true; i++)
+		{
+			for(uint u = 0; u < _words; u++)
+				F[u] = 0;
+			
+			for(uint w = 0; w < _words; w++)
+			{
+				ulong bits = D[w];
+				for(uint chunk = w * _chunks; bits != 0; chunk++, bits >>= 8)
+				{
+					if((bits & 255) == 0)
+						continue;
+					
+					const ulong* f = _follow + (chunk * 256 + (bits & 255)) * _words;
+					for(uint u = 0; u < _words; u++)
+						F[u] |= f[u];
+				}
+			}
+			
+			mask = _masks + (uchar)*i * _words;
+			alive = false;
+			for(uint w = 0; w < _words; w++)
+			{
+				D[w] = F[w] & mask[w];
+				alive |= D[w] != 0;
+			}
+		}
+		
+		bool accepted = false;
+		for(uint w = 0; w < _words; w++)
+			accepted |= (D[w] & _last[w]) != 0;
+		
+		return accepted;
+	}
+	
+	bool bit_parallel::recognizes(const std::string& text) const
+	{
+		return _run(text.cbegin(), text.cend());
+	}
+	
+	bool bit_parallel::recognizes(const stci& begin, const stci& end) const
+	{
+		return _run(begin, end);
+	}
+	
+	bool bit_parallel::recognizes(const lici& begin, const lici& end) const
+	{
+		return _run(begin, end);
+	}
+}
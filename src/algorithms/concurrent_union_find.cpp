@@ -0,0 +1,83 @@
+#include "concurrent_union_find.h"
+
+namespace algorithms
+{
+	concurrent_union_find::concurrent_union_find(const uint& N) noexcept
+	{
+		// At initialiation, every element is in its own component.
+		_count = N;
+		_size = N;
+		_id = new std::atomic<uint>[_size];
+		
+		for(uint i = 0; i < _size; i++)
+			_id[i].store(i, std::memory_order_relaxed);
+	}
+	
+	uint concurrent_union_find::find(const uint& q)
+	{
+		uint p = q;
+		
+		// Follow links to find root, pointing each visited site to its grandparent.  Should the swap
+		// fail, some other thread has changed the link to a site closer to the root, so just move on.
+		while(true)
+		{
+			uint parent = _id[p].load(std::memory_order_acquire);
+			if(parent == p)
+				return p;
+			
+			uint grandparent = _id[parent].load(std::memory_order_acquire);
+			if(parent != grandparent)
+				_id[p].compare_exchange_weak(parent, grandparent, std::memory_order_release, std::memory_order_relaxed);
+			
+			p = grandparent;
+		}
+	}
+	
+	bool concurrent_union_find::connected(const uint& p, const uint& q)
+	{
+		uint i = p;
+		uint j = q;
+		
+		// Two roots are only conclusive if the first is still a root after the second was found, as
+		// a concurrent union might have linked it in the meantime.
+		while(true)
+		{
+			i = find(i);
+			j = find(j);
+			if(i == j)
+				return true;
+			
+			if(_id[i].load(std::memory_order_acquire) == i)
+				return false;
+		}
+	}
+	
+	bool concurrent_union_find::formUnion(const uint& p, const uint& q)
+	{
+		uint i = p;
+		uint j = q;
+		
+		while(true)
+		{
+			i = find(i);
+			j = find(j);
+			if(i == j)
+				return false;
+			
+			// Make the lower priority root point to the higher one
+			if(_priority(i) > _priority(j))
+			{
+				uint t = i;
+				i = j;
+				j = t;
+			}
+			
+			uint expected = i;
+			if(_id[i].compare_exchange_strong(expected, j, std::memory_order_acq_rel, std::memory_order_acquire))
+			{
+				_count.fetch_sub(1, std::memory_order_relaxed);
+				return true;
+			}
+		}
+	}
+}
@@ -0,0 +1,468 @@
+#include <cstring>
+
+#include "dfa.h"
+
+namespace algorithms
+{
+	// The characters NFA's sanity check rejects unless escaped, or first.
+	static bool isMeta(const uint& c)
+	{
+		return c == '(' or c == ')' or c == '*' or c == '?' or c == '^' or c == '|';
+	}
+	
+	static const char blob_magic[4] = {'D', 'F', 'A', '1'};
+	
+	DFA::DFA(NFA& nfa) noexcept
+	{
+		compile(nfa);
+	}
+	
+	DFA::DFA(const std::string& re) noexcept
+	{
+		NFA nfa(re);
+		compile(nfa);
+	}
+	
+	DFA::DFA(const char* blob, const ulong& size) noexcept
+	{
+		load(blob, size);
+	}
+	
+	DFA::~DFA() noexcept
+	{
+		_release();
+	}
+	
+	void DFA::_release()
+	{
+		delete[] _table;
+		delete[] _accepting;
+		_table = nullptr;
+		_accepting = nullptr;
+		_states = 0;
+		_classCount = 0;
+		_start = 0;
+		_dead = _none;
+	}
+	
+	bool DFA::compile(NFA& nfa)
+	{
+		_release();
+		
+		if(nfa.ready() == false)
+		{
+			cerr << "DFA::compile():  The NFA is not initialized." << endl;
+			return false;
+		}
+		
+		// Subset construction:  a lazy_dfa without a budget meets every reachable set of NFA states.
+		lazy_dfa subsets(nfa.p_program->edgeStart(), nfa.p_program->edges(), nfa._bytes, nfa._M, ULONG_MAX);
+		for(uint q = 0; q < subsets.states(); q++)
+			for(uint c = 0; c < 256; c++)
+				subsets.next(q, c);
+		
+		// The product with the sanity check:  state 2q+e, where e tells if a metacharacter may come next.
+		uint n = 2 * subsets.states();
+		bool sanitize = nfa._sanitize;
+		uint* delta = new uint[n * 256];
+		bool* accepting = new bool[n];
+		for(uint p = 0; p < n; p++)
+		{
+			uint q = p / 2;
+			accepting[p] = subsets.accepting(q);
+			for(uint c = 0; c < 256; c++)
+			{
+				if(sanitize == true && (p & 1) == 0 && isMeta(c) == true)
+					delta[p * 256 + c] = 2 * lazy_dfa::dead;
+				else
+					delta[p * 256 + c] = 2 * subsets.next(q, c) + (sanitize == true && c == '\\' ? 1 : 0);
+			}
+		}
+		
+		// Keep the states reachable from the start, numbered in order of discovery.
+		uint start = 2 * lazy_dfa::start + 1;
+		uint* id = new uint[n];
+		uint* order = new uint[n];
+		for(uint p = 0; p < n; p++)
+			id[p] = _none;
+		
+		uint m = 0;
+		id[start] = m;
+		order[m++] = start;
+		for(uint i = 0; i < m; i++)
+		{
+			for(uint c = 0; c < 256; c++)
+			{
+				uint t = delta[order[i] * 256 + c];
+				if(id[t] == _none)
+				{
+					id[t] = m;
+					order[m++] = t;
+				}
+			}
+		}
+		
+		// Byte classes:  bytes with the same column over all reachable states.
+		uint representative[256];
+		uint k = 0;
+		for(uint b = 0; b < 256; b++)
+		{
+			uint a = 0;
+			for(; a < k; a++)
+			{
+				uint r = representative[a];
+				uint i = 0;
+				while(i < m && delta[order[i] * 256 + b] == delta[order[i] * 256 + r])
+					i++;
+				
+				if(i == m)
+					break;
+			}
+			
+			if(a == k)
+				representative[k++] = b;
+			
+			_classes[b] = a;
+		}
+		
+		uint* table = new uint[m * k];
+		bool* accepts = new bool[m];
+		for(uint i = 0; i < m; i++)
+		{
+			accepts[i] = accepting[order[i]];
+			for(uint a = 0; a < k; a++)
+				table[i * k + a] = id[delta[order[i] * 256 + representative[a]]];
+		}
+		
+		delete[] delta;
+		delete[] accepting;
+		delete[] id;
+		
+		uint* blockOf = new uint[m];
+		uint blocks = _minimize(m, table, accepts, k, blockOf);
+		
+		// Renumber the blocks in order of discovery from the start, which makes equal RE-s give equal blobs.
+		uint* number = new uint[blocks];
+		uint* member = new uint[blocks];
+		for(uint b = 0; b < blocks; b++)
+			number[b] = _none;
+		
+		_states = 0;
+		number[blockOf[0]] = _states;
+		member[_states++] = 0;
+		for(uint i = 0; i < _states; i++)
+		{
+			for(uint a = 0; a < k; a++)
+			{
+				uint b = blockOf[table[member[i] * k + a]];
+				if(number[b] == _none)
+				{
+					number[b] = _states;
+					member[_states++] = table[member[i] * k + a];
+				}
+			}
+		}
+		
+		_classCount = k;
+		_table = new uint[_states * _classCount];
+		_accepting = new bool[_states];
+		for(uint s = 0; s < _states; s++)
+		{
+			_accepting[s] = accepts[member[s]];
+			bool stuck = _accepting[s] == false;
+			for(uint a = 0; a < k; a++)
+			{
+				_table[s * k + a] = number[blockOf[table[member[s] * k + a]]];
+				stuck = stuck && _table[s * k + a] == s;
+			}
+			
+			if(stuck == true)
+				_dead = s;
+		}
+		
+		_start = 0;
+		
+		delete[] order;
+		delete[] table;
+		delete[] accepts;
+		delete[] blockOf;
+		delete[] number;
+		delete[] member;
+		
+		return true;
+	}
+	
+	uint DFA::_minimize(const uint& n, const uint* table, const bool* accepting, const uint& k, uint* blockOf)
+	{
+		/*
+		 * Hopcroft's partition refinement.  The states are kept in elements[], each block a contiguous
+		 * slice [first, end) of it, with its marked states moved to the front of the slice.  For a splitter
+		 * block A and byte class a, every block holding both predecessors of A on a and other states splits
+		 * in two.  Of the halves, both go on the worklist if the block was on it, else the smaller one.
+		*/
+		
+		// Predecessors of state t on class a:  pred[predStart[a*(n+1) + t], predStart[a*(n+1) + t + 1]).
+		uint* predStart = new uint[k * (n + 1) + 1];
+		uint* pred = new uint[n * k];
+		for(uint i = 0; i < k * (n + 1) + 1; i++)
+			predStart[i] = 0;
+		
+		for(uint p = 0; p < n; p++)
+			for(uint a = 0; a < k; a++)
+				predStart[a * (n + 1) + table[p * k + a] + 1]++;
+		
+		for(uint i = 1; i < k * (n + 1) + 1; i++)
+			predStart[i] += predStart[i-1];
+		
+		uint* fill = new uint[k * (n + 1)];
+		for(uint i = 0; i < k * (n + 1); i++)
+			fill[i] = predStart[i];
+		
+		for(uint p = 0; p < n; p++)
+			for(uint a = 0; a < k; a++)
+				pred[fill[a * (n + 1) + table[p * k + a]]++] = p;
+		
+		uint* elements = new uint[n];
+		uint* location = new uint[n];
+		uint* first = new uint[n];
+		uint* end = new uint[n];
+		uint* marked = new uint[n];
+		bool* waiting = new bool[n];
+		uint* worklist = new uint[n];
+		uint* touched = new uint[n];
+		uint* splitter = new uint[n];
+		
+		// The initial partition:  accepting states, then the others.
+		uint count = 0;
+		uint blocks = 0;
+		uint waitingCount = 0;
+		for(uint pass = 0; pass < 2; pass++)
+		{
+			uint begin = count;
+			for(uint p = 0; p < n; p++)
+			{
+				if(accepting[p] == (pass == 0))
+				{
+					location[p] = count;
+					elements[count++] = p;
+					blockOf[p] = blocks;
+				}
+			}
+			
+			if(count != begin)
+			{
+				first[blocks] = begin;
+				end[blocks] = count;
+				marked[blocks] = 0;
+				waiting[blocks] = true;
+				worklist[waitingCount++] = blocks;
+				blocks++;
+			}
+		}
+		
+		while(waitingCount > 0)
+		{
+			uint A = worklist[--waitingCount];
+			waiting[A] = false;
+			
+			// A may split while it is the splitter, so work on a copy.
+			uint size = end[A] - first[A];
+			for(uint i = 0; i < size; i++)
+				splitter[i] = elements[first[A] + i];
+			
+			for(uint a = 0; a < k; a++)
+			{
+				uint touchedCount = 0;
+				for(uint i = 0; i < size; i++)
+				{
+					uint t = splitter[i];
+					for(uint j = predStart[a * (n + 1) + t]; j < predStart[a * (n + 1) + t + 1]; j++)
+					{
+						uint p = pred[j];
+						uint B = blockOf[p];
+						uint boundary = first[B] + marked[B];
+						if(location[p] < boundary)
+							continue;
+						
+						// Mark p:  swap it to the end of B's marked states.
+						uint q = elements[boundary];
+						elements[boundary] = p;
+						elements[location[p]] = q;
+						location[q] = location[p];
+						location[p] = boundary;
+						
+						if(marked[B]++ == 0)
+							touched[touchedCount++] = B;
+					}
+				}
+				
+				for(uint i = 0; i < touchedCount; i++)
+				{
+					uint B = touched[i];
+					uint m = marked[B];
+					marked[B] = 0;
+					if(m == end[B] - first[B])
+						continue;
+					
+					// The marked states leave B for a new block C.
+					uint C = blocks++;
+					first[C] = first[B];
+					end[C] = first[B] + m;
+					first[B] = end[C];
+					marked[C] = 0;
+					for(uint j = first[C]; j < end[C]; j++)
+						blockOf[elements[j]] = C;
+					
+					if(waiting[B] == true || m < end[B] - first[B])
+					{
+						waiting[C] = true;
+						worklist[waitingCount++] = C;
+					}
+					else
+					{
+						waiting[C] = false;
+						waiting[B] = true;
+						worklist[waitingCount++] = B;
+					}
+				}
+			}
+		}
+		
+		delete[] predStart;
+		delete[] pred;
+		delete[] fill;
+		delete[] elements;
+		delete[] location;
+		delete[] first;
+		delete[] end;
+		delete[] marked;
+		delete[] waiting;
+		delete[] worklist;
+		delete[] touched;
+		delete[] splitter;
+		
+		return blocks;
+	}
+	
+	std::string DFA::save() const
+	{
+		std::string blob;
+		if(ready() == false)
+			return blob;
+		
+		uint header[4] = {_states, _classCount, _start, _dead};
+		blob.append(blob_magic, sizeof(blob_magic));
+		blob.append((const char*)header, sizeof(header));
+		blob.append((const char*)_classes, sizeof(_classes));
+		for(uint s = 0; s < _states; s++)
+			blob.push_back(_accepting[s] ? 1 : 0);
+		
+		blob.append((const char*)_table, _states * _classCount * sizeof(uint));
+		
+		return blob;
+	}
+	
+	bool DFA::load(const char* blob, const ulong& size)
+	{
+		_release();
+		
+		uint header[4] = {0, 0, 0, 0};
+		ulong fixed = sizeof(blob_magic) + sizeof(header) + sizeof(_classes);
+		if(blob == nullptr || size < fixed || std::string(blob, sizeof(blob_magic)) != std::string(blob_magic, sizeof(blob_magic)))
+		{
+			cerr << "DFA::load():  Not a DFA blob." << endl;
+			return false;
+		}
+		
+		memcpy(header, blob + sizeof(blob_magic), sizeof(header));
+		
+		uint states = header[0];
+		uint classes = header[1];
+		if(states == 0 || classes == 0 || classes > 256 || header[2] >= states || (header[3] >= states && header[3] != _none)
+			|| size != fixed + states + (ulong)states * classes * sizeof(uint))
+		{
+			cerr << "DFA::load():  Corrupt DFA blob." << endl;
+			return false;
+		}
+		
+		const char* p = blob + sizeof(blob_magic) + sizeof(header);
+		for(uint b = 0; b < 256; b++)
+		{
+			_classes[b] = p[b];
+			if(_classes[b] >= classes)
+			{
+				cerr << "DFA::load():  Corrupt DFA blob." << endl;
+				return false;
+			}
+		}
+		
+		p += sizeof(_classes);
+		_accepting = new bool[states];
+		for(uint s = 0; s < states; s++)
+			_accepting[s] = p[s] != 0;
+		
+		p += states;
+		_table = new uint[states * classes];
+		memcpy(_table, p, (ulong)states * classes * sizeof(uint));
+		for(uint i = 0; i < states * classes; i++)
+		{
+			if(_table[i] >= states)
+			{
+				cerr << "DFA::load():  Corrupt DFA blob." << endl;
+				_release();
+				return false;
+			}
+		}
+		
+		_states = states;
+		_classCount = classes;
+		_start = header[2];
+		_dead = header[3];
+		
+		return true;
+	}
+	
+	bool DFA::operator()(const std::string& text) const
+	{
+		return recognizes(text);
+	}
+	
+	bool DFA::operator()(const stci& begin, const stci& end) const
+	{
+		return recognizes(begin, end);
+	}
+	
+	bool DFA::operator()(const lici& begin, const lici& end) const
+	{
+		return recognizes(begin, end);
+	}
+	
+	bool DFA::recognizes(const std::string& text) const
+	{
+		return recognizes(text.cbegin(), text.cend());
+	}
+	
+	bool DFA::recognizes(const stci& begin, const stci& end) const
+	{
+		if(_table == nullptr)
+			return false;
+		
+		uint s = _start;
+		for(stci i = begin; i != end && s != _dead; i++)
+			s = _next(s, *i);
+		
+		return _accepting[s];
+	}
+	
+	bool DFA::recognizes(const lici& begin, const lici& end) const
+	{
+		if(_table == nullptr)
+			return false;
+		
+		uint s = _start;
+		for(lici i = begin; i != end && s != _dead; i++)
+			s = _next(s, *i);
+		
+		return _accepting[s];
+	}
+}
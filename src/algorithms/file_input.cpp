@@ -6,15 +6,12 @@ namespace algorithms
 
 	file_input::file_input()
 	{
-		 _buffer = new char[READ_BUFFER_SIZE];
-		 
-		 for(int i = 0; i < READ_BUFFER_SIZE; i++)
-			_buffer[i] = 0;
 	}
 	
 	file_input::~file_input()
 	{
-		delete[] _buffer;
+		unmap();
+		close_stream();
 	}
 	
 	// This is called internally, when class is ready.
@@ -133,103 +130,287 @@ namespace algorithms
 	// This is called internally, if class is ready.
 	bool file_input::read_file(containers::array<algorithms::line>& lines)
 	{
-		int result = 0;
-		int error = 0;
-		int start = 0;
-		int end = 0;
 		int linecount = 0;
-		int filesize = 0;
+		algorithms::line line;
+		line_view view;
 		
-		// uint asize = 0;
+		// Read through the mapping, so that no line is split by a read buffer boundary.
+		if(map(filename) == false)
+		{
+			cerr << "map() failed.  Returning without reading any entries." << endl;
+			return false;
+		}
 		
-		algorithms::line line;
-		algorithms::line::iterator it;
+		for(const char* at = begin(); at != end(); linecount++)
+		{
+			at = next_line(at, end(), view);
+			line.set(view.data, view.length);
+			
+			if(_DEBUG == true)
+			{
+				cout << "line " << linecount << ":  length = " << line.length() << ":  \"";
+				for(algorithms::line::iterator it = line.begin(); it != line.end(); it++)
+					cout << *it;
+				
+				cout << "\"" << endl;
+			}
+			
+			lines.add(line);
+		}
+		
+		if(_DEBUG == true)
+			cout << "read_file():  Finished reading " << size() << " bytes from the file." << endl;
+		
+		unmap();
+		
+		return true;
+	}
+	
+	bool file_input::map(const std::string& filename)
+	{
+		struct stat status;
+		
+		unmap();
+		close_stream();
+		this->filename = filename;
 		
-		// Open the file
 		if(open_file(FileFlag) == false)
 		{
-			cerr << "open_file() failed.  Returning without reading any entries." << endl;
+			cerr << "map():  open_file() failed.  Nothing mapped." << endl;
 			return false;
 		}
 		
-		while( (result = read(fd, _buffer, READ_BUFFER_SIZE)) > 0)
+		if(fstat(fd, &status) == -1)
 		{
-			if(_DEBUG == true)
-				cout << "read_file():  read " << result << " bytes." << endl;
+			int error = errno;
+			cerr << "map():  fstat() failed on " << filename << ":  " << strerror(error) << endl;
+			close_file();
+			return false;
+		}
+		
+		// An empty file has nothing to map, and mmap() rejects a zero length.
+		if(status.st_size > 0)
+		{
+			void* p = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if(p == MAP_FAILED)
+			{
+				int error = errno;
+				cerr << "map():  mmap() failed on " << filename << ":  " << strerror(error) << endl;
+				close_file();
+				return false;
+			}
 			
-			filesize += result;
+			_map = (char*)p;
+			_mapSize = status.st_size;
 			
-			while(end <= result)
+			// Hints only, thus failures are ignored:  read ahead aggressively and free pages behind us, and where the
+			// file system supports it, back the mapping with huge pages to save on TLB misses.
+			madvise(_map, _mapSize, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+			madvise(_map, _mapSize, MADV_HUGEPAGE);
+#endif
+		}
+		
+		// The mapping holds its own reference to the file.
+		close_file();
+		_at = _map;
+		
+		return true;
+	}
+	
+	void file_input::unmap()
+	{
+		if(_map != nullptr)
+		{
+			if(munmap(_map, _mapSize) != 0)
 			{
-				// end is the location of the newline.
-				end = get_line(start);
-				
-				if(start == end)
-					break;
-				
-				if(_DEBUG == true)
-				{
-				
-					cout << "line " << linecount << ":  [" << start << ", " << end << "] = ";
-					for(int i = start; i < end; i++)
-					{
-						cout << _buffer[i];
-					}
-					cout << " ";
-				}
-				
-				line.set(&_buffer[start], end-start+1);
-				
-				if(_DEBUG == true)
-				{
-					cout << "length = " << line.length() << ":  \"";
-					for(it = line.begin(); it != line.end(); it++)
-						cout << *it;
-					
-					cout << "\"" << endl;
-				}
-				
-				start = end + 1;
-				
-				// lines.addAt(linecount, line);
-				lines.add(line);
-				linecount++;
+				int error = errno;
+				cerr << "unmap():  munmap() failed:  " << strerror(error) << endl;
 			}
-			
-			// Reset for next iteration/read.
-			start = 0;
-			end = 0;
 		}
 		
-		if(result == -1)
+		_map = nullptr;
+		_mapSize = 0;
+		_at = nullptr;
+	}
+	
+	bool file_input::stream(const std::string& filename, const ulong& chunk)
+	{
+		unmap();
+		close_stream();
+		this->filename = filename;
+		
+		if(open_file(FileFlag) == false)
 		{
-			error = errno;
-			error_cleanup(error);
+			cerr << "stream():  open_file() failed.  Nothing to stream." << endl;
 			return false;
 		}
 		
+		// A hint only, as with map().
+		posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+		
+		_chunkSize = chunk > 0 ? chunk : default_chunk;
+		_chunk = new char[_chunkSize];
+		_filled = 0;
+		_lines = 0;
+		_at = _chunk;
+		_drained = false;
+		_streaming = true;
+		
+		return true;
+	}
+	
+	void file_input::close_stream()
+	{
+		if(_streaming == false)
+			return;
+		
 		close_file();
+		delete[] _chunk;
+		
+		_chunk = nullptr;
+		_chunkSize = 0;
+		_filled = 0;
+		_lines = 0;
+		_at = nullptr;
+		_streaming = false;
+	}
+	
+	bool file_input::_refill()
+	{
+		// Carry the partial line left over to the front of the chunk, and read in behind it.  A line as long as the
+		// chunk needs a larger one.
+		ulong carry = _chunk + _filled - _at;
+		memmove(_chunk, _at, carry);
+		_at = _chunk;
+		_filled = carry;
+		
+		if(_filled == _chunkSize)
+		{
+			char* chunk = new char[2 * _chunkSize];
+			memcpy(chunk, _chunk, _filled);
+			delete[] _chunk;
+			_chunk = chunk;
+			_at = _chunk;
+			_chunkSize *= 2;
+		}
+		
+		ssize_t result = 0;
+		do
+			result = read(fd, _chunk + _filled, _chunkSize - _filled);
+		while(result == -1 && errno == EINTR);
+		
+		if(result == -1)
+		{
+			int error = errno;
+			cerr << "_refill():  read() failed on " << filename << ":  " << strerror(error) << endl;
+		}
 		
-        if(_DEBUG == true)
-			cout << "read_file():  Finished reading " << filesize << " bytes from the file." << endl;
+		if(result <= 0)
+		{
+			_drained = true;
+			return false;
+		}
+		
+		_filled += result;
 		
 		return true;
 	}
 	
-	int file_input::get_line(int start)
+	bool file_input::next_line(line_view& view)
 	{
-		int end = start;
+		if(_streaming == false)
+		{
+			if(_at == end())
+				return false;
+			
+			_at = next_line(_at, end(), view);
+			return true;
+		}
 		
-		for(int i = start; i < READ_BUFFER_SIZE; i++)
+		// Search the chunk for the end of the line, refilling it until found or the file drained.  Bytes already
+		// searched are not searched again.
+		const char* newline = nullptr;
+		ulong searched = 0;
+		while((newline = (const char*)memchr(_at + searched, '\n', _chunk + _filled - _at - searched)) == nullptr)
 		{
-			if(_buffer[i] == '\n')
-			{
-				end = i;
+			searched = _chunk + _filled - _at;
+			if(_drained == true || _refill() == false)
 				break;
-			}
 		}
 		
-		return end;
+		ulong left = _chunk + _filled - _at;
+		if(newline == nullptr && left == 0)
+			return false;
+		
+		view.data = _at;
+		view.length = newline != nullptr ? newline - _at : left;
+		_at = newline != nullptr ? newline + 1 : _chunk + _filled;
+		_lines++;
+		
+		return true;
+	}
+	
+	bool file_input::more()
+	{
+		if(_streaming == false)
+			return _at != end();
+		
+		return _at != _chunk + _filled || (_drained == false && _refill() == true);
+	}
+	
+	bool file_input::rewind()
+	{
+		if(_streaming == false)
+		{
+			_at = _map;
+			return true;
+		}
+		
+		if(lseek(fd, 0, SEEK_SET) == -1)
+		{
+			int error = errno;
+			cerr << "rewind():  lseek() failed on " << filename << ":  " << strerror(error) << endl;
+			return false;
+		}
+		
+		_filled = 0;
+		_lines = 0;
+		_at = _chunk;
+		_drained = false;
+		
+		return true;
+	}
+	
+	ulong file_input::linecount() const
+	{
+		// Streaming does not know the lines ahead, only those read so far.
+		if(_streaming == true)
+			return _lines;
+		
+		ulong count = 0;
+		line_view view;
+		
+		for(const char* at = begin(); at != end(); count++)
+			at = next_line(at, end(), view);
+		
+		return count;
+	}
+	
+	const char* file_input::next_line(const char* at, const char* end, line_view& view)
+	{
+		// A line ends at a newline, which it does not include, or at the end of the text.
+		const char* newline = (const char*)memchr(at, '\n', end - at);
+		
+		view.data = at;
+		if(newline == nullptr)
+		{
+			view.length = end - at;
+			return end;
+		}
+		
+		view.length = newline - at;
+		
+		return newline + 1;
 	}
-
 }
@@ -0,0 +1,292 @@
+#include "lazy_dfa.h"
+
+namespace algorithms
+{
+	// Bytes per DFA state apart from its NFA states:  the row, _setStart[], _accepting[] and two buckets.
+	static constexpr const ulong state_cost = 256*sizeof(uint) + sizeof(uint) + sizeof(bool) + 2*sizeof(uint);
+	
+	lazy_dfa::lazy_dfa(const uint* edgeStart, const uint* edges, const ulong* bytes, const uint& M, const ulong& budget) noexcept
+	{
+		p_edgeStart = edgeStart;
+		p_edges = edges;
+		p_bytes = bytes;
+		_M = M;
+		_budget = budget;
+		
+		uint V = _M + 1;
+		_initial = new uint[V];
+		_target = new uint[V];
+		_sources = new uint[V];
+		_stack = new uint[V];
+		_marked.resize(V);
+		
+		// The start state holds the NFA states reachable from NFA state 0.
+		const uint start = 0;
+		_initialCount = _closure(&start, 1, _initial);
+		
+		_flush();
+		_flushes = 0;
+	}
+	
+	lazy_dfa::~lazy_dfa() noexcept
+	{
+		delete[] _table;
+		delete[] _accepting;
+		delete[] _setStart;
+		delete[] _sets;
+		delete[] _buckets;
+		delete[] _initial;
+		delete[] _target;
+		delete[] _sources;
+		delete[] _stack;
+	}
+	
+	void lazy_dfa::budget(const ulong& bytes)
+	{
+		_budget = bytes;
+		if(used() <= _budget)
+			return;
+		
+		// Give the storage back, and start over within the new budget.
+		delete[] _table;
+		delete[] _accepting;
+		delete[] _setStart;
+		delete[] _sets;
+		delete[] _buckets;
+		_table = nullptr;
+		_accepting = nullptr;
+		_setStart = nullptr;
+		_sets = nullptr;
+		_buckets = nullptr;
+		_capacity = 0;
+		_setsCapacity = 0;
+		_bucketCount = 0;
+		
+		_flush();
+	}
+	
+	ulong lazy_dfa::used() const
+	{
+		return _capacity * state_cost + _setsCapacity * sizeof(uint);
+	}
+	
+	uint lazy_dfa::_compute(const uint& s, const uchar& c)
+	{
+		// Follow the match transitions of s's NFA states on c, then the ε-transitions from there.
+		uint m = 0;
+		for(uint i = _setStart[s]; i < _setStart[s+1]; i++)
+		{
+			uint v = _sets[i];
+			if(v != _M && ((p_bytes[4*v + (c >> 6)] >> (c & 63)) & 1) != 0)
+				_sources[m++] = v+1;
+		}
+		
+		uint n = m != 0 ? _closure(_sources, m, _target) : 0;
+		
+		uint t = _find(_target, n);
+		if(t != _none)
+		{
+			_table[(s << 8) + c] = t;
+			return t;
+		}
+		
+		if(_reserve(1, n, false) == false)
+		{
+			// Over budget:  start over.  s is gone with the flush, so its transition is not recorded.
+			_flush();
+			t = _find(_target, n);
+			if(t == _none)
+			{
+				_reserve(1, n, true);
+				t = _add(_target, n);
+			}
+			
+			return t;
+		}
+		
+		t = _add(_target, n);
+		_table[(s << 8) + c] = t;
+		return t;
+	}
+	
+	uint lazy_dfa::_closure(const uint* sources, const uint& n, uint* set)
+	{
+		// The NFA states reachable from the sources via ε-transitions, into set in order.  Returns their number.
+		_marked.clear();
+		uint depth = 0;
+		for(uint i = 0; i < n; i++)
+		{
+			if(_marked.test(sources[i]) == false)
+			{
+				_marked.set(sources[i]);
+				_stack[depth++] = sources[i];
+			}
+		}
+		
+		while(depth > 0)
+		{
+			uint u = _stack[--depth];
+			for(uint e = p_edgeStart[u]; e < p_edgeStart[u+1]; e++)
+			{
+				uint w = p_edges[e];
+				if(_marked.test(w) == false)
+				{
+					_marked.set(w);
+					_stack[depth++] = w;
+				}
+			}
+		}
+		
+		uint count = 0;
+		for(uint v = _marked.find_next_set(0); v <= _M; v = _marked.find_next_set(v+1))
+			set[count++] = v;
+		
+		return count;
+	}
+	
+	uint lazy_dfa::_find(const uint* set, const uint& n) const
+	{
+		uint mask = _bucketCount - 1;
+		for(uint b = _hash(set, n) & mask; _buckets[b] != _none; b = (b + 1) & mask)
+		{
+			uint s = _buckets[b];
+			if(_setStart[s+1] - _setStart[s] != n)
+				continue;
+			
+			uint i = 0;
+			const uint* other = _sets + _setStart[s];
+			while(i < n && other[i] == set[i])
+				i++;
+			
+			if(i == n)
+				return s;
+		}
+		
+		return _none;
+	}
+	
+	uint lazy_dfa::_add(const uint* set, const uint& n)
+	{
+		uint s = _count++;
+		_setStart[s] = _setsCount;
+		for(uint i = 0; i < n; i++)
+			_sets[_setsCount++] = set[i];
+		
+		_setStart[s+1] = _setsCount;
+		_accepting[s] = n > 0 && set[n-1] == _M;
+		
+		uint* row = _table + (s << 8);
+		for(uint c = 0; c < 256; c++)
+			row[c] = _none;
+		
+		uint mask = _bucketCount - 1;
+		uint b = _hash(set, n) & mask;
+		while(_buckets[b] != _none)
+			b = (b + 1) & mask;
+		
+		_buckets[b] = s;
+		
+		return s;
+	}
+	
+	bool lazy_dfa::_reserve(const uint& states, const uint& sets, const bool& force)
+	{
+		uint capacity = _capacity == 0 ? 4 : _capacity;
+		while(capacity < _count + states)
+			capacity *= 2;
+		
+		uint setsCapacity = _setsCapacity == 0 ? 4 * (_M + 1) : _setsCapacity;
+		while(setsCapacity < _setsCount + sets)
+			setsCapacity *= 2;
+		
+		if(capacity == _capacity && setsCapacity == _setsCapacity)
+			return true;
+		
+		if(force == false && capacity * state_cost + setsCapacity * sizeof(uint) > _budget)
+			return false;
+		
+		if(setsCapacity != _setsCapacity)
+		{
+			uint* temp = new uint[setsCapacity];
+			for(uint i = 0; i < _setsCount; i++)
+				temp[i] = _sets[i];
+			
+			delete[] _sets;
+			_sets = temp;
+			_setsCapacity = setsCapacity;
+		}
+		
+		if(capacity != _capacity)
+		{
+			uint* table = new uint[capacity << 8];
+			bool* accepting = new bool[capacity];
+			uint* setStart = new uint[capacity + 1];
+			for(uint i = 0; i < (_count << 8); i++)
+				table[i] = _table[i];
+			
+			for(uint s = 0; s < _count; s++)
+				accepting[s] = _accepting[s];
+			
+			for(uint s = 0; s <= _count && _setStart != nullptr; s++)
+				setStart[s] = _setStart[s];
+			
+			delete[] _table;
+			delete[] _accepting;
+			delete[] _setStart;
+			_table = table;
+			_accepting = accepting;
+			_setStart = setStart;
+			_capacity = capacity;
+			
+			// Rehash into twice as many buckets as states, keeping the table at most half full.
+			delete[] _buckets;
+			_bucketCount = 2 * _capacity;
+			_buckets = new uint[_bucketCount];
+			for(uint b = 0; b < _bucketCount; b++)
+				_buckets[b] = _none;
+			
+			uint mask = _bucketCount - 1;
+			for(uint s = 0; s < _count; s++)
+			{
+				uint b = _hash(_sets + _setStart[s], _setStart[s+1] - _setStart[s]) & mask;
+				while(_buckets[b] != _none)
+					b = (b + 1) & mask;
+				
+				_buckets[b] = s;
+			}
+		}
+		
+		return true;
+	}
+	
+	void lazy_dfa::_flush()
+	{
+		_count = 0;
+		_setsCount = 0;
+		_flushes++;
+		
+		_reserve(2, _initialCount, true);
+		for(uint b = 0; b < _bucketCount; b++)
+			_buckets[b] = _none;
+		
+		_add(_initial, 0);
+		_add(_initial, _initialCount);
+		
+		// Nothing leads out of the dead state.
+		for(uint c = 0; c < 256; c++)
+			_table[(dead << 8) + c] = dead;
+	}
+	
+	uint lazy_dfa::_hash(const uint* set, const uint& n)
+	{
+		// FNV-1a over the NFA states.
+		uint h = 2166136261u;
+		for(uint i = 0; i < n; i++)
+		{
+			h ^= set[i];
+			h *= 16777619u;
+		}
+		
+		return h;
+	}
+}
@@ -36,6 +36,7 @@ namespace algorithms
 	line& line::operator=(const line& rhs) noexcept
 	{
 		m_ptr = pal->copyFromResize(rhs.m_ptr, m_ptr);
+		_size = rhs._size;
 		_length = rhs._length;
 		
 		return *this;
@@ -106,6 +107,7 @@ namespace algorithms
 			return;
 		
 		m_ptr = pal->resizeTo(m_ptr, size);
+		_size = size;
 	}
 	
 	void line::clear()
@@ -119,7 +121,7 @@ namespace algorithms
 		//Get characters from buffer, where index in [0, size), and truncate before any newline character.
 		
 		// Leave one byte for the null termination of the string.
-		if(size > _size)
+		if(size + 1 > _size)
 			resize(size+1);
 
 		_length = 0;
@@ -135,7 +137,7 @@ namespace algorithms
 			}
 		}
 			
-		m_ptr[_length+1] = '\0';
+		m_ptr[_length] = '\0';
 	}
 
 	
@@ -0,0 +1,35 @@
+#include "line_matcher.h"
+
+namespace algorithms
+{
+	line_matcher::line_matcher(NFA& nfa, const arli_citer& begin, const arli_citer& end) noexcept
+		: p_nfa(&nfa), _line(begin), _end(end)
+	{
+	}
+	
+	bool line_matcher::next()
+	{
+		for(; _line != _end; _line++, _lineNumber++, _offset = 0)
+		{
+			uint length = (*_line).length();
+			if(_offset > length)
+				continue;
+			
+			lici begin = (*_line).cbegin();
+			lici end = (*_line).cend();
+			begin += _offset;
+			
+			if(p_nfa->find(begin, end, _span) == true)
+			{
+				_span.begin += _offset;
+				_span.end += _offset;
+				
+				// Continue after the match, or past an empty one.
+				_offset = _span.end > _span.begin ? _span.end : _span.end + 1;
+				return true;
+			}
+		}
+		
+		return false;
+	}
+}
@@ -2,7 +2,7 @@
 
 namespace algorithms
 {
-	const string NFA::pattern = "[[:misc:]][[:alpha:]][[:ALPHA:]][[:ascii:]][[:digit:]][[:hex:]][[:alphanum:]]";
+	const string NFA::pattern = "[[:misc:]][[:alpha:]][[:ALPHA:]][[:ascii:]][[:digit:]][[:hex:]][[:alphanum:]][[:space:]][[:punct:]]";
 	const string::const_iterator NFA::misc_b = NFA::pattern.begin();
 	const string::const_iterator NFA::misc_e = NFA::misc_b + 10;
 	const string::const_iterator NFA::alph_b = NFA::misc_e;
@@ -16,7 +16,134 @@ namespace algorithms
 	const string::const_iterator NFA::hex_b = NFA::num_e;
 	const string::const_iterator NFA::hex_e = NFA::hex_b + 9;
 	const string::const_iterator NFA::alphanum_b = NFA::hex_e;
-	const string::const_iterator NFA::alphanum_e = NFA::pattern.end();
+	const string::const_iterator NFA::alphanum_e = NFA::alphanum_b + 14;
+	const string::const_iterator NFA::space_b = NFA::alphanum_e;
+	const string::const_iterator NFA::space_e = NFA::space_b + 11;
+	const string::const_iterator NFA::punct_b = NFA::space_e;
+	const string::const_iterator NFA::punct_e = NFA::pattern.end();
+	
+	// The class names within bracket sets, as [:name:], in the order of NFA::cc.
+	static const char* const class_names[] = {"misc", "alpha", "ALPHA", "ascii", "digit", "hex", "alphanum", "space", "punct"};
+	
+	// UTF-8:  the length of the character a byte leads, 1 for ASCII, as well as for a stray continuation byte.
+	static uint utf8_length(const uchar& lead)
+	{
+		return lead < 0xC0 ? 1 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : 4;
+	}
+	
+	// Decode the character at s[i] into cp, and move i past it.  False if s[i] begins no valid UTF-8 character.
+	static bool utf8_decode(const string& s, uint& i, uint& cp)
+	{
+		static const uchar payload[] = {0, 0x7F, 0x1F, 0x0F, 0x07};
+		static const uint least[] = {0, 0, 0x80, 0x800, 0x10000};
+		
+		uchar lead = s[i];
+		uint n = utf8_length(lead);
+		if((lead >= 0x80 and lead < 0xC2) or lead > 0xF4 or i + n > s.length())
+			return false;
+		
+		cp = lead & payload[n];
+		for(uint k = 1; k < n; k++)
+		{
+			uchar b = s[i+k];
+			if((b & 0xC0) != 0x80)
+				return false;
+			
+			cp = (cp << 6) | (b & 0x3F);
+		}
+		
+		// Overlong encodings, surrogates and code points beyond U+10FFFF are invalid.
+		if(cp < least[n] or cp > 0x10FFFF or (cp >= 0xD800 and cp <= 0xDFFF))
+			return false;
+		
+		i += n;
+		return true;
+	}
+	
+	// The UTF-8 encoding of cp, into bytes.  Returns its length.
+	static uint utf8_encode(const uint& cp, uchar* bytes)
+	{
+		if(cp < 0x80)
+		{
+			bytes[0] = cp;
+			return 1;
+		}
+		
+		uint n = cp < 0x800 ? 2 : cp < 0x10000 ? 3 : 4;
+		static const uchar lead[] = {0, 0, 0xC0, 0xE0, 0xF0};
+		for(uint k = n - 1; k > 0; k--)
+			bytes[k] = 0x80 | ((cp >> (6*(n-1-k))) & 0x3F);
+		
+		bytes[0] = lead[n] | (cp >> (6*(n-1)));
+		return n;
+	}
+	
+	// The UTF-8 encodings of a range of code points, as a range of values per byte, [lo[k], hi[k]] for byte k.
+	struct utf8_sequence
+	{
+		uint length = 0;
+		uchar lo[4] = {0, 0, 0, 0};
+		uchar hi[4] = {0, 0, 0, 0};
+	};
+	
+	// Split the code points [lo, hi] into utf8_sequence-s, as RE2 and Rust's regex do:  first into ranges of a
+	// single encoding length, then until the trailing bytes of each range either take all continuation values,
+	// [80, BF], or the bytes before them agree.  Thus [U+0400, U+04FF] is [D0-D3][80-BF], while [U+00E9, U+0101]
+	// is [C3][A9-BF] | [C4][80-81].  The surrogates are skipped.
+	static void utf8_split(const uint& lo, const uint& hi, containers::array<utf8_sequence>& out)
+	{
+		static const uint last[] = {0x7F, 0x7FF, 0xFFFF};
+		
+		if(lo > hi)
+			return;
+		
+		if(lo <= 0xDFFF and hi >= 0xD800)
+		{
+			if(lo < 0xD800)
+				utf8_split(lo, 0xD7FF, out);
+			
+			if(hi > 0xDFFF)
+				utf8_split(0xE000, hi, out);
+			
+			return;
+		}
+		
+		for(uint n = 0; n < 3; n++)
+		{
+			if(lo <= last[n] and hi > last[n])
+			{
+				utf8_split(lo, last[n], out);
+				utf8_split(last[n] + 1, hi, out);
+				return;
+			}
+		}
+		
+		for(uint k = 1; k < 4; k++)
+		{
+			uint m = (1u << (6*k)) - 1;
+			if((lo & ~m) != (hi & ~m))
+			{
+				if((lo & m) != 0)
+				{
+					utf8_split(lo, lo | m, out);
+					utf8_split((lo | m) + 1, hi, out);
+					return;
+				}
+				
+				if((hi & m) != m)
+				{
+					utf8_split(lo, (hi & ~m) - 1, out);
+					utf8_split(hi & ~m, hi, out);
+					return;
+				}
+			}
+		}
+		
+		utf8_sequence sequence;
+		sequence.length = utf8_encode(lo, sequence.lo);
+		utf8_encode(hi, sequence.hi);
+		out.add(sequence);
+	}
 	
 	NFA::NFA(const string& regexp) noexcept
 	{
@@ -28,21 +155,21 @@ namespace algorithms
 		_ops = new containers::stack<uint>;
 		_orstack = new containers::stack<uint>;
 		
-		_fpp = new FP[TEST_FUNCTIONS];
-		// Set up the character class function pointer array:
-		// misc, lowercase, uppercase, ascii, numeric, hex, alphanumeric
-		_fpp[0] = &NFA::_isMisc;
-		_fpp[1] = &NFA::_isAlpha;
-		_fpp[2] = &NFA::_isALPHA;
-		_fpp[3] = &NFA::_isASCII;
-		_fpp[4] = &NFA::_isDigit;
-		_fpp[5] = &NFA::_isHex;
-		_fpp[6] = &NFA::_isAlphaNum;
+		// The bytes of each character class, as bit maps.  User sets are added as the RE is processed.
+		_setCapacity = 32;
+		_sets = new ulong[4*_setCapacity];
+		for(uint w = 0; w < 4*_setCapacity; w++)
+			_sets[w] = 0;
 		
-		_ranges = new arar;
+		for(const charclass& c : cc)
+			for(uint b = 0; b < 256; b++)
+				if(_inClass(c, (char)b) == true)
+					_set(c)[b >> 6] |= 1ul << (b & 63);
 		
 		// Transform user provided RE operators/keywords into internally accepted RE operators.
-		_process_re(_re);
+		string wraps;
+		string grouped = _group_utf8(_re, wraps);
+		_process_re(grouped, wraps);
 		_M = _corrected_re.length();
 		p_g = new digraph(_M+1);					// Accepting states between [0, _M]
 
@@ -57,30 +184,64 @@ namespace algorithms
 		
 		// Get states reachable from the RE start state.  This is needed by ALL calculations.
 		(*p_dfs)(0);
+		const visited_set& marked = p_dfs->visited();
+		for(uint v = marked.find_next_set(0); v < _V; v = marked.find_next_set(v+1))
+			_initial_reachable_states->add(v);
+		
+		// Test every byte against every state once, instead of every character of every input.
+		ulong* bytes = new ulong[4*_V];
+		for(uint v = 0; v < 4*_V; v++)
+			bytes[v] = 0;
+		
+		for(uint v = 0; v < _M; v++)
+			for(uint b = 0; b < 256; b++)
+				if(_isMatch((char)b, _corrected_re[v]) == true)
+					bytes[4*v + (b >> 6)] |= 1ul << (b & 63);
+		
+		// The capture slot of each state, for pike_vm.
+		uint* slots = new uint[_V];
 		for(uint v = 0; v < _V; v++)
-			if(p_dfs->marked(v) == true)
-				_initial_reachable_states->add(v);
+			slots[v] = v < _M && _corrected_re[v] >= _capture_start ? _corrected_re[v] - _capture_start : graphs::undefined_uint;
 		
+		// The program owns the graph, the bytes and the slots from here on.
+		p_program = new nfa_program(p_g, *p_dfs, bytes, slots, _M, _groups);
+		_bytes = p_program->bytes();
+		p_filter = p_program->filter();
 		_initialized = true;
+		
+		if(setBackend(BIT_PARALLEL) == false)
+			setBackend(LAZY_DFA);
 	}
 	
 	NFA::~NFA() noexcept
 	{
-		delete p_g;
 		delete _ops;
 		delete _match;
 		delete _reachable_states;
 		delete _initial_reachable_states;
+		delete p_dfa;
+		delete p_vm;
+		delete[] _threads[0];
+		delete[] _threads[1];
+		delete[] _startOf[0];
+		delete[] _startOf[1];
+		delete[] _inList;
+		delete[] _stack;
 		delete p_dfs;
-		delete[] _fpp;
 		delete _orstack;
-		delete _ranges;
+		delete[] _sets;
+		
+		if(p_program != nullptr)
+			p_program->release();
+		else
+			delete p_g;
 	} 
 	
-	bool NFA::_process_re(const string& re)
+	bool NFA::_process_re(const string& re, const string& wraps)
 	{
 		char c = 0;
 		_rangecount = 0;
+		containers::stack<uint> groups;		// The capture group of each '(' not yet closed, if any.
 		
 		// Process RE for character classes, '+', '?' and ranges.
 		for(int i = 0; i < re.length() - 1; i++)
@@ -90,23 +251,26 @@ namespace algorithms
 			if(re[i] == _escape)
 			{
 				_corrected_re.push_back(_escape);
-				_corrected_re.push_back(re[i+1]);
+				_corrected_re.push_back((uchar)re[i+1]);
 				i++;
 				continue;
 			}
 			
 			if(re[i] == '(')
 			{
-				_corrected_re.push_back('(');
+				// The group is captured, unless it only wraps a UTF-8 character or set.
+				uint group = wraps[i] == '0' ? _groups++ : graphs::undefined_uint;
+				groups.push(group);
+				_corrected_re.push_back(_paren(group, '('));
 				
 				// Do we have a user defined, perhaps complemented, character class as well?
-				if(i+3 != re.length() and (re[i+2] == '-' || re[i+3] == '-'))
+				if(i+3 != re.length() and re[i+1] != '[' and (uchar)re[i+1] < 0x80 and (re[i+2] == '-' || re[i+3] == '-'))
 				{
 					char b = 0;
 					char e = 0;
 					bool complement = false;
 					int complement_sign = 0;
-					int rangeID = _rangestart + _rangecount;
+					char32_t rangeID = _newSet();
 					
 					if(re[i+1] == '^')
 					{
@@ -129,25 +293,18 @@ namespace algorithms
 					}
 					else
 					{
-						_rangecount++;
 						_corrected_re.push_back(rangeID);
-						_corrected_re.push_back(')');
+						_corrected_re.push_back(_paren(groups.pop(), ')'));
 						i += 4 + complement_sign;
 					}
 				}
 			}
-			// Test for character classes
-			else if(re[i] == '[' and re[i+1] == '[')
+			// Test for character classes, else bracket sets.
+			else if(re[i] == '[')
 			{
 				uint size = 0;
 				charclass result;
-				bool test = _getClass(re.begin()+i, re.end(), result, size);
-				if(test == false)
-				{
-					cerr << "Could not find valid character class at " << i << endl;
-					goto Quit;
-				}
-				else
+				if(re[i+1] == '[' and _getClass(re.begin()+i, re.end(), result, size) == true)
 				{
 					if(_DEBUG)
 						cout << "Found " << print_charclass(result) << " at " << i << endl;
@@ -155,6 +312,13 @@ namespace algorithms
 					_corrected_re.push_back(result);
 					i += size;
 				}
+				else if(_bracket_set(re, i, size) == true)
+					i += size;
+				else
+				{
+					cerr << "Could not find valid character class or set at " << i << endl;
+					goto Quit;
+				}
 			}
 			// One or more applied to a character
 			else if(re[i-1] != ')' and  c == '+')
@@ -165,7 +329,7 @@ namespace algorithms
 			}
 			else if(c == ')')
 			{
-				_corrected_re.push_back(c);
+				_corrected_re.push_back(_paren(groups.pop(), ')'));
 				// One or more applied to parenthesized group, ending at k, inclusive.
 				if(re[i+1] == '+')
 				{
@@ -176,10 +340,10 @@ namespace algorithms
 					int LP_count = 0;
 					for(j = _corrected_re.length() - 1; j >= 0; j--)
 					{
-						if(_corrected_re[j] == ')')
+						if(_op(_corrected_re[j]) == ')')
 							RP_count++;
 						
-						if(_corrected_re[j] == '(' and ++LP_count == RP_count)
+						if(_op(_corrected_re[j]) == '(' and ++LP_count == RP_count)
 							break;
 					}
 					// We need to copy corrected_re[j, length()-1] to group.
@@ -258,10 +422,10 @@ namespace algorithms
 					int LP_count = 0;
 					for(j = _corrected_re.length() - 1; j >= 0; j--)
 					{
-						if(_corrected_re[j] == ')')
+						if(_op(_corrected_re[j]) == ')')
 							RP_count++;
 						
-						if(_corrected_re[j] == '(' and ++LP_count == RP_count)
+						if(_op(_corrected_re[j]) == '(' and ++LP_count == RP_count)
 							break;
 					}
 					// We need to copy corrected_re[j, length()-1] to group.
@@ -275,18 +439,14 @@ namespace algorithms
 					if(n1 == 0)
 					{
 						// Then add a starting '(', followed by the OR separated group concatenations, and the final ')'.
+						// The longest comes first and the empty one last, so that the range is greedy.
 						_corrected_re.push_back('(');
-						_corrected_re.push_back('|');
-						for(int n = 1; n <= n2; n++)
+						for(int n = n2; n >= 1; n--)
 						{
 							for(int p = 1; p <= n; p++)
-							{
-								for(int q = 0; q < _group.length(); q++)
-									_corrected_re.push_back(_group[q]);
-							}
+								_corrected_re += _group;
 							
-							if(n < n2)
-								_corrected_re.push_back('|');
+							_corrected_re.push_back('|');
 						}
 						_corrected_re.push_back(')');
 						i += range_str_length;
@@ -294,22 +454,23 @@ namespace algorithms
 					// {n1>0, n2} case.
 					else
 					{
-						// This is one less than the minimum repetitions of the group, as corrected_re already contains a copy.
-						for(int n = 1; n < n1; n++)
+						// The minimum repetitions of the group, the copy in corrected_re having been erased above.
+						for(int n = 0; n < n1; n++)
 							_corrected_re += _group;
 						
+						// The optional repetitions, the most first.
 						_corrected_re.push_back('(');
-						_corrected_re.push_back('|');
-						
-						for(int n = 0; n < n2 - n1; n++)
+						for(int n = n2 - n1; n >= 1; n--)
 						{
-							for(int p = 0; p <= n; p++)
+							for(int p = 0; p < n; p++)
 								_corrected_re += _group;
 							
-							if(n < n2 - n1 - 1)
-								_corrected_re.push_back('|');
+							_corrected_re.push_back('|');
 						}
 						
+						if(n1 == n2)
+							_corrected_re.push_back('|');
+						
 						_corrected_re.push_back(')');
 						i += range_str_length;
 					}
@@ -323,10 +484,10 @@ namespace algorithms
 					int LP_count = 0;
 					for(j = _corrected_re.length() - 1; j >= 0; j--)
 					{
-						if(_corrected_re[j] == ')')
+						if(_op(_corrected_re[j]) == ')')
 							RP_count++;
 						
-						if(_corrected_re[j] == '(' and ++LP_count == RP_count)
+						if(_op(_corrected_re[j]) == '(' and ++LP_count == RP_count)
 							break;
 					}
 					
@@ -338,9 +499,10 @@ namespace algorithms
 					for(int l = 0; l < _group.length(); l++)
 						_corrected_re.pop_back();
 
+					// The group first, and the empty alternative last, as greedy.
 					_corrected_re.push_back('(');
-					_corrected_re.push_back('|');
 					_corrected_re += _group;
+					_corrected_re.push_back('|');
 					_corrected_re.push_back(')');
 					i++;
 				}
@@ -349,7 +511,7 @@ namespace algorithms
 			{
 				// Range {n1,n2} applied to an individual character.
 				// In case of a character class, retrieve char from _corrected_re.
-				char temp_char = _corrected_re.back();		
+				char32_t temp_char = _corrected_re.back();		
 				// We know that there exists a '}', so find it.
 				uint n1 = 0, n2 = 0, temp = 0, range_str_length = 0, range_index = i+1;
 				for(int k = i; k < re.length(); k++)
@@ -409,14 +571,12 @@ namespace algorithms
 				{
 					_corrected_re.pop_back();
 					_corrected_re.push_back('(');
-					_corrected_re.push_back('|');
-					for(int n = 1; n <= n2; n++)
+					for(int n = n2; n >= 1; n--)
 					{
 						for(int p = 1; p <= n; p++)
 							_corrected_re.push_back(temp_char);
 						
-						if(n < n2)
-							_corrected_re.push_back('|');
+						_corrected_re.push_back('|');
 					}
 					_corrected_re.push_back(')');
 					i += range_str_length;
@@ -428,16 +588,17 @@ namespace algorithms
 						_corrected_re.push_back(temp_char);
 					
 					_corrected_re.push_back('(');
-					_corrected_re.push_back('|');
-					for(int n = 0; n < n2 - n1; n++)
+					for(int n = n2 - n1; n >= 1; n--)
 					{
-						for(int p = 0; p <= n; p++)
+						for(int p = 0; p < n; p++)
 							_corrected_re.push_back(temp_char);
 						
-						if(n < n2 - n1 - 1)
-							_corrected_re.push_back('|');
+						_corrected_re.push_back('|');
 					}
 					
+					if(n1 == n2)
+						_corrected_re.push_back('|');
+					
 					_corrected_re.push_back(')');
 					i += range_str_length;
 				}
@@ -446,20 +607,20 @@ namespace algorithms
 			{
 				// One or more applied to an individual character.
 				// In case of a character class, use _corrected_re.
-				char temp = _corrected_re.back();		
+				char32_t temp = _corrected_re.back();		
 				_corrected_re.pop_back();
 				_corrected_re.push_back('(');
-				_corrected_re.push_back('|');
 				_corrected_re.push_back(temp);
+				_corrected_re.push_back('|');
 				_corrected_re.push_back(')');
 			}
-			// Any other character gets copied.
+			// Any other character gets copied, byte by byte.
 			else
-				_corrected_re.push_back(re[i]);
+				_corrected_re.push_back((uchar)re[i]);
 		}
 		
-		// Last character from re.
-		_corrected_re.push_back(re[re.length() - 1]);
+		// Last character from re, the ')' closing group 0.
+		_corrected_re.push_back(_paren(groups.size() != 0 ? groups.pop() : graphs::undefined_uint, re[re.length() - 1]));
 		
 		Quit:
 		
@@ -468,6 +629,69 @@ namespace algorithms
 		return false;
 	}
 	
+	string NFA::_group_utf8(const string& re, string& wraps) const
+	{
+		// The operators apply to the byte, class or group before them.  So wrap a non-ASCII character, and a set which
+		// may become an alternation of byte sequences, in a group of its own where an operator follows it.  wraps
+		// marks these groups' parentheses with '1', not to be captured, and any other character with '0'.
+		string grouped;
+		wraps.clear();
+		uint i = 0;
+		while(i < re.length())
+		{
+			uint end = i + 1;
+			bool wide = false;
+			if(re[i] == _escape and i+1 < re.length())
+			{
+				end = i + 1 + utf8_length(re[i+1]);
+				wide = end > i + 2;
+			}
+			else if(re[i] == '[')
+			{
+				wide = i+1 < re.length() and re[i+1] == '^';
+				while(end < re.length() and re[end] != ']')
+				{
+					if(re[end] == '[' and end+1 < re.length() and re[end+1] == ':')
+					{
+						size_t close = re.find(":]", end+2);
+						end = close == string::npos ? re.length() : close + 2;
+						continue;
+					}
+					
+					if(re[end] == _escape and end+1 < re.length())
+						end++;
+					
+					wide |= (uchar)re[end] >= 0x80;
+					end++;
+				}
+				
+				end++;
+			}
+			else
+			{
+				end = i + utf8_length(re[i]);
+				wide = end > i + 1;
+			}
+			
+			end = std::min(end, (uint)re.length());
+			char next = end < re.length() ? re[end] : 0;
+			if(wide == true and (next == '*' or next == '+' or next == '?' or next == '{'))
+			{
+				grouped += "(" + re.substr(i, end - i) + ")";
+				wraps += "1" + string(end - i, '0') + "1";
+			}
+			else
+			{
+				grouped += re.substr(i, end - i);
+				wraps += string(end - i, '0');
+			}
+			
+			i = end;
+		}
+		
+		return grouped;
+	}
+	
 	bool NFA::_getClass(string::const_iterator b, string::const_iterator e, charclass& result, uint& size)
 	{
 		size = 0;
@@ -513,11 +737,23 @@ namespace algorithms
 			size = 14;
 			return true;
 		}
+		else if(_substr_equals(space_b, space_e, b, e) == true)
+		{
+			result = charclass::space;
+			size = 10;
+			return true;
+		}
+		else if(_substr_equals(punct_b, punct_e, b, e) == true)
+		{
+			result = charclass::punct;
+			size = 10;
+			return true;
+		}
 		
 		return false;
 	}
 	
-	bool NFA::_isCharClass(const char& c, charclass& result) const
+	bool NFA::_isCharClass(const char32_t& c, charclass& result) const
 	{
 		if(c >= _class_start and c <= _class_end)
 		{
@@ -546,13 +782,13 @@ namespace algorithms
 	
 	void NFA::_build_graph()
 	{
-		char c = 0;
+		char32_t c = 0;
 		uint LP = 0;		// store the '(' index once encountered, or once it is popped off the stack at a ')'.
 		uint OR = 0;		// store the '|' index once popped off the stack.
 		
 		for(uint i = 0; i < _M-1; i++)
 		{
-			c = _corrected_re[i];
+			c = _op(_corrected_re[i]);
 			
 			if(c == _escape)
 			{
@@ -567,7 +803,7 @@ namespace algorithms
 				p_g->addEdge(i, i+1);
 			}
 			// Kleene closure applied to single character at _re[i-1]:
-			else if( c == '*' and _corrected_re[i-1] != ')' )
+			else if( c == '*' and _op(_corrected_re[i-1]) != ')' )
 			{
 				// Form the following edges:  '*'-ε->_re[i-1], _re[i-1]-ε->'*' and '*'-ε->_re[i+1].
 				p_g->addEdge(i, i-1);
@@ -582,7 +818,7 @@ namespace algorithms
 			else if(c == ')')
 			{
 				// Kleene closure applied to parenthesized group, with ')' at i:
-				if(_corrected_re[i+1] == '*')
+				if(_op(_corrected_re[i+1]) == '*')
 				{
 					// Form the following edges:  '*'-ε->'(', '('-ε->'*' and '*'-ε->_re[i+2].
 					LP = _ops->pop();
@@ -596,16 +832,16 @@ namespace algorithms
 					do
 					{
 						OR = _ops->pop();
-						if(_corrected_re[OR] == '|')
+						if(_op(_corrected_re[OR]) == '|')
 						{
 							p_g->addEdge(OR, i);
 							_orstack->push(OR);
 						}
 					}
-					while(_corrected_re[OR] == '|');
+					while(_op(_corrected_re[OR]) == '|');
 					
 					// At this point, if we had any '|', they're on the stack, and the '|'-ε->')' have been completed.
-					if(_corrected_re[OR] == '(')
+					if(_op(_corrected_re[OR]) == '(')
 					{
 						LP = OR;                        // The '(' was already popped.
 						while(_orstack->size() != 0)
@@ -785,6 +1021,45 @@ namespace algorithms
 		return test;
 	}
 	
+	bool NFA::_isSpace(const char& c) const
+	{
+		// ' ', and '\t', '\n', '\v', '\f', '\r' in [9, 13].
+		return c == 32 || (c >= 9 && c <= 13);
+	}
+	
+	bool NFA::_isPunct(const char& c) const
+	{
+		// The printable ASCII characters, other than alphanumerical and ' '.
+		return c != 32 && _isMisc(c) == true;
+	}
+	
+	bool NFA::_inClass(const charclass& type, const char& c) const
+	{
+		switch(type)
+		{
+			case misc:
+				return _isMisc(c);
+			case lcase:
+				return _isAlpha(c);
+			case ucase:
+				return _isALPHA(c);
+			case ascii:
+				return _isASCII(c);
+			case digit:
+				return _isDigit(c);
+			case hex:
+				return _isHex(c);
+			case alphanum:
+				return _isAlphaNum(c);
+			case space:
+				return _isSpace(c);
+			case punct:
+				return _isPunct(c);
+			default:
+				return false;
+		}
+	}
+	
 	std::string NFA::str() const
 	{
 		using namespace std;
@@ -831,11 +1106,11 @@ namespace algorithms
 				continue;
 			}
 			else
-				o << "g[" << v << ", " << _corrected_re[v] << "] = ";
+				o << "g[" << v << ", " << _symbol(_corrected_re[v]) << "] = ";
 			
 			p_g->adj(v, begin, end);
 			for(it = begin; it != end; it++)
-				o << _corrected_re[v] << "->" << _corrected_re[(*it)] << " ";
+				o << _symbol(_corrected_re[v]) << "->" << _symbol(_corrected_re[(*it)]) << " ";
 			
 			o << endl;
 		}
@@ -845,6 +1120,20 @@ namespace algorithms
 		return o.str();
 	}
 	
+	string NFA::_symbol(const char32_t& c) const
+	{
+		// A byte or operator as itself, a class by its name, a user set by its number.
+		charclass type;
+		if(_isCharClass(c, type) == true)
+			return print_charclass(type);
+		else if(c >= _capture_start)
+			return string(1, (char)_op(c));
+		else if(c >= _rangestart)
+			return "set " + std::to_string(c - _rangestart);
+		else
+			return string(1, (char)c);
+	}
+	
 	string NFA::print_charclass(const charclass& cc) const
 	{
 		ostringstream o;
@@ -862,6 +1151,12 @@ namespace algorithms
 				o << "misc"; break;
 			case hex:
 				o << "hex"; break;
+			case alphanum:
+				o << "alphanumeric"; break;
+			case space:
+				o << "space"; break;
+			case punct:
+				o << "punctuation"; break;
 			default:
 				o << "unknown character class";
 		}
@@ -875,33 +1170,34 @@ namespace algorithms
 			return;
 		
 		uint count = 0;
-		for(string::const_iterator i = _corrected_re.begin(); i != _corrected_re.end(); i++)
+		for(restring::const_iterator i = _corrected_re.begin(); i != _corrected_re.end(); i++)
 		{
-			char c = *i;
-			charclass type;
-			if(_isCharClass(c, type) == true)
-				cout << count << ":  " << print_charclass(type) << endl;
-			else
-				cout << count << ":  " << c << endl;
-			
+			cout << count << ":  " << _symbol(*i) << endl;
 			count++;
 		}
 		
-		if(_ranges->size() != 0)
+		// The user sets, as the byte ranges they match.
+		for(uint r = 0; r < _rangecount; r++)
 		{
-			for(int i = 0; i < _ranges->size(); i++)
+			const ulong* bits = _set(_rangestart + r);
+			cout << r << ":";
+			for(uint b = 0; b < 256; b++)
 			{
-				ascii_range ar = _ranges->get(i);
-				cout << ar.rangeID - _rangestart  << ":  " << ar.begin << ", " << ar.end << " ";
-				if(ar.complement == true)
-					cout << "true" << endl;
-				else
-					cout << "false" << endl;
+				if(((bits[b >> 6] >> (b & 63)) & 1) == 0 || (b > 0 && ((bits[(b-1) >> 6] >> ((b-1) & 63)) & 1) != 0))
+					continue;
+				
+				uint e = b;
+				while(e < 255 && ((bits[(e+1) >> 6] >> ((e+1) & 63)) & 1) != 0)
+					e++;
+				
+				cout << "  " << b << "-" << e;
 			}
+			
+			cout << endl;
 		}
 	}
 	
-	bool NFA::_create_user_defined_set(const char& begin, const char& end, const int& rangeID, const bool& complement)
+	bool NFA::_create_user_defined_set(const char& begin, const char& end, const char32_t& rangeID, const bool& complement)
 	{
 		// [0-9] < [A-Z] < [a-z].  Three ranges, instead of one, courtesy of ASCII.
 		
@@ -909,88 +1205,309 @@ namespace algorithms
 			return false;
 		
 		if(_isDigit(end) == true)
-		{
-			_ranges->add(ascii_range(rangeID, begin, end, complement));
-			return true;
-		}
+			_addRange(rangeID, begin, end);
 		else if(_isALPHA(end) == true)
 		{
 			if(_isDigit(begin) == true)
 			{
-				_ranges->add(ascii_range(rangeID, begin, '9', complement));
-				_ranges->add(ascii_range(rangeID, 'A', end, complement));
-				return true;
+				_addRange(rangeID, begin, '9');
+				_addRange(rangeID, 'A', end);
 			}
 			else
-			{
-				_ranges->add(ascii_range(rangeID, begin, end, complement));
-				return true;
-			}
+				_addRange(rangeID, begin, end);
 		}
 		else if(_isAlpha(end) == true)
 		{
 			if(_isDigit(begin) == true)
 			{
-				_ranges->add(ascii_range(rangeID, begin, '9', complement));
-				_ranges->add(ascii_range(rangeID, 'A', 'Z', complement));
-				_ranges->add(ascii_range(rangeID, 'a', end, complement));
-				return true;
+				_addRange(rangeID, begin, '9');
+				_addRange(rangeID, 'A', 'Z');
+				_addRange(rangeID, 'a', end);
 			}
 			else if(_isALPHA(begin) == true)
 			{
-				_ranges->add(ascii_range(rangeID, begin, 'Z', complement));
-				_ranges->add(ascii_range(rangeID, 'a', end, complement));
-				return true;
+				_addRange(rangeID, begin, 'Z');
+				_addRange(rangeID, 'a', end);
 			}
 			else
-			{
-				_ranges->add(ascii_range(rangeID, begin, end, complement));
-				return true;
-			}
+				_addRange(rangeID, begin, end);
 		}
+		else
+			return false;
 		
-		return false;
+		if(complement == true)
+			for(uint w = 0; w < 4; w++)
+				_set(rangeID)[w] = ~_set(rangeID)[w];
+		
+		return true;
 	}
 	
-	bool NFA::_isMatch(const char& text, const char& re)
+	void NFA::_addRange(const char32_t& token, const char& begin, const char& end)
 	{
-		// Test for a direct match, user ranges, or built-in character classes:
-		charclass result;
+		for(uint b = (uchar)begin; b <= (uchar)end; b++)
+			_set(token)[b >> 6] |= 1ul << (b & 63);
+	}
+	
+	char32_t NFA::_newSet()
+	{
+		// The token of a new, empty user set, growing the bit maps as needed.
+		uint index = _rangestart - _class_start + _rangecount;
+		if(index == _setCapacity)
+		{
+			ulong* sets = new ulong[8*_setCapacity];
+			for(uint w = 0; w < 4*_setCapacity; w++)
+				sets[w] = _sets[w];
+			
+			delete[] _sets;
+			_sets = sets;
+			_setCapacity *= 2;
+		}
 		
-		if(re < 0)
+		for(uint w = 0; w < 4; w++)
+			_sets[4*index + w] = 0;
+		
+		return _rangestart + _rangecount++;
+	}
+	
+	char32_t NFA::_findSet(const ulong* bits)
+	{
+		// The token of a user set matching the bytes of bits, shared with an equal set made before, if any.
+		for(uint r = 0; r < _rangecount; r++)
+		{
+			const ulong* set = _set(_rangestart + r);
+			if(set[0] == bits[0] and set[1] == bits[1] and set[2] == bits[2] and set[3] == bits[3])
+				return _rangestart + r;
+		}
+		
+		char32_t token = _newSet();
+		for(uint w = 0; w < 4; w++)
+			_set(token)[w] = bits[w];
+		
+		return token;
+	}
+	
+	bool NFA::_bracket_set(const string& re, const uint& at, uint& size)
+	{
+		// A bracket set:  '[', perhaps '^', then characters, ranges a-b, escaped characters and classes [:name:], and ']'.
+		// Its ASCII members become a user set, as the ranges do, and its other, UTF-8, characters ranges of code points,
+		// compiled into the byte sequences encoding them.  Set size to the offset of the ']'.
+		ulong ascii[4] = {0, 0, 0, 0};
+		uint* ranges = new uint[2*re.length() + 2];		// The non-ASCII members, as code point ranges [lo, hi].
+		uint count = 0;
+		bool valid = true;
+		
+		uint i = at + 1;
+		bool complement = false;
+		if(i < re.length() and re[i] == '^')
 		{
-			// Test for character class:
-			if(_isCharClass(re, result) == true)
-				return (this->*_fpp[result - _class_start])(text);
+			complement = true;
+			i++;
+		}
+		
+		uint items = 0;
+		while(valid == true and i < re.length() and re[i] != ']')
+		{
+			if(re[i] == '[' and i+1 < re.length() and re[i+1] == ':')
+			{
+				size_t close = re.find(":]", i+2);
+				if(close == string::npos)
+				{
+					valid = false;
+					break;
+				}
+				
+				string name = re.substr(i+2, close - i - 2);
+				uint k = 0;
+				while(k < sizeof(cc) / sizeof(cc[0]) and name != class_names[k])
+					k++;
+				
+				if(k == sizeof(cc) / sizeof(cc[0]))
+				{
+					valid = false;
+					break;
+				}
+				
+				for(uint w = 0; w < 4; w++)
+					ascii[w] |= _set(cc[k])[w];
+				
+				i = close + 2;
+			}
 			else
 			{
-				// We can only have ranges at this point, or an error.  The rangeID = re.
-				arar_citer begin, end, r;
-				_ranges->get_citers(begin, end);
-				bool test = false;
-				bool complement = false;
-				for(r = begin; r != end; r++)
+				if(re[i] == _escape and i+1 < re.length())
+					i++;
+				
+				uint b = 0;
+				uint e = 0;
+				valid = utf8_decode(re, i, b);
+				e = b;
+				if(valid == true and i+1 < re.length() and re[i] == '-' and re[i+1] != ']')
 				{
-					if(r->rangeID != re)
-						continue;
+					if(re[++i] == _escape and i+1 < re.length())
+						i++;
 					
-					if(r->complement == true)
-						complement = true;
+					valid = utf8_decode(re, i, e) and e >= b;
+				}
+				
+				if(valid == true)
+				{
+					for(uint c = b; c <= e and c < 0x80; c++)
+						ascii[c >> 6] |= 1ul << (c & 63);
 					
-					if(text >= r->begin and text <= r->end)
+					if(e >= 0x80)
 					{
-						test = true; 
-						break;
+						ranges[2*count] = std::max(b, 0x80u);
+						ranges[2*count + 1] = e;
+						count++;
 					}
 				}
+			}
+			
+			items++;
+		}
+		
+		if(valid == false or i == re.length() or items == 0)
+		{
+			delete[] ranges;
+			return false;
+		}
+		
+		if(complement == true)
+		{
+			// The complement of the code points, not of the bytes:  the ASCII ones not in the set, and the gaps
+			// between its other ranges, in order.
+			ascii[0] = ~ascii[0];
+			ascii[1] = ~ascii[1];
+			for(uint r = 1; r < count; r++)
+			{
+				uint lo = ranges[2*r];
+				uint hi = ranges[2*r + 1];
+				uint s = r;
+				for(; s > 0 and ranges[2*(s-1)] > lo; s--)
+				{
+					ranges[2*s] = ranges[2*(s-1)];
+					ranges[2*s + 1] = ranges[2*(s-1) + 1];
+				}
+				
+				ranges[2*s] = lo;
+				ranges[2*s + 1] = hi;
+			}
+			
+			uint gaps = 0;
+			uint next = 0x80;
+			for(uint r = 0; r < count; r++)
+			{
+				uint lo = ranges[2*r];
+				uint hi = ranges[2*r + 1];
+				if(lo > next)
+				{
+					// The gaps are never more than the ranges seen, so they may be written in place.
+					ranges[2*gaps] = next;
+					ranges[2*gaps + 1] = lo - 1;
+					gaps++;
+				}
 				
-				return complement ? !test : test;
+				next = std::max(next, hi + 1);
+			}
+			
+			if(next <= 0x10FFFF)
+			{
+				ranges[2*gaps] = next;
+				ranges[2*gaps + 1] = 0x10FFFF;
+				gaps++;
 			}
 			
+			count = gaps;
+		}
+		
+		containers::array<utf8_sequence> sequences;
+		for(uint r = 0; r < count; r++)
+			utf8_split(ranges[2*r], ranges[2*r + 1], sequences);
+		
+		delete[] ranges;
+		
+		// The ASCII members are one alternative, each byte sequence another.
+		bool hasAscii = ascii[0] != 0 or ascii[1] != 0;
+		uint alternatives = sequences.size() + (hasAscii ? 1 : 0);
+		if(alternatives == 0)
 			return false;
+		
+		if(alternatives > 1)
+			_corrected_re.push_back('(');
+		
+		if(hasAscii == true)
+			_corrected_re.push_back(_findSet(ascii));
+		
+		for(uint s = 0; s < sequences.size(); s++)
+		{
+			if(s > 0 or hasAscii == true)
+				_corrected_re.push_back('|');
+			
+			const utf8_sequence& sequence = sequences[s];
+			for(uint k = 0; k < sequence.length; k++)
+			{
+				ulong bits[4] = {0, 0, 0, 0};
+				for(uint c = sequence.lo[k]; c <= sequence.hi[k]; c++)
+					bits[c >> 6] |= 1ul << (c & 63);
+				
+				_corrected_re.push_back(_findSet(bits));
+			}
 		}
+		
+		if(alternatives > 1)
+			_corrected_re.push_back(')');
+		
+		size = i - at;
+		
+		return true;
+	}
+	
+	bool NFA::_isMatch(const char& text, const char32_t& re)
+	{
+		// Classes, ranges and sets lie beyond the bytes, and test a bit, any other character matches itself.
+		uchar b = text;
+		if(re >= _capture_start)
+			return b == _op(re);
+		else if(re >= _class_start)
+			return ((_set(re)[b >> 6] >> (b & 63)) & 1) != 0;
 		else
-			return text == re;
+			return b == re;
+	}
+	
+	bool NFA::setBackend(const backend& b)
+	{
+		if(_initialized == false)
+			return false;
+		
+		if(b == BIT_PARALLEL and p_program->bits() == nullptr)
+		{
+			if(_DEBUG)
+				cerr << "NFA::setBackend():  " << _V << " states do not fit BIT_PARALLEL." << endl;
+			
+			return false;
+		}
+		
+		// Only the selected backend's storage is kept.
+		if(b != LAZY_DFA)
+		{
+			delete p_dfa;
+			p_dfa = nullptr;
+		}
+		else if(p_dfa == nullptr)
+			p_dfa = new lazy_dfa(p_program->edgeStart(), p_program->edges(), _bytes, _M, _budget);
+		
+		p_bits = b == BIT_PARALLEL ? p_program->bits() : nullptr;
+		
+		_backend = b;
+		
+		return true;
+	}
+	
+	void NFA::dfaBudget(const ulong& bytes)
+	{
+		_budget = bytes;
+		if(p_dfa != nullptr)
+			p_dfa->budget(bytes);
 	}
 	
 	bool NFA::operator()(const string& text)
@@ -1016,7 +1533,22 @@ namespace algorithms
 				return false;
 		}
 		
+		if(_prefilter == true && p_filter->admits(text.data(), text.length()) == false)
+			return false;
+		
 		arui_citer begin, end, v;
+		if(p_bits != nullptr)
+			return p_bits->recognizes(text);
+		
+		if(p_dfa != nullptr)
+		{
+			uint s = lazy_dfa::start;
+			for(int i = 0; i < text.length() && s != lazy_dfa::dead; i++)
+				s = p_dfa->next(s, text[i]);
+			
+			return p_dfa->accepting(s);
+		}
+		
 		*_reachable_states = *_initial_reachable_states;
 		
 		for(int i = 0; i < text.length(); i++)
@@ -1030,18 +1562,16 @@ namespace algorithms
 				if(*v == _M)
 					continue;
 				
-				if(_isMatch(t, _corrected_re[*v]) == true)
+				if(_matches(*v, t) == true)
 					_match->add(*v+1);
 			}
 
 			// Generate the reachable states of the current character, needed for the next iteration.
 			_reachable_states->clear();
 			(*p_dfs)(*_match);
-			for(int v = 0; v < _V; v++)
-			{
-				if(p_dfs->marked(v) == true)
-					_reachable_states->add(v);
-			}
+			const visited_set& marked = p_dfs->visited();
+			for(uint v = marked.find_next_set(0); v < _V; v = marked.find_next_set(v+1))
+				_reachable_states->add(v);
 		}
 		
 		// With ALL the text characters having been consumed, check for success:
@@ -1061,7 +1591,22 @@ namespace algorithms
 				return false;
 		}
 		
+		if(_prefilter == true && _admits(begin, end) == false)
+			return false;
+		
 		arui_citer vbegin, vend, v;
+		if(p_bits != nullptr)
+			return p_bits->recognizes(begin, end);
+		
+		if(p_dfa != nullptr)
+		{
+			uint s = lazy_dfa::start;
+			for(stci i = begin; i != end && s != lazy_dfa::dead; i++)
+				s = p_dfa->next(s, *i);
+			
+			return p_dfa->accepting(s);
+		}
+		
 		*_reachable_states = *_initial_reachable_states;
 		
 		for(stci i = begin; i != end; i++)
@@ -1075,18 +1620,16 @@ namespace algorithms
 				if(*v == _M)
 					continue;
 				
-				if(_isMatch(t, _corrected_re[*v]) == true)
+				if(_matches(*v, t) == true)
 					_match->add(*v+1);
 			}
 			
 			// Generate the reachable states of the current character, needed for the next iteration.
 			_reachable_states->clear();
 			(*p_dfs)(*_match);
-			for(int v = 0; v < _V; v++)
-			{
-				if(p_dfs->marked(v) == true)
-					_reachable_states->add(v);
-			}
+			const visited_set& marked = p_dfs->visited();
+			for(uint v = marked.find_next_set(0); v < _V; v = marked.find_next_set(v+1))
+				_reachable_states->add(v);
 		}
 		
 		// With ALL the text characters having been consumed, check for success:
@@ -1105,8 +1648,23 @@ namespace algorithms
 			if(_input_sanity_check(begin, end) == false)
 				return false;
 		}
-
+		
+		if(_prefilter == true && _admits(begin, end) == false)
+			return false;
+		
 		arui_citer vbegin, vend, v;
+		if(p_bits != nullptr)
+			return p_bits->recognizes(begin, end);
+		
+		if(p_dfa != nullptr)
+		{
+			uint s = lazy_dfa::start;
+			for(lici i = begin; i != end && s != lazy_dfa::dead; i++)
+				s = p_dfa->next(s, *i);
+			
+			return p_dfa->accepting(s);
+		}
+		
 		*_reachable_states = *_initial_reachable_states;
 		
 		for(lici i = begin; i != end; i++)
@@ -1120,18 +1678,16 @@ namespace algorithms
 				if(*v == _M)
 					continue;
 				
-				if(_isMatch(t, _corrected_re[*v]) == true)
+				if(_matches(*v, t) == true)
 					_match->add(*v+1);
 			}
 			
 			// Generate the reachable states of the current character, needed for the next iteration.
 			_reachable_states->clear();
 			(*p_dfs)(*_match);
-			for(int v = 0; v < _V; v++)
-			{
-				if(p_dfs->marked(v) == true)
-					_reachable_states->add(v);
-			}
+			const visited_set& marked = p_dfs->visited();
+			for(uint v = marked.find_next_set(0); v < _V; v = marked.find_next_set(v+1))
+				_reachable_states->add(v);
 		}
 		
 		// With ALL the text characters having been consumed, check for success:
@@ -1142,5 +1698,235 @@ namespace algorithms
 		
 		return false;
 	}
-}
-
+	
+	void NFA::_addThread(const uint& v, const uint& start, const uint& l)
+	{
+		// Add v and its ε-closure to list l, unless already there with an earlier start.
+		if(_inList[l].test(v) == true)
+			return;
+		
+		uint depth = 0;
+		_stack[depth++] = v;
+		_inList[l].set(v);
+		while(depth > 0)
+		{
+			uint u = _stack[--depth];
+			_threads[l][_threadCount[l]++] = u;
+			_startOf[l][u] = start;
+			
+			adj_citer begin, end, w;
+			p_g->adj(u, begin, end);
+			for(w = begin; w != end; w++)
+			{
+				if(_inList[l].test(*w) == false)
+				{
+					_inList[l].set(*w);
+					_stack[depth++] = *w;
+				}
+			}
+		}
+	}
+	
+	template <typename Iterator>
+	bool NFA::_admits(const Iterator& begin, const Iterator& end) const
+	{
+		Iterator first = begin;
+		Iterator last = end;
+		ulong length = last - first;
+		
+		return p_filter->admits(length > 0 ? &*first : nullptr, length);
+	}
+	
+	template <typename Iterator>
+	bool NFA::_find(Iterator i, const Iterator& end, match_span& match)
+	{
+		if(_initialized == false)
+			return false;
+		
+		if(_stack == nullptr)
+		{
+			for(uint l = 0; l < 2; l++)
+			{
+				_threads[l] = new uint[_V];
+				_startOf[l] = new uint[_V];
+			}
+			
+			_inList = new visited_set[2];
+			_inList[0].resize(_V);
+			_inList[1].resize(_V);
+			_stack = new uint[_V];
+		}
+		
+		// The threads of each list are in order of their start, as the threads they come from were,
+		// and the start state is added last.  So the first thread reaching a state has the leftmost start.
+		Iterator last = end;
+		ulong length = last - i;
+		if(_prefilter == true && length > 0 && p_filter->contains(&*i, length) == false)
+			return false;
+		
+		uint current = 0;
+		_threadCount[current] = 0;
+		_inList[current].clear();
+		
+		bool found = false;
+		uint pos = 0;
+		for(;; pos++, i++)
+		{
+			if(found == false)
+			{
+				// No thread alive:  skip to where a match can begin.
+				if(_prefilter == true && _threadCount[current] == 0 && pos < length)
+				{
+					ulong skip = p_filter->skip(&*i, length - pos);
+					i += skip;
+					pos += skip;
+				}
+				
+				_addThread(0, pos, current);
+			}
+			
+			if(_inList[current].test(_M) == true)
+			{
+				uint start = _startOf[current][_M];
+				if(found == false || start <= match.begin)
+				{
+					match.begin = start;
+					match.end = pos;
+					found = true;
+				}
+			}
+			
+			if(i == end)
+				break;
+			
+			uint next = 1 - current;
+			_threadCount[next] = 0;
+			_inList[next].clear();
+			
+			char c = *i;
+			for(uint t = 0; t < _threadCount[current]; t++)
+			{
+				uint v = _threads[current][t];
+				uint start = _startOf[current][v];
+				if(found == true && start > match.begin)
+					break;
+				
+				if(v != _M && _matches(v, c) == true)
+					_addThread(v+1, start, next);
+			}
+			
+			current = next;
+			
+			// No thread left that could start further left, or end further right.
+			if(found == true && _threadCount[current] == 0)
+				break;
+		}
+		
+		return found;
+	}
+	
+	template <typename Iterator>
+	uint NFA::_find_all(const Iterator& begin, const Iterator& end, arspan& matches)
+	{
+		matches.clear();
+		
+		Iterator from = begin;
+		Iterator last = end;
+		uint length = last - from;
+		uint offset = 0;
+		match_span match;
+		
+		while(_find(from, end, match) == true)
+		{
+			match.begin += offset;
+			match.end += offset;
+			matches.add(match);
+			
+			// Continue after the match, or past an empty one.
+			uint next = match.end > match.begin ? match.end : match.end + 1;
+			if(next > length)
+				break;
+			
+			from += next - offset;
+			offset = next;
+		}
+		
+		return matches.size();
+	}
+	
+	bool NFA::find(const string& text, match_span& match)
+	{
+		return _find(text.cbegin(), text.cend(), match);
+	}
+	
+	bool NFA::find(const stci& begin, const stci& end, match_span& match)
+	{
+		return _find(begin, end, match);
+	}
+	
+	bool NFA::find(const lici& begin, const lici& end, match_span& match)
+	{
+		return _find(begin, end, match);
+	}
+	
+	uint NFA::find_all(const string& text, arspan& matches)
+	{
+		return _find_all(text.cbegin(), text.cend(), matches);
+	}
+	
+	uint NFA::find_all(const stci& begin, const stci& end, arspan& matches)
+	{
+		return _find_all(begin, end, matches);
+	}
+	
+	uint NFA::find_all(const lici& begin, const lici& end, arspan& matches)
+	{
+		return _find_all(begin, end, matches);
+	}
+	
+	template <typename Iterator>
+	bool NFA::_capture(const Iterator& begin, const Iterator& end, arspan& groups)
+	{
+		groups.clear();
+		if(_initialized == false)
+			return false;
+		
+		if(_sanitize == true && _input_sanity_check(begin, end) == false)
+			return false;
+		
+		if(_prefilter == true && _admits(begin, end) == false)
+			return false;
+		
+		if(p_vm == nullptr)
+			p_vm = new pike_vm(*p_program);
+		
+		if(p_vm->match(begin, end) == false)
+			return false;
+		
+		const uint* captures = p_vm->captures();
+		for(uint k = 0; k < _groups; k++)
+		{
+			match_span span;
+			span.begin = captures[2*k];
+			span.end = captures[2*k + 1];
+			groups.add(span);
+		}
+		
+		return true;
+	}
+	
+	bool NFA::match(const string& text, arspan& groups)
+	{
+		return _capture(text.cbegin(), text.cend(), groups);
+	}
+	
+	bool NFA::match(const stci& begin, const stci& end, arspan& groups)
+	{
+		return _capture(begin, end, groups);
+	}
+	
+	bool NFA::match(const lici& begin, const lici& end, arspan& groups)
+	{
+		return _capture(begin, end, groups);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+#include "nfa_matcher.h"
+#include "nfa.h"
+
+namespace algorithms
+{
+	nfa_matcher::nfa_matcher(const nfa_program* program, const ulong& budget) noexcept
+	{
+		_initialize(program, budget);
+	}
+	
+	nfa_matcher::nfa_matcher(const NFA& nfa, const ulong& budget) noexcept
+	{
+		_initialize(nfa.program(), budget);
+	}
+	
+	nfa_matcher::~nfa_matcher() noexcept
+	{
+		delete p_dfa;
+		if(p_program != nullptr)
+			p_program->release();
+	}
+	
+	void nfa_matcher::_initialize(const nfa_program* program, const ulong& budget)
+	{
+		if(program == nullptr)
+		{
+			cerr << "nfa_matcher():  No program to match." << endl;
+			return;
+		}
+		
+		p_program = program->acquire();
+		if(p_program->bits() == nullptr)
+			p_dfa = new lazy_dfa(p_program->edgeStart(), p_program->edges(), p_program->bytes(), p_program->accepting(), budget);
+	}
+	
+	template <typename Iterator>
+	bool nfa_matcher::_recognizes(const Iterator& begin, const Iterator& end)
+	{
+		if(p_program == nullptr)
+			return false;
+		
+		// As NFA, reject an operator unless escaped, or first.
+		if(_sanitize == true)
+		{
+			Iterator i = begin;
+			for(char previous = 0; i != end; i++)
+			{
+				char c = *i;
+				if(i != begin and previous != '\\' and (c == '(' or c == ')' or c == '*' or c == '?' or c == '^' or c == '|'))
+					return false;
+				
+				previous = c;
+			}
+		}
+		
+		if(_prefilter == true)
+		{
+			Iterator first = begin;
+			Iterator last = end;
+			ulong length = last - first;
+			if(p_program->filter()->admits(length > 0 ? &*first : nullptr, length) == false)
+				return false;
+		}
+		
+		if(p_program->bits() != nullptr)
+			return p_program->bits()->recognizes(begin, end);
+		
+		uint s = lazy_dfa::start;
+		for(Iterator i = begin; i != end && s != lazy_dfa::dead; i++)
+			s = p_dfa->next(s, *i);
+		
+		return p_dfa->accepting(s);
+	}
+	
+	bool nfa_matcher::recognizes(const std::string& text)
+	{
+		return _recognizes(text.cbegin(), text.cend());
+	}
+	
+	bool nfa_matcher::operator()(const std::string& text)
+	{
+		return _recognizes(text.cbegin(), text.cend());
+	}
+	
+	bool nfa_matcher::recognizes(const stci& begin, const stci& end)
+	{
+		return _recognizes(begin, end);
+	}
+	
+	bool nfa_matcher::operator()(const stci& begin, const stci& end)
+	{
+		return _recognizes(begin, end);
+	}
+	
+	bool nfa_matcher::recognizes(const lici& begin, const lici& end)
+	{
+		return _recognizes(begin, end);
+	}
+	
+	bool nfa_matcher::operator()(const lici& begin, const lici& end)
+	{
+		return _recognizes(begin, end);
+	}
+}
@@ -0,0 +1,62 @@
+#include "nfa_program.h"
+
+namespace algorithms
+{
+	nfa_program::nfa_program(digraph* g, directed_DFS_multi& closure, ulong* bytes, uint* slots, const uint& M, const uint& groups) noexcept
+	{
+		p_g = g;
+		_bytes = bytes;
+		_slots = slots;
+		_groups = groups;
+		_M = M;
+		
+		_edgeStart = new uint[M + 2];
+		_edges = new uint[g->E()];
+		uint e = 0;
+		for(uint v = 0; v <= M; v++)
+		{
+			// The adjacency lists run from the last edge added to the first.
+			_edgeStart[v] = e;
+			adj_citer begin, end, w;
+			g->adj(v, begin, end);
+			for(w = begin; w != end; w++)
+				e++;
+			
+			uint last = e;
+			for(w = begin; w != end; w++)
+				_edges[--last] = *w;
+		}
+		
+		_edgeStart[M + 1] = e;
+		
+		if(M + 1 <= bit_parallel::max_states)
+			p_bits = new bit_parallel(closure, bytes, M);
+		
+		p_filter = new prefilter(closure, *g, bytes, M);
+	}
+	
+	nfa_program::~nfa_program() noexcept
+	{
+		delete p_bits;
+		delete p_filter;
+		delete[] _edgeStart;
+		delete[] _edges;
+		delete[] _bytes;
+		delete[] _slots;
+		delete p_g;
+	}
+	
+	const nfa_program* nfa_program::acquire() const
+	{
+		_references.fetch_add(1, std::memory_order_relaxed);
+		
+		return this;
+	}
+	
+	void nfa_program::release() const
+	{
+		// The last reference deletes the program, once every other holder is done with it.
+		if(_references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			delete this;
+	}
+}
@@ -0,0 +1,92 @@
+#include <cfloat>
+#include <charconv>
+#include <climits>
+
+#include "number_scanner.h"
+
+namespace algorithms
+{
+	bool number_scanner::operator()(const char* begin, const char* end)
+	{
+		_begin = begin;
+		_magnitude = 0;
+		_integer = 0;
+		_real = 0;
+		_digits = 0;
+		_overflow = false;
+		
+		const char* c = begin;
+		_negative = c != end && *c == '-';
+		if(_negative == true)
+			c++;
+		
+		// -?[[:digit:]]+, the largest magnitude being one more when negative.
+		const ulong limit = (ulong)LONG_MAX + (_negative == true ? 1 : 0);
+		const char* digits = c;
+		for(; c != end && *c >= '0' && *c <= '9'; c++)
+		{
+			uint d = *c - '0';
+			if(_magnitude > (limit - d) / 10)
+				_overflow = true;
+			else
+				_magnitude = 10 * _magnitude + d;
+		}
+		
+		if(c == digits)
+			return false;
+		
+		_digits = c - digits;
+		_integer = c - begin;
+		
+		// .?[[:digit:]]*
+		if(c != end && *c == '.')
+			c++;
+		
+		while(c != end && *c >= '0' && *c <= '9')
+			c++;
+		
+		_real = c - begin;
+		
+		// ((e|E)-?[[:digit:]]{1,3})?, only if complete.
+		if(c != end && (*c == 'e' || *c == 'E'))
+		{
+			const char* e = c + 1;
+			if(e != end && *e == '-')
+				e++;
+			
+			const char* exponent = e;
+			while(e != end && e - exponent < 3 && *e >= '0' && *e <= '9')
+				e++;
+			
+			if(e != exponent)
+				_real = e - begin;
+		}
+		
+		return true;
+	}
+	
+	bool number_scanner::toLong(long& value) const
+	{
+		if(_integer == 0 || _overflow == true)
+			return false;
+		
+		value = _negative == true ? (long)(0ul - _magnitude) : (long)_magnitude;
+		
+		return true;
+	}
+	
+	bool number_scanner::toDouble(double& value) const
+	{
+		if(_real == 0)
+			return false;
+		
+		double temp = 0.0;
+		std::from_chars_result r = std::from_chars(_begin, _begin + _real, temp);
+		if(r.ec != std::errc() || (temp != 0.0 && temp < DBL_MIN && temp > -DBL_MIN))
+			return false;
+		
+		value = temp;
+		
+		return true;
+	}
+}
@@ -0,0 +1,346 @@
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <thread>
+
+#include "parallel_edge_reader.h"
+
+namespace algorithms
+{
+	// Run f(t) for t in [0, n), each on a thread of its own, and wait for all.
+	template <typename Function>
+	static void run_threads(const uint& n, Function f)
+	{
+		if(n == 1)
+		{
+			f(0);
+			return;
+		}
+		
+		std::thread* workers = new std::thread[n];
+		for(uint t = 0; t < n; t++)
+			workers[t] = std::thread(f, t);
+		
+		for(uint t = 0; t < n; t++)
+			workers[t].join();
+		
+		delete[] workers;
+	}
+	
+	parallel_edge_reader::parallel_edge_reader(const std::string& filename, const bool& weighted, const uint& threads, const char& delim) noexcept
+	{
+		_weighted = weighted;
+		_delim = delim;
+		_threads = threads > 0 ? threads : std::thread::hardware_concurrency();
+		if(_threads == 0)
+			_threads = 1;
+		
+		if(_in.map(filename) == false)
+		{
+			cerr << "parallel_edge_reader():  Failed reading file " << filename << "." << endl;
+			return;
+		}
+		
+		const char* body = _in.begin();
+		if(_header(body) == false)
+		{
+			cerr << "parallel_edge_reader():  Failed to read in V and E of " << filename << "." << endl;
+			_in.unmap();
+			return;
+		}
+		
+		// Split the edges into chunks of about equal size, each ending with a newline (or the file).
+		_chunks = new _chunk[_threads];
+		const ulong length = _in.end() - body;
+		const char* at = body;
+		for(uint t = 0; t < _threads; t++)
+		{
+			_chunks[t].begin = at;
+			if(t + 1 < _threads)
+			{
+				const char* split = body + length / _threads * (t + 1);
+				if(split < at)
+					split = at;
+				
+				const char* newline = (const char*)memchr(split, '\n', _in.end() - split);
+				at = newline != nullptr ? newline + 1 : _in.end();
+			}
+			else
+				at = _in.end();
+			
+			_chunks[t].end = at;
+		}
+		
+		run_threads(_threads, [this](const uint& t) { _parse(_chunks[t]); });
+		
+		ulong edges = 0;
+		for(uint t = 0; t < _threads; t++)
+		{
+			if(_chunks[t].error != nullptr)
+			{
+				// Number the line by the newlines before it.
+				ulong line = 1;
+				for(const char* i = _in.begin(); (i = (const char*)memchr(i, '\n', _chunks[t].error - i)) != nullptr; i++)
+					line++;
+				
+				cerr << "Line " << line << " of " << filename << ":  Failed reading " << (_weighted ? "v w weight." : "v w.") << endl;
+				_in.unmap();
+				return;
+			}
+			
+			edges += _chunks[t].count;
+		}
+		
+		if(edges != _E)
+			cerr << "parallel_edge_reader():  Read " << edges << " edges from " << filename << ", where E = " << _E << "." << endl;
+		
+		_E = edges;
+		_in.unmap();
+		_initialized = true;
+	}
+	
+	parallel_edge_reader::~parallel_edge_reader() noexcept
+	{
+		for(uint t = 0; _chunks != nullptr && t < _threads; t++)
+		{
+			delete[] _chunks[t].edges;
+			delete[] _chunks[t].weights;
+		}
+		
+		delete[] _chunks;
+	}
+	
+	bool parallel_edge_reader::_header(const char*& at)
+	{
+		const char* end = _in.end();
+		uint* header[] = {&_V, &_E};
+		for(uint i = 0; i < 2; i++)
+		{
+			while(at != end && (_delimiter(*at) == true || *at == '\n'))
+				at++;
+			
+			std::from_chars_result r = std::from_chars(at, end, *header[i]);
+			if(r.ec != std::errc())
+				return false;
+			
+			at = r.ptr;
+		}
+		
+		// The edges start on the line after E.
+		const char* newline = (const char*)memchr(at, '\n', end - at);
+		at = newline != nullptr ? newline + 1 : end;
+		
+		return true;
+	}
+	
+	void parallel_edge_reader::_grow(_chunk& chunk) const
+	{
+		uint* edges = new uint[4 * chunk.capacity];
+		memcpy(edges, chunk.edges, 2 * chunk.count * sizeof(uint));
+		delete[] chunk.edges;
+		chunk.edges = edges;
+		
+		if(_weighted == true)
+		{
+			double* weights = new double[2 * chunk.capacity];
+			memcpy(weights, chunk.weights, chunk.count * sizeof(double));
+			delete[] chunk.weights;
+			chunk.weights = weights;
+		}
+		
+		chunk.capacity *= 2;
+	}
+	
+	void parallel_edge_reader::_parse(_chunk& chunk) const
+	{
+		// Guess at the edges by the bytes, from about 8 bytes an edge without weights and 16 with.
+		chunk.capacity = (chunk.end - chunk.begin) / (_weighted == true ? 16 : 8) + 16;
+		chunk.edges = new uint[2 * chunk.capacity];
+		if(_weighted == true)
+			chunk.weights = new double[chunk.capacity];
+		
+		const uint fields = _weighted == true ? 3 : 2;
+		uint field = 0;
+		uint vw[2] = {0, 0};
+		double weight = 0.0;
+		
+		const char* line = chunk.begin;
+		for(const char* at = chunk.begin; at != chunk.end; )
+		{
+			if(*at == '\n')
+			{
+				// An edge may not span lines.
+				if(field != 0)
+					break;
+				
+				line = ++at;
+				continue;
+			}
+			
+			if(_delimiter(*at) == true)
+			{
+				at++;
+				continue;
+			}
+			
+			std::from_chars_result r;
+			if(field < 2)
+				r = std::from_chars(at, chunk.end, vw[field]);
+			else
+				r = std::from_chars(at, chunk.end, weight);
+			
+			// A number ends at a delimiter, a newline or the end, and a vertex is in [0, V).
+			if(r.ec != std::errc() || (r.ptr != chunk.end && *r.ptr != '\n' && _delimiter(*r.ptr) == false)
+				|| (field < 2 && vw[field] >= _V))
+			{
+				chunk.error = line;
+				return;
+			}
+			
+			at = r.ptr;
+			if(++field == fields)
+			{
+				if(chunk.count == chunk.capacity)
+					_grow(chunk);
+				
+				chunk.edges[2 * chunk.count] = vw[0];
+				chunk.edges[2 * chunk.count + 1] = vw[1];
+				if(_weighted == true)
+					chunk.weights[chunk.count] = weight;
+				
+				chunk.count++;
+				field = 0;
+			}
+		}
+		
+		if(field != 0)
+			chunk.error = line;
+	}
+	
+	digraph parallel_edge_reader::DG() const
+	{
+		if(_initialized == false)
+			return digraph();
+		
+		digraph g(_V);
+		for(uint t = 0; t < _threads; t++)
+			for(ulong i = 0; i < _chunks[t].count; i++)
+				g.addEdge(_chunks[t].edges[2*i], _chunks[t].edges[2*i + 1]);
+		
+		return g;
+	}
+	
+	graph parallel_edge_reader::G() const
+	{
+		if(_initialized == false)
+			return graph();
+		
+		graph g(_V);
+		for(uint t = 0; t < _threads; t++)
+			for(ulong i = 0; i < _chunks[t].count; i++)
+				g.addEdge(_chunks[t].edges[2*i], _chunks[t].edges[2*i + 1]);
+		
+		return g;
+	}
+	
+	edge_weighted_digraph parallel_edge_reader::EWDG() const
+	{
+		if(_initialized == false || _weighted == false)
+			return edge_weighted_digraph();
+		
+		edge_weighted_digraph g(_V);
+		for(uint t = 0; t < _threads; t++)
+			for(ulong i = 0; i < _chunks[t].count; i++)
+				g.addEdge(edge(_chunks[t].edges[2*i], _chunks[t].edges[2*i + 1], _chunks[t].weights[i]));
+		
+		return g;
+	}
+	
+	edge_weighted_graph parallel_edge_reader::EWG() const
+	{
+		if(_initialized == false || _weighted == false)
+			return edge_weighted_graph();
+		
+		edge_weighted_graph g(_V);
+		for(uint t = 0; t < _threads; t++)
+			for(ulong i = 0; i < _chunks[t].count; i++)
+				g.addEdge(edge(_chunks[t].edges[2*i], _chunks[t].edges[2*i + 1], _chunks[t].weights[i]));
+		
+		return g;
+	}
+	
+	compressed_digraph parallel_edge_reader::CDG() const
+	{
+		if(_initialized == false)
+			return compressed_digraph();
+		
+		uint* edgeStart = new uint[_V + 1];
+		uint* targets = new uint[_E];
+		CSR(edgeStart, targets);
+		
+		compressed_digraph g(_V, edgeStart, targets);
+		
+		delete[] edgeStart;
+		delete[] targets;
+		
+		return g;
+	}
+	
+	void parallel_edge_reader::CSR(uint* edgeStart, uint* targets, double* weights) const
+	{
+		// edgeStart holds V+1 entries, targets and weights (if wanted, and weighted) E.
+		if(_initialized == false)
+			return;
+		
+		// A row of V counts per thread would outgrow the rows themselves on a sparse digraph of many vertices.  So the
+		// threads taking part are capped at one per 2V edges, the counts taking at most half the memory of targets, and
+		// each takes a run of consecutive chunks, so that the edges still go in the order of the chunks.
+		const uint groups = std::max(1ul, std::min((ulong)_threads, _E / (2ul * std::max(_V, 1u))));
+		
+		// Each thread counts the sources of the edges of its chunks, in a row of its own.
+		uint* counts = new uint[(ulong)groups * _V];
+		run_threads(groups, [this, counts, groups](const uint& g)
+		{
+			uint* row = counts + (ulong)g * _V;
+			for(uint v = 0; v < _V; v++)
+				row[v] = 0;
+			
+			for(uint t = g * _threads / groups; t < (g + 1) * _threads / groups; t++)
+				for(ulong i = 0; i < _chunks[t].count; i++)
+					row[_chunks[t].edges[2*i]]++;
+		});
+		
+		// The edges of v go in the order of the chunks:  turn each count into where the thread places its first edge.
+		uint start = 0;
+		for(uint v = 0; v < _V; v++)
+		{
+			edgeStart[v] = start;
+			for(uint g = 0; g < groups; g++)
+			{
+				uint n = counts[(ulong)g * _V + v];
+				counts[(ulong)g * _V + v] = start;
+				start += n;
+			}
+		}
+		
+		edgeStart[_V] = start;
+		
+		run_threads(groups, [this, counts, groups, targets, weights](const uint& g)
+		{
+			uint* next = counts + (ulong)g * _V;
+			for(uint t = g * _threads / groups; t < (g + 1) * _threads / groups; t++)
+			{
+				const _chunk& chunk = _chunks[t];
+				for(ulong i = 0; i < chunk.count; i++)
+				{
+					uint at = next[chunk.edges[2*i]]++;
+					targets[at] = chunk.edges[2*i + 1];
+					if(weights != nullptr && _weighted == true)
+						weights[at] = chunk.weights[i];
+				}
+			}
+		});
+		
+		delete[] counts;
+	}
+}
@@ -0,0 +1,327 @@
+#include "pattern_set.h"
+
+namespace algorithms
+{
+	static uint hashTuple(const uint* tuple, const uint& n)
+	{
+		// FNV-1a over the states of the patterns' DFAs.
+		uint h = 2166136261u;
+		for(uint i = 0; i < n; i++)
+		{
+			h ^= tuple[i];
+			h *= 16777619u;
+		}
+		
+		return h;
+	}
+	
+	pattern_set::pattern_set(std::initializer_list<std::string> res) noexcept
+	{
+		bool added = true;
+		for(const std::string& re : res)
+			added = add(re) != none and added;
+		
+		if(added == true)
+			compile();
+	}
+	
+	pattern_set::~pattern_set() noexcept
+	{
+		_release();
+		for(uint i = 0; i < _count; i++)
+			delete _dfas[i];
+	}
+	
+	void pattern_set::_release()
+	{
+		delete[] _table;
+		delete[] _accepts;
+		delete[] _winner;
+		_table = nullptr;
+		_accepts = nullptr;
+		_winner = nullptr;
+		_states = 0;
+		_classCount = 0;
+		_dead = _none;
+	}
+	
+	uint pattern_set::add(const std::string& re, const int& priority)
+	{
+		if(_count == max_patterns)
+		{
+			cerr << "pattern_set::add():  No more than " << max_patterns << " patterns." << endl;
+			return none;
+		}
+		
+		DFA* dfa = new DFA(re);
+		if(dfa->ready() == false)
+		{
+			cerr << "pattern_set::add():  Failed to compile " << re << "." << endl;
+			delete dfa;
+			return none;
+		}
+		
+		// The set has changed, so any compiled automaton is stale.
+		_release();
+		
+		_res[_count] = re;
+		_priority[_count] = priority;
+		_dfas[_count] = dfa;
+		
+		return _count++;
+	}
+	
+	bool pattern_set::compile()
+	{
+		_release();
+		
+		if(_count == 0)
+		{
+			cerr << "pattern_set::compile():  No patterns to compile." << endl;
+			return false;
+		}
+		
+		// Byte classes:  bytes in the same class of every pattern's DFA share a class.
+		const uint n = _count;
+		uchar representative[256];
+		for(uint b = 0; b < 256; b++)
+		{
+			uint c = 0;
+			for(; c < _classCount; c++)
+			{
+				uint k = 0;
+				while(k < n && _dfas[k]->_classes[b] == _dfas[k]->_classes[representative[c]])
+					k++;
+				
+				if(k == n)
+					break;
+			}
+			
+			if(c == _classCount)
+				representative[_classCount++] = b;
+			
+			_classes[b] = c;
+		}
+		
+		// The product, breadth first from the tuple of start states, which becomes state 0.
+		uint capacity = 64;
+		uint bucketCount = 2 * capacity;
+		uint* tuples = new uint[capacity * n];
+		uint* table = new uint[capacity * _classCount];
+		uint* buckets = new uint[bucketCount];
+		uint* target = new uint[n];
+		for(uint b = 0; b < bucketCount; b++)
+			buckets[b] = _none;
+		
+		for(uint k = 0; k < n; k++)
+			tuples[k] = _dfas[k]->_start;
+		
+		buckets[hashTuple(tuples, n) & (bucketCount - 1)] = 0;
+		uint count = 1;
+		
+		bool overflow = false;
+		for(uint s = 0; s < count && overflow == false; s++)
+		{
+			for(uint c = 0; c < _classCount; c++)
+			{
+				for(uint k = 0; k < n; k++)
+				{
+					const DFA& dfa = *_dfas[k];
+					target[k] = dfa._table[tuples[s*n + k] * dfa._classCount + dfa._classes[representative[c]]];
+				}
+				
+				uint mask = bucketCount - 1;
+				uint b = hashTuple(target, n) & mask;
+				uint t = _none;
+				for(; buckets[b] != _none; b = (b + 1) & mask)
+				{
+					uint k = 0;
+					const uint* other = tuples + buckets[b] * n;
+					while(k < n && other[k] == target[k])
+						k++;
+					
+					if(k == n)
+					{
+						t = buckets[b];
+						break;
+					}
+				}
+				
+				if(t == _none)
+				{
+					if(count == max_states)
+					{
+						cerr << "pattern_set::compile():  More than " << max_states << " states." << endl;
+						overflow = true;
+						break;
+					}
+					
+					if(count == capacity)
+					{
+						// Grow the tuples and the table, and rehash.
+						capacity *= 2;
+						uint* temp = new uint[capacity * n];
+						for(uint i = 0; i < count * n; i++)
+							temp[i] = tuples[i];
+						
+						delete[] tuples;
+						tuples = temp;
+						
+						temp = new uint[capacity * _classCount];
+						for(uint i = 0; i < count * _classCount; i++)
+							temp[i] = table[i];
+						
+						delete[] table;
+						table = temp;
+						
+						delete[] buckets;
+						bucketCount = 2 * capacity;
+						mask = bucketCount - 1;
+						buckets = new uint[bucketCount];
+						for(uint i = 0; i < bucketCount; i++)
+							buckets[i] = _none;
+						
+						for(uint u = 0; u < count; u++)
+						{
+							uint h = hashTuple(tuples + u * n, n) & mask;
+							while(buckets[h] != _none)
+								h = (h + 1) & mask;
+							
+							buckets[h] = u;
+						}
+						
+						b = hashTuple(target, n) & mask;
+						while(buckets[b] != _none)
+							b = (b + 1) & mask;
+					}
+					
+					t = count++;
+					for(uint k = 0; k < n; k++)
+						tuples[t*n + k] = target[k];
+					
+					buckets[b] = t;
+				}
+				
+				table[s * _classCount + c] = t;
+			}
+		}
+		
+		if(overflow == false)
+		{
+			_states = count;
+			_table = table;
+			_accepts = new ulong[count];
+			_winner = new uint[count];
+			for(uint s = 0; s < count; s++)
+			{
+				_accepts[s] = 0;
+				_winner[s] = _none;
+				
+				bool dead = true;
+				for(uint k = 0; k < n; k++)
+				{
+					uint q = tuples[s*n + k];
+					dead = dead and q == _dfas[k]->_dead;
+					if(_dfas[k]->_accepting[q] == false)
+						continue;
+					
+					_accepts[s] |= 1ul << k;
+					if(_winner[s] == _none or _priority[k] > _priority[_winner[s]])
+						_winner[s] = k;
+				}
+				
+				if(dead == true)
+					_dead = s;
+			}
+		}
+		else
+		{
+			delete[] table;
+			_classCount = 0;
+		}
+		
+		delete[] tuples;
+		delete[] buckets;
+		delete[] target;
+		
+		return _table != nullptr;
+	}
+	
+	template <typename Iterator>
+	uint pattern_set::_run(Iterator i, const Iterator& end) const
+	{
+		uint s = 0;
+		for(; i != end && s != _dead; i++)
+			s = _next(s, *i);
+		
+		return s;
+	}
+	
+	template <typename Iterator>
+	uint pattern_set::_longest(Iterator i, const Iterator& end, uint& length) const
+	{
+		length = 0;
+		if(_table == nullptr)
+			return none;
+		
+		// Read on until no pattern can match any longer, remembering the last state some pattern accepted in.
+		uint s = 0;
+		uint best = _winner[0];
+		for(uint pos = 1; i != end && s != _dead; i++, pos++)
+		{
+			s = _next(s, *i);
+			if(_winner[s] != _none)
+			{
+				best = _winner[s];
+				length = pos;
+			}
+		}
+		
+		return best;
+	}
+	
+	uint pattern_set::match(const std::string& text) const
+	{
+		return match(text.cbegin(), text.cend());
+	}
+	
+	uint pattern_set::match(const stci& begin, const stci& end) const
+	{
+		return _table != nullptr ? _winner[_run(begin, end)] : none;
+	}
+	
+	uint pattern_set::match(const lici& begin, const lici& end) const
+	{
+		return _table != nullptr ? _winner[_run(begin, end)] : none;
+	}
+	
+	ulong pattern_set::matches(const std::string& text) const
+	{
+		return matches(text.cbegin(), text.cend());
+	}
+	
+	ulong pattern_set::matches(const stci& begin, const stci& end) const
+	{
+		return _table != nullptr ? _accepts[_run(begin, end)] : 0;
+	}
+	
+	ulong pattern_set::matches(const lici& begin, const lici& end) const
+	{
+		return _table != nullptr ? _accepts[_run(begin, end)] : 0;
+	}
+	
+	uint pattern_set::longest(const std::string& text, uint& length) const
+	{
+		return _longest(text.cbegin(), text.cend(), length);
+	}
+	
+	uint pattern_set::longest(const stci& begin, const stci& end, uint& length) const
+	{
+		return _longest(begin, end, length);
+	}
+	
+	uint pattern_set::longest(const lici& begin, const lici& end, uint& length) const
+	{
+		return _longest(begin, end, length);
+	}
+}
@@ -0,0 +1,160 @@
+#include "pike_vm.h"
+
+namespace algorithms
+{
+	pike_vm::pike_vm(const nfa_program& program) noexcept
+	{
+		p_program = &program;
+		_M = program.accepting();
+		_groups = program.groups();
+		_width = 3 * _groups;
+		
+		uint V = _M + 1;
+		for(uint l = 0; l < 2; l++)
+		{
+			_states[l] = new uint[V];
+			_slots[l] = new uint[V * _width];
+			_inList[l].resize(V);
+		}
+		
+		_scratch = new uint[_width];
+		_captures = new uint[2 * _groups];
+		
+		// Each state is visited once per position, pushing a frame per ε-transition and at most two to restore.
+		_stack = new frame[3 * V + program.edgeStart()[V] + 1];
+	}
+	
+	pike_vm::~pike_vm() noexcept
+	{
+		for(uint l = 0; l < 2; l++)
+		{
+			delete[] _states[l];
+			delete[] _slots[l];
+		}
+		
+		delete[] _scratch;
+		delete[] _captures;
+		delete[] _stack;
+	}
+	
+	void pike_vm::_add(const uint& list, const uint& state, uint* slots, const uint& position, const uint& next)
+	{
+		// Add the threads at state and at every state ε-reachable from it, unless there already, in priority order:
+		// a depth first search, taking the ε-transitions of each state in order.  Those unable to read the next byte
+		// are visited, but keep no thread.  slots is restored on return.
+		const ulong* bytes = p_program->bytes();
+		const uint* edgeStart = p_program->edgeStart();
+		const uint* edges = p_program->edges();
+		const uint* captures = p_program->slots();
+		
+		uint depth = 0;
+		_stack[depth++] = {state, 0, 0};
+		while(depth > 0)
+		{
+			frame f = _stack[--depth];
+			if(f.v == _none)
+			{
+				slots[f.slot] = f.value;
+				continue;
+			}
+			
+			uint v = f.v;
+			if(_inList[list].test(v) == true)
+				continue;
+			
+			_inList[list].set(v);
+			uint slot = captures[v];
+			if(slot != _none)
+			{
+				uint k = slot >> 1;
+				uint pending = 2 * _groups + k;
+				if((slot & 1) == 0)
+				{
+					_stack[depth++] = {_none, pending, slots[pending]};
+					slots[pending] = position;
+				}
+				else
+				{
+					_stack[depth++] = {_none, 2*k, slots[2*k]};
+					_stack[depth++] = {_none, 2*k + 1, slots[2*k + 1]};
+					slots[2*k] = slots[pending];
+					slots[2*k + 1] = position;
+				}
+			}
+			
+			if(v == _M ? next == _end : next != _end && ((bytes[4*v + (next >> 6)] >> (next & 63)) & 1) != 0)
+			{
+				uint n = _count[list]++;
+				_states[list][n] = v;
+				uint* thread = _slots[list] + n * _width;
+				for(uint s = 0; s < _width; s++)
+					thread[s] = slots[s];
+			}
+			
+			// The first ε-transition on top, to be visited first.
+			for(uint e = edgeStart[v+1]; e-- > edgeStart[v];)
+				_stack[depth++] = {edges[e], 0, 0};
+		}
+	}
+	
+	template <typename Iterator>
+	bool pike_vm::_run(Iterator i, const Iterator& end)
+	{
+		uint current = 0;
+		_count[current] = 0;
+		_inList[current].clear();
+		for(uint s = 0; s < _width; s++)
+			_scratch[s] = _none;
+		
+		_add(current, 0, _scratch, 0, i != end ? (uchar)*i : _end);
+		
+		uint position = 0;
+		for(; i != end && _count[current] != 0; i++)
+		{
+			uint next = 1 - current;
+			_count[next] = 0;
+			_inList[next].clear();
+			position++;
+			
+			// Every thread here reads this byte.
+			Iterator j = i;
+			j++;
+			uint ahead = j != end ? (uchar)*j : _end;
+			for(uint t = 0; t < _count[current]; t++)
+			{
+				const uint* thread = _slots[current] + t * _width;
+				for(uint s = 0; s < _width; s++)
+					_scratch[s] = thread[s];
+				
+				_add(next, _states[current][t] + 1, _scratch, position, ahead);
+			}
+			
+			current = next;
+		}
+		
+		// At the end, the accepting state is the only thread left, if any.
+		if(i != end || _count[current] == 0)
+			return false;
+		
+		const uint* thread = _slots[current];
+		for(uint s = 0; s < 2 * _groups; s++)
+			_captures[s] = thread[s];
+		
+		return true;
+	}
+	
+	bool pike_vm::match(const std::string& text)
+	{
+		return _run(text.cbegin(), text.cend());
+	}
+	
+	bool pike_vm::match(const stci& begin, const stci& end)
+	{
+		return _run(begin, end);
+	}
+	
+	bool pike_vm::match(const lici& begin, const lici& end)
+	{
+		return _run(begin, end);
+	}
+}
@@ -0,0 +1,171 @@
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "prefilter.h"
+
+namespace algorithms
+{
+	prefilter::prefilter(directed_DFS_multi& closure, const digraph& g, const ulong* bytes, const uint& M) noexcept
+	{
+		const uint V = M + 1;
+		
+		// The leading class.
+		closure(0);
+		const visited_set& marked = closure.visited();
+		_nullable = marked.test(M);
+		for(uint v = marked.find_next_set(0); v < M; v = marked.find_next_set(v+1))
+			for(uint w = 0; w < 4; w++)
+				_first[w] |= bytes[4*v + w];
+		
+		for(uint w = 0; w < 4; w++)
+			_firstCount += __builtin_popcountl(_first[w]);
+		
+		if(_nullable == true)
+			return;
+		
+		for(uint c = 0; c < 256 && _rangeCount <= max_ranges; c++)
+		{
+			if(leads(c) == false || (c > 0 && leads(c-1) == true))
+				continue;
+			
+			uint end = c;
+			while(end < 255 && leads(end+1) == true)
+				end++;
+			
+			if(_rangeCount < max_ranges)
+			{
+				_low[_rangeCount] = c;
+				_width[_rangeCount] = end - c;
+			}
+			
+			_rangeCount++;
+		}
+		
+		// The required byte:  try the single byte states in order, whether M can be reached without their match transition.
+		uint* stack = new uint[V];
+		visited_set reached(V);
+		uint candidates = 0;
+		for(uint v = 0; v < M && candidates < max_candidates && _required == none; v++)
+		{
+			uint count = 0;
+			for(uint w = 0; w < 4; w++)
+				count += __builtin_popcountl(bytes[4*v + w]);
+			
+			if(count != 1)
+				continue;
+			
+			candidates++;
+			reached.clear();
+			reached.set(0);
+			uint depth = 0;
+			stack[depth++] = 0;
+			while(depth > 0 && reached.test(M) == false)
+			{
+				uint u = stack[--depth];
+				adj_citer begin, end, w;
+				g.adj(u, begin, end);
+				for(w = begin; w != end; w++)
+				{
+					if(reached.test(*w) == false)
+					{
+						reached.set(*w);
+						stack[depth++] = *w;
+					}
+				}
+				
+				bool matches = bytes[4*u] != 0 || bytes[4*u + 1] != 0 || bytes[4*u + 2] != 0 || bytes[4*u + 3] != 0;
+				if(u != v && u < M && matches == true && reached.test(u+1) == false)
+				{
+					reached.set(u+1);
+					stack[depth++] = u+1;
+				}
+			}
+			
+			if(reached.test(M) == false)
+			{
+				for(uint w = 0; w < 4; w++)
+					if(bytes[4*v + w] != 0)
+						_required = 64*w + __builtin_ctzl(bytes[4*v + w]);
+			}
+		}
+		
+		delete[] stack;
+	}
+	
+	bool prefilter::contains(const char* text, const ulong& n) const
+	{
+		return _required == none || (n > 0 && memchr(text, _required, n) != nullptr);
+	}
+	
+	bool prefilter::admits(const char* text, const ulong& n) const
+	{
+		if(_nullable == true)
+			return true;
+		
+		if(n == 0 || leads(text[0]) == false)
+			return false;
+		
+		return contains(text, n);
+	}
+	
+	ulong prefilter::skip(const char* text, const ulong& n) const
+	{
+		if(_nullable == true || _firstCount == 256)
+			return 0;
+		
+		return _scan(text, n);
+	}
+	
+	ulong prefilter::_scan(const char* text, const ulong& n) const
+	{
+		ulong i = 0;
+		
+		if(_rangeCount <= max_ranges)
+		{
+#if defined(__AVX2__)
+			// In range iff (c - low) <= width, unsigned:  min(c - low, width) == c - low.
+			for(; i + 32 <= n; i += 32)
+			{
+				__m256i block = _mm256_loadu_si256((const __m256i*)(text + i));
+				__m256i hits = _mm256_setzero_si256();
+				for(uint r = 0; r < _rangeCount; r++)
+				{
+					__m256i shifted = _mm256_sub_epi8(block, _mm256_set1_epi8(_low[r]));
+					__m256i inRange = _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, _mm256_set1_epi8(_width[r])), shifted);
+					hits = _mm256_or_si256(hits, inRange);
+				}
+				
+				uint mask = _mm256_movemask_epi8(hits);
+				if(mask != 0)
+					return i + __builtin_ctz(mask);
+			}
+#endif
+#if defined(__SSE2__)
+			for(; i + 16 <= n; i += 16)
+			{
+				__m128i block = _mm_loadu_si128((const __m128i*)(text + i));
+				__m128i hits = _mm_setzero_si128();
+				for(uint r = 0; r < _rangeCount; r++)
+				{
+					__m128i shifted = _mm_sub_epi8(block, _mm_set1_epi8(_low[r]));
+					__m128i inRange = _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8(_width[r])), shifted);
+					hits = _mm_or_si128(hits, inRange);
+				}
+				
+				uint mask = _mm_movemask_epi8(hits);
+				if(mask != 0)
+					return i + __builtin_ctz(mask);
+			}
+#endif
+		}
+		
+		for(; i < n; i++)
+			if(leads(text[i]) == true)
+				return i;
+		
+		return n;
+	}
+}
@@ -4,19 +4,10 @@ namespace algorithms
 {
 	readNumber::readNumber()
 	{
-		_dre = new NFA(_double_re);
-		_lre = new NFA(_long_re);
-		
-		p_digits = new char[doubleCharLength];
-		for(int i = 0; i < doubleCharLength; i++)
-			p_digits[i] = '\0';
 	}
 	
 	readNumber::~readNumber()
 	{
-		delete _dre;
-		delete _lre;
-		delete[] p_digits;
 	}
 	
 	readNumber::token readNumber::_getToken(const string& numstr)
@@ -25,54 +16,21 @@ namespace algorithms
 		// Tokens must start wither either the minus sign, or an digit character.
 		
 		tokenType = NONE;
-		c = numstr.cbegin();
+		if(_scanner(numstr.data(), numstr.data() + numstr.size()) == false)
+			return tokenType;
 		
-		switch(*c)
-		{
-			case '0' ... '9':
-			case '-':
-			{
-				if(_isIntToken(numstr) == true)
-					break;
-				if(_isRealToken(numstr) == true)
-					break;
-			}
-			default:
-				break;
-		}
+		// A double is a superset to an integer, so an integer must be all of the token, lest an integer be made from
+		// a partial double token.
+		if(_isIntToken(numstr) == false)
+			_isRealToken(numstr);
 		
 		return tokenType;
 	}
 	
 	bool readNumber::_isIntToken(const string& numstr)
 	{
-		tokenType = NONE;
-		
-		uint negative_sign = numstr[0] == '-' ? 1 : 0;
-		for(c = numstr.cbegin() + negative_sign; c != numstr.cend(); c++)
-		{
-			switch(*c)
-			{
-				case '0' ... '9':
-					break;
-				case '.':
-				case 'e':
-				case 'E':
-				{
-					// Flag for possible real.
-					tokenType = REAL;
-					goto EXIT;
-				}
-				default:
-					goto EXIT;
-			}
-		}
-		
-		EXIT:
-		
-		// A double is a superset to an integer, so we flagged REAL after any non-digit character acceptable by the double RE.  In doing so,
-		// we ensured that the token can be claimed as a double, instead of and incorrectly, an integer made from a partial double token.
-		if(tokenType != REAL and _lre->recognizes(numstr) == true)
+		// The whole of the token matching -?[[:digit:]]{1,20}.
+		if(_scanner.integer() == numstr.size() and _scanner.digits() <= longCharLength)
 		{
 			tokenType = NATURAL;
 			return true;
@@ -86,27 +44,8 @@ namespace algorithms
 	
 	bool readNumber::_isRealToken(const string& numstr)
 	{
-		tokenType = NONE;
-		
-		uint negative_sign = numstr[0] == '-' ? 1 : 0;
-		for(c = numstr.cbegin() + negative_sign; c != numstr.cend(); c++)
-		{
-			switch(*c)
-			{
-				case '0' ... '9':
-				case 'e':
-				case 'E':
-				case '.':
-				case '-':
-					break;
-				default:
-					goto EXIT;
-			}
-		}
-		
-		EXIT:
-		
-		if(_dre->recognizes(numstr) == true)
+		// The whole of the token matching -?[[:digit:]]+.?[[:digit:]]*((e|E)-?[[:digit:]]{1,3})?
+		if(_scanner.real() == numstr.size())
 		{
 			tokenType = REAL;
 			return true;
@@ -126,7 +65,7 @@ namespace algorithms
 			case NATURAL:
 				_setIntToken(numstr); break;
 			case REAL:
-				_setRealToken(numstr); break;
+				_setRealToken(); break;
 			default:
 				break;
 		}
@@ -134,37 +73,18 @@ namespace algorithms
 	
 	bool readNumber::_setIntToken(const string& numstr)
 	{
-		// Called internally to convert a token into an integer.  Note strtol produces a long.
-		errno = 0;
-		int i = 0;
+		// Called internally to convert a token into an integer, from the value the scanner accumulated.  As with
+		// strtol(), the value is a long, out of range an error.
+		long temp = 0;
 		
 		result.int64 = algorithms::undefined_long;
-		for(c = numstr.cbegin(); c < numstr.cend(); i++, c++)
-			p_digits[i] = *c;
-		p_digits[i] = '\0';
-		
-		long temp = strtol(p_digits, nullptr, base_10);
-		if(errno != 0)
+		if(_scanner.toLong(temp) == false)
 		{
-			_conversion_error = errno;
-			switch(_conversion_error)
-			{
-				case ERANGE:
-				{
-					// With ERANGE, we have either an overflow or underflow.  Note that LONG_MIN and LONG_MAX are 
-					// legitimate outside of ERANGE error.
-					if(temp == LONG_MIN)
-						cerr << "strtol():  underflow error occurred" << endl;
-					else
-						cerr << "strtol():  overflow error occurred" << endl;
-					
-					break;
-				}
-				case EINVAL:
-					cerr << "strtol():  invalid input" << endl;
-				default:
-					cerr << "strtol():  Unknown error " << _conversion_error << endl;
-			}
+			_conversion_error = ERANGE;
+			if(numstr[0] == '-')
+				cerr << "readNumber():  underflow error occurred" << endl;
+			else
+				cerr << "readNumber():  overflow error occurred" << endl;
 			
 			return false;
 		}
@@ -175,42 +95,20 @@ namespace algorithms
 		return true;
 	}
 	
-	bool readNumber::_setRealToken(const string& numstr)
+	bool readNumber::_setRealToken()
 	{
 		// Called internally to produce a double from a token.
 		double temp = 0;
-		errno = 0;
 		
-		int i = 0;
 		result.int64 = algorithms::undefined_int;
-		for(c = numstr.cbegin(); c < numstr.cend(); i++, c++)
-			p_digits[i] = *c;
-		p_digits[i] = '\0';
-		
-		temp = strtod(p_digits, nullptr);
-		if(errno != 0)
+		if(_scanner.toDouble(temp) == false)
 		{
-			_conversion_error = errno;
-			switch(_conversion_error)
-			{
-				case ERANGE:
-				{
-					// With ERANGE, we have either an overflow or underflow. 
-					if(temp == FLT_MIN || temp == DBL_MIN)
-						cerr << "strtod():  underflow error occurred" << endl;
-					else
-						cerr << "strtod():  overflow error occurred" << endl;
-					
-					break;
-				}
-				default:
-					cerr << "strtod():  Unknown error " << _conversion_error << endl;
-			}
+			_conversion_error = ERANGE;
+			cerr << "readNumber():  real out of range" << endl;
 			
 			return false;
 		}
 		
-		
 		tokenType = DOUBLE;
 		result.real64 = temp;
 		
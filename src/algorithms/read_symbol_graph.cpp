@@ -7,7 +7,7 @@ namespace algorithms
 		if(_initialized == false)
 			return "";
 		else
-			return p_keys->get(v);
+			return p_st->key(v);
 	}
 	
 	graphs::graph read_symbol_graph::G() const
@@ -55,11 +55,9 @@ namespace algorithms
 		_allocated = false;
 		
 		delete p_g;
-		delete p_keys;
 		delete p_st;
 		
 		p_g = nullptr;
-		p_keys = nullptr;
 		p_st = nullptr;
 	}
 	
@@ -72,9 +70,9 @@ namespace algorithms
 	void read_symbol_graph::_readfile_str(const std::string& filename, const char& delim)
 	{
 		/* Initialize our graph object:
-		 * 		1)	Read string symbols and place them in the symbol table, facilitating the string -> index mapping.
-		 * 		2)	Using the symbol table, initialize the keys array to facilitate the index -> string mapping.
-		 * 		3)	With the bi-directional mapping available, fill the graph object with edges, and implicit vertices.
+		 * 		1)	Read string symbols and intern them in the symbol table, in the order first read, facilitating the
+		 * 			string -> index mapping, and by key() the index -> string mapping.
+		 * 		2)	With the bi-directional mapping available, fill the graph object with edges, and implicit vertices.
 		 */
 	
 		using namespace graphs;
@@ -120,36 +118,16 @@ namespace algorithms
 		FINISHED_FILE:
 		
 		if(_DEBUG)
-			cout << "Completed filling the symbol table with " << token_count << " entries:" << endl;
-		
-		// Now that we know the size of the symbol table, allocate and populate the keys array.  Note
-		// that for graph purposes, this is not needed, except in our str() function.  All graph
-		// processing is based on uint values in the graph class, and nothing more.
-		token_count = 0;
-		p_keys = new values(st.size());
-		values& keys = *p_keys;
-
-		for(symbols_iter name = st.begin(); name != st.end(); name++)
 		{
-			int value = st.get(*name);
-			if(_DEBUG)
-				cout << "\t" << *name << " -> " << value << endl;
+			cout << "Completed filling the symbol table with " << token_count << " entries:" << endl;
+			for(uint i = 0; i < st.size(); i++)
+				cout << "\t" << i << ":  " << st.key(i) << endl;
 			
-			keys.get(value) = *name;
-			token_count++;
+			cout << endl;
 		}
 		
 		_V = st.size();
 		
-		if(_DEBUG)
-		{
-			cout << endl << "Completed populating the keys array, with " << token_count << " entries:" << endl;
-			for(int i = 0; i < keys.size(); i++)
-				cout << "\t" << i << ":  " << keys.get(i) << endl;
-			
-			cout << endl;
-		}
-
 		// and allocate the graph object.
 		if(_useDigraph == true)
 			p_g = new digraph(st.size());
@@ -241,19 +219,26 @@ namespace algorithms
 		symbols& st = *p_st;
 		string indentation = "     ";
 		
-		values& keys = *p_keys;
+		// List the vertices by name, in order, as they are numbered in the order they were read.
+		uint* order = new uint[st.size()];
+		for(uint v = 0; v < st.size(); v++)
+			order[v] = v;
+		
+		std::sort(order, order + st.size(), [&st](const uint& a, const uint& b) { return st.key(a) < st.key(b); });
+		
 		adj_citer begin, end;
-		for(symbols_citer name = st.cbegin(); name != st.cend(); name++)
+		for(uint i = 0; i < st.size(); i++)
 		{
-			o << indentation << *name << ":" << endl << "\t";
-			int value = st.get(*name);
-			p_g->adj(value, begin, end);
+			o << indentation << st.key(order[i]) << ":" << endl << "\t";
+			p_g->adj(order[i], begin, end);
 			for(adj_citer it = begin; it != end; it++)
-				o << keys.get(*it) << " -> ";
+				o << st.key(*it) << " -> ";
 
 			o << endl;
 		}
 		
+		delete[] order;
+		
 		return o.str();
 	}
 }
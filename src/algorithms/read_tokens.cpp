@@ -2,232 +2,92 @@
 
 namespace algorithms
 {
-	const string read_tokens::_double_re = "(-?[[:digit:]]+.?[[:digit:]]*((e|E)-?[[:digit:]]{1,3})?)";
-	const string read_tokens::_integer_re = "(-?[[:digit:]]+)";
-	const string read_tokens::_operator_re = "(->)";
-	const int read_tokens::_operator_re_size = _operator_re.size() - 2;
-	
-	read_tokens::read_tokens(const string& filename, const char& delimiter)
+	read_tokens::read_tokens(const string& filename, const char& delimiter, const bool& streaming)
 	{
 		if(delimiter != 0)
 			this->delimiters.push_back(delimiter);
 		
 		_initialize();
+		if(streaming == true)
+			_file_read_result = p_fileinput->stream(filename) ? 0 : -1;
+		else
+			_file_read_result = p_fileinput->map(filename) ? 0 : -1;
 		
 		if(_DEBUG)
 			printfile();
 		
-		_file_read_result = (*p_fileinput)(filename, *p_lines);
-		p_lines->get_citers(file_begin, file_end);
-		
-		_dre = new NFA(_double_re);
-		_ire = new NFA(_integer_re);
-		_ore = new NFA(_operator_re);
-		if(_dre->ready() == false or _ire->ready() == false or _ore->ready() == false)
-			cerr << "read_tokens():  Failed to initialize one or more of the NFAs." << endl;
-		else
-			_re_initialized = true;
+		reset();
 	}
 	
-	read_tokens::read_tokens(const string& filename, const string& delimiters)
+	read_tokens::read_tokens(const string& filename, const string& delimiters, const bool& streaming)
 	{
 		if(delimiters.length() != 0)
 			this->delimiters += delimiters;
 		
 		_initialize();
-		_file_read_result = (*p_fileinput)(filename, *p_lines);
+		if(streaming == true)
+			_file_read_result = p_fileinput->stream(filename) ? 0 : -1;
+		else
+			_file_read_result = p_fileinput->map(filename) ? 0 : -1;
 		
 		if(_DEBUG)
 			printfile();
 		
-		p_lines->get_citers(file_begin, file_end);
-		
-		_dre = new NFA(_double_re);
-		_ire = new NFA(_integer_re);
-		_ore = new NFA(_operator_re);
-		if(_dre->ready() == false or _ire->ready() == false or _ore->ready() == false)
-			cerr << "read_tokens():  Failed to initialize one or more of the NFAs." << endl;
-		else
-			_re_initialized = true;
+		reset();
 	}
 	
 	read_tokens::~read_tokens()
 	{
 		delete _result_str;
-		delete[] p_digits;
 		delete p_fileinput;
-		delete p_lines;
+		delete p_delimiters;
+		delete[] _masks;
 		delete _result_operator;
-		delete _dre;
-		delete _ire;
-		delete _ore;
 	}
 	
 	void read_tokens::_initialize()
 	{
-		// As doubleCharLength > intCharLength, use it for intergers as well.
-		p_digits = new char[doubleCharLength];
-		for(int i = 0; i < doubleCharLength; i++)
-			p_digits[i] = '\0';
-		
 		_result_str = new string {};
 		_result_operator = new string {};
-		p_lines = new arli;
 		p_fileinput = new algorithms::file_input();
-	}
-	
-	void read_tokens::reset()
-	{
-		 _previous_line = 0;
-		 _previous_char = 0;
-		 result = NONE;
-		 _EOL = false;
-		 _EOF = false;
-		 p_lines->get_citers(file_begin, file_end);
-		 current_line = file_begin;
-	}
-	
-	bool read_tokens::_isOperatorToken(li_citer tokenStart, li_citer& tokenEnd, const li_citer& lineEnd)
-	{
-		if(_EOF == true)
-			return false;
+		p_delimiters = new structural_index(delimiters);
 		
-		result = NONE;
-		li_citer c = tokenStart;
-			
-		if(c+_operator_re_size == lineEnd)		// We need 2 characters for "->"
-		{
-			tokenEnd = tokenStart;
-			result = NONE;
-			return false;
-		}
-		else if(_ore->recognizes(tokenStart, tokenStart + _operator_re_size) == true)
-		{
-			tokenEnd = tokenStart + _operator_re_size;
-			result = OPERATOR;
-			return true;
-		}
-		else
-		{
-			tokenEnd = tokenStart;
-			result = NONE;
-			return false;
-		}
+		_maskWords = 4;
+		_masks = new ulong[_maskWords];
 	}
 	
-	bool read_tokens::_isIntToken(li_citer tokenStart, li_citer& tokenEnd, const li_citer& lineEnd)
+	void read_tokens::_index_line()
 	{
-		if(_EOF == true)
-			return false;
-		
-		result = NONE;
-		
-		uint negative_sign = *tokenStart == '-' ? 1 : 0;
-		int charcount = negative_sign;
-		for(li_citer l = tokenStart + negative_sign; l != lineEnd; l++)
+		ulong words = (_line.length + 63) / 64;
+		if(words > _maskWords)
 		{
-			switch(*l)
-			{
-				case '0' ... '9':
-				{
-					charcount++; break;
-				}
-				case '.':
-				case 'e':
-				case 'E':
-				{
-					// Flag for possible real.
-					result = REAL;
-					charcount++;
-					goto EXIT;
-				}
-				default:
-					goto EXIT;
-			}
+			delete[] _masks;
+			_maskWords = words > 2 * _maskWords ? words : 2 * _maskWords;
+			_masks = new ulong[_maskWords];
 		}
 		
-		EXIT:
-		
-		// A double is a superset to an integer, so we flagged REAL after any non-digit character acceptable by the double RE.  In doing so,
-		// we ensured that the token can be claimed as a double, instead of and incorrectly, an integer made from a partial double token.
-		if(result != REAL and _ire->recognizes(tokenStart, tokenStart+charcount) == true)
-		{
-			result = INT;
-			tokenEnd = tokenStart + charcount;
-			return true;
-		}
-		else
-		{
-			tokenEnd = tokenStart;
-			result = NONE;
-			return false;
-		}
+		p_delimiters->index(_line.data, _line.length, _masks);
 	}
 	
-	bool read_tokens::_isRealToken(li_citer tokenStart, li_citer& tokenEnd, const li_citer& lineEnd)
+	void read_tokens::reset()
 	{
-		if(_EOF == true)
-			return false;
-		
-		result = NONE;
-		
-		uint negative_sign = *tokenStart == '-' ? 1 : 0;
-		int charcount = negative_sign;
-		for(li_citer l = tokenStart + negative_sign; l != lineEnd; l++)
-		{
-			switch(*l)
-			{
-				case '0' ... '9':
-				case 'e':
-				case 'E':
-				case '.':
-				case '-':
-				{
-					charcount++; break;
-				}
-				default:
-					goto EXIT;
-			}
-		}
-		
-		EXIT:
-		
-		if(_dre->recognizes(tokenStart, tokenStart+charcount) == true)
-		{
-			result = REAL;
-			tokenEnd = tokenStart + charcount;
-			return true;
-		}
-		else
-		{
-			tokenEnd = tokenStart;
-			result = NONE;
-			return false;
-		}
+		 _previous_line = 0;
+		 _previous_char = 0;
+		 result = NONE;
+		 _EOL = false;
+		 _line = {};
+		 p_fileinput->rewind();
+		 _EOF = p_fileinput->more() == false;
 	}
 	
-	bool read_tokens::_isStrToken(li_citer tokenStart, li_citer& tokenEnd, const li_citer& lineEnd)
+	bool read_tokens::_isStrToken(li_citer tokenStart, li_citer& tokenEnd)
 	{
 		if(_EOF == true)
 			return false;
 		
 		// The default token type.  Therefore, use as last test case.  Break on delimiters.
 		result = STRING;
-		char c = 0;
-		int charcount = 0;
-		
-		for(li_citer l = tokenStart; l != lineEnd; l++)
-		{
-			c = *l;
-			if(isDelim(c) == true)
-				goto EXIT;
-			
-			charcount++;
-		}
-		
-		EXIT:
-		
-		tokenEnd = tokenStart + charcount;
+		tokenEnd = lbegin + structural_index::next(_masks, tokenStart - lbegin, _line.length);
 		
 		return true;
 	}
@@ -243,42 +103,41 @@ namespace algorithms
 		if(_EOF == true)
 			return NONE;
 		
-		result = NONE;
-		li_citer c;
-
-		for(c = tokenStart; c != lineEnd; c++)
+		// One pass over the token for both numbers, the scanner keeping the value for _setToken().  An integer is taken
+		// unless a '.', 'e' or 'E' follows it, as the token may then be a real, and a real only if it spans the whole
+		// run of the characters a real is made of.  Else, the token is a string:  "1.5.3" or "1e1234" is not split.
+		if(_scanner(&*tokenStart, &*lineEnd) == true)
 		{
-			switch(*c)
+			li_citer next = tokenStart + _scanner.integer();
+			if(next == lineEnd || (*next != '.' && *next != 'e' && *next != 'E'))
+			{
+				result = INT;
+				tokenEnd = next;
+				return result;
+			}
+			
+			li_citer run = tokenStart + (*tokenStart == '-' ? 1 : 0);
+			while(run != lineEnd && (isDigit(*run) == true || *run == '.' || *run == 'e' || *run == 'E' || *run == '-'))
+				run++;
+			
+			if(tokenStart + _scanner.real() == run)
 			{
-				case '0' ... '9':
-				{
-					if(_isIntToken(tokenStart, tokenEnd, lineEnd) == true)
-						return result;
-					if(_isRealToken(tokenStart, tokenEnd, lineEnd) == true)
-						return result;
-				}
-				case '-':
-				{
-					if(_isIntToken(tokenStart, tokenEnd, lineEnd) == true)
-						return result;
-					if(_isRealToken(tokenStart, tokenEnd, lineEnd) == true)
-						return result;
-					if(_isOperatorToken(tokenStart, tokenEnd, lineEnd) == true)
-						return result;
-				}
-				default:
-				{
-					if(_isStrToken(tokenStart, tokenEnd, lineEnd) == true)
-						return result;
-				}
+				result = REAL;
+				tokenEnd = run;
+				return result;
 			}
 		}
 		
-		tokenEnd = c;
+		if(tokenStart[0] == '-' && tokenStart + 1 != lineEnd && tokenStart[1] == '>')
+		{
+			result = OPERATOR;
+			tokenEnd = tokenStart + 2;
+			return result;
+		}
+		
+		// If none, we must by default have a string.
 		
-		// We must by default have a string.
-		if(result == NONE)
-			result = STRING;
+		_isStrToken(tokenStart, tokenEnd);
 		
 		return result;
 	}
@@ -301,40 +160,20 @@ namespace algorithms
 		}
 	}
 	
-	bool read_tokens::_set_int_token(li_citer begin, li_citer end)
+	bool read_tokens::_set_int_token(li_citer begin, li_citer)
 	{
-		// Called internally to convert a token into an integer.  Note strtol produces a long.
-		errno = 0;
-		int i = 0;
+		// Called internally to convert a token into an integer, from the value the scanner accumulated.  As with
+		// strtol(), the value is a long, out of range an error.
+		long temp = 0;
 		
 		_result_int = algorithms::undefined_int;
-		for(li_citer c = begin; c < end; i++, c++)
-			p_digits[i] = *c;
-		p_digits[i] = '\0';
-		
-		long temp = strtol(p_digits, &endptr, base_10);
-		if(errno != 0)
+		if(_scanner.toLong(temp) == false)
 		{
-			_conversion_error = errno;
-			switch(_conversion_error)
-			{
-				case ERANGE:
-				{
-					// With ERANGE, we have either an overflow or underflow.  Note that LONG_MIN and LONG_MAX are 
-					// legitimate outside of ERANGE error.
-					
-					if(temp == LONG_MIN)
-						cerr << "strtol():  underflow error occurred" << endl;
-					else
-						cerr << "strtol():  overflow error occurred" << endl;
-					
-					break;
-				}
-				case EINVAL:
-					cerr << "strtol():  invalid input" << endl;
-				default:
-					cerr << "strtol():  Unknown error " << _conversion_error << endl;
-			}
+			_conversion_error = ERANGE;
+			if(*begin == '-')
+				cerr << "read_tokens():  integer underflow error occurred" << endl;
+			else
+				cerr << "read_tokens():  integer overflow error occurred" << endl;
 			
 			return false;
 		}
@@ -344,38 +183,16 @@ namespace algorithms
 		return true;
 	}
 	
-	bool read_tokens::_set_real_token(li_citer begin, li_citer end)
+	bool read_tokens::_set_real_token(li_citer, li_citer)
 	{
 		// Called internally to produce a double from a token.
 		double temp = 0;
-		errno = 0;
 		
-		int i = 0;
 		_result_int = algorithms::undefined_int;
-		for(li_citer c = begin; c < end; i++, c++)
-			p_digits[i] = *c;
-		p_digits[i] = '\0';
-		
-		temp = strtod(p_digits, &endptr);
-		if(errno != 0)
+		if(_scanner.toDouble(temp) == false)
 		{
-			_conversion_error = errno;
-			switch(_conversion_error)
-			{
-				case ERANGE:
-				{
-					// With ERANGE, we have either an overflow or underflow. 
-					
-					if(temp == FLT_MIN || temp == DBL_MIN)
-						cerr << "strtod():  underflow error occurred" << endl;
-					else
-						cerr << "strtod():  overflow error occurred" << endl;
-					
-					break;
-				}
-				default:
-					cerr << "strtod():  Unknown error " << _conversion_error << endl;
-			}
+			_conversion_error = ERANGE;
+			cerr << "read_tokens():  real out of range" << endl;
 			
 			return false;
 		}
@@ -395,7 +212,7 @@ namespace algorithms
 		return true;
 	}
 	
-	bool read_tokens::_set_op_token(li_citer begin, li_citer end) 
+	bool read_tokens::_set_op_token(li_citer begin, li_citer)
 	{
 		// Called internally to produce an operator (for now just arrow) from a token.
 		*_result_operator = "";
@@ -407,50 +224,57 @@ namespace algorithms
 	
 	read_tokens::tokenType read_tokens::nextToken()
 	{
-		for(current_line = file_begin + _previous_line; current_line != file_end; current_line++)
+		// At the start of a line, fetch the next one.  Within one, the view is still that of the line.
+		while(_previous_char != 0 || p_fileinput->next_line(_line) == true)
 		{
+			if(_previous_char == 0)
+				_index_line();
+			
 			_EOL = false;
 			result = NONE;
-			current_line->get_citers(lbegin, lend);
+			_line.get_citers(lbegin, lend);
+			
+			// Skip any leading delimiters.
+			_previous_char = structural_index::next_clear(_masks, _previous_char, _line.length);
 			c = lbegin + _previous_char;
-			while(c != lend)
+			
+			// Nothing but delimiters left on the line, if anything:  try the next one.
+			if(c == lend)
 			{
-				// Skip any leading delimiters.
-				while(c != lend && isDelim(*c) == true )
-				{
-					_previous_char++;
-					c++;
-				}
-				
-				tokenStart = c;
-				result = _nextToken(tokenStart, tokenEnd, lend);
-				_setToken(tokenStart, tokenEnd);
-				_previous_char += tokenEnd - tokenStart;
-				c = tokenEnd;
-				
-				// Skip any trailing delimiters.
-				while(c != lend && isDelim(*c) == true )
-				{
-					_previous_char++;
-					c++;
-				}
+				_previous_line++;
+				_previous_char = 0;
+				continue;
+			}
+			
+			tokenStart = c;
+			result = _nextToken(tokenStart, tokenEnd, lend);
+			_setToken(tokenStart, tokenEnd);
+			_previous_char += tokenEnd - tokenStart;
+			
+			// Skip any trailing delimiters.
+			_previous_char = structural_index::next_clear(_masks, _previous_char, _line.length);
+			c = lbegin + _previous_char;
+			
+			// We're leaving, but set up for next iteration, and test for EOL and EOF.
+			if(c == lend)
+			{
+				_EOL = true;
+				_previous_line++;
+				_previous_char = 0;
 				
-				goto RETURN_TOKEN;
+				// The token is set, so the line may go, if the next has to be read in.
+				if(p_fileinput->more() == false)
+					_EOF = true;
 			}
-		}
-		
-		RETURN_TOKEN:
-		// We're leaving, but set up for next iteration, and test for EOL and EOF.
-		if(c == lend)
-		{
-			_EOL = true;
-			_previous_line++;
-			_previous_char = 0;
 			
-			if(file_begin + _previous_line == file_end)
-				_EOF = true;
+			return result;
 		}
-
+		
+		// Only delimiters and empty lines were left.
+		_EOL = true;
+		_EOF = true;
+		result = EOFTOKEN;
+		
 		return result;
 	}
 	
@@ -507,21 +331,22 @@ namespace algorithms
 	
 	void read_tokens::printfile() const
 	{
+		// Goes through the file, thus starts parsing over, as does reset().
 		using namespace std;
 		
-		containers::array<algorithms::line>::const_iterator a_iter;
-		algorithms::line::const_iterator l_it;
+		line_view view;
 		
 		int linecount = 0;
-		for(a_iter = p_lines->cbegin(); a_iter != p_lines->cend(); a_iter++)
+		p_fileinput->rewind();
+		while(p_fileinput->next_line(view) == true)
 		{
 			cout << "line " << linecount << ":  ";
-			for(l_it = a_iter->cbegin(); l_it != a_iter->cend(); l_it++)
-				cout << *l_it;
-			
+			cout.write(view.data, view.length);
 			cout << endl;
 			linecount++;
 		}
+		
+		p_fileinput->rewind();
 	}
 	
 	bool read_tokens::isDigit(const char& c) const
@@ -543,13 +368,6 @@ namespace algorithms
 	
 	bool read_tokens::isDelim(const char& c) const
 	{
-		bool result = false;
-		for(int i = 0; i < delimiters.length(); i++)
-		{
-			if(c == delimiters[i])
-				return true;
-		}
-		
-		return result;
+		return p_delimiters->is(c);
 	}
 }
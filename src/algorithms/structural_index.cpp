@@ -0,0 +1,116 @@
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "structural_index.h"
+
+namespace algorithms
+{
+	structural_index::structural_index(const std::string& delimiters) noexcept
+	{
+		for(uint i = 0; i < delimiters.length(); i++)
+		{
+			uchar c = delimiters[i];
+			if(is(c) == false)
+			{
+				if(_count < max_delimiters)
+					_delimiters[_count] = c;
+				
+				_table[c >> 6] |= 1ul << (c & 63);
+				_count++;
+			}
+		}
+	}
+	
+	ulong structural_index::block(const char* text) const
+	{
+		// 64 bytes, all of which must be readable.
+		ulong mask = 0;
+		
+		if(_count <= max_delimiters)
+		{
+#if defined(__AVX2__)
+			__m256i low = _mm256_loadu_si256((const __m256i*)text);
+			__m256i high = _mm256_loadu_si256((const __m256i*)(text + 32));
+			__m256i hitsLow = _mm256_setzero_si256();
+			__m256i hitsHigh = _mm256_setzero_si256();
+			for(uint d = 0; d < _count; d++)
+			{
+				__m256i delimiter = _mm256_set1_epi8(_delimiters[d]);
+				hitsLow = _mm256_or_si256(hitsLow, _mm256_cmpeq_epi8(low, delimiter));
+				hitsHigh = _mm256_or_si256(hitsHigh, _mm256_cmpeq_epi8(high, delimiter));
+			}
+			
+			return (ulong)(uint)_mm256_movemask_epi8(hitsLow) | ((ulong)(uint)_mm256_movemask_epi8(hitsHigh) << 32);
+#elif defined(__SSE2__)
+			for(uint q = 0; q < 4; q++)
+			{
+				__m128i bytes = _mm_loadu_si128((const __m128i*)(text + 16*q));
+				__m128i hits = _mm_setzero_si128();
+				for(uint d = 0; d < _count; d++)
+					hits = _mm_or_si128(hits, _mm_cmpeq_epi8(bytes, _mm_set1_epi8(_delimiters[d])));
+				
+				mask |= (ulong)(uint)_mm_movemask_epi8(hits) << (16*q);
+			}
+			
+			return mask;
+#endif
+		}
+		
+		for(uint i = 0; i < 64; i++)
+			mask |= (ulong)is(text[i]) << i;
+		
+		return mask;
+	}
+	
+	void structural_index::index(const char* text, const ulong& n, ulong* masks) const
+	{
+		ulong full = n / 64;
+		for(ulong w = 0; w < full; w++)
+			masks[w] = block(text + 64*w);
+		
+		// The tail is copied into a block of its own, rather than read past the end of the text, and the bits past
+		// the end cleared, lest a padding byte be taken for a delimiter.
+		ulong tail = n % 64;
+		if(tail != 0)
+		{
+			char padded[64] = {0};
+			memcpy(padded, text + 64*full, tail);
+			masks[full] = block(padded) & ((1ul << tail) - 1);
+		}
+	}
+	
+	ulong structural_index::next(const ulong* masks, const ulong& from, const ulong& n)
+	{
+		// The first set bit in [from, n), or n if none.
+		for(ulong w = from >> 6, i = from; i < n; w++, i = w << 6)
+		{
+			ulong bits = masks[w] & (~0ul << (i & 63));
+			if(bits != 0)
+			{
+				ulong found = (w << 6) + __builtin_ctzl(bits);
+				return found < n ? found : n;
+			}
+		}
+		
+		return n;
+	}
+	
+	ulong structural_index::next_clear(const ulong* masks, const ulong& from, const ulong& n)
+	{
+		// The first clear bit in [from, n), or n if none.
+		for(ulong w = from >> 6, i = from; i < n; w++, i = w << 6)
+		{
+			ulong bits = ~masks[w] & (~0ul << (i & 63));
+			if(bits != 0)
+			{
+				ulong found = (w << 6) + __builtin_ctzl(bits);
+				return found < n ? found : n;
+			}
+		}
+		
+		return n;
+	}
+}
@@ -2,24 +2,26 @@
 
 namespace algorithms
 {
-	weighted_union_find::weighted_union_find(const uint& N) noexcept
+	template <typename Index>
+	basic_weighted_union_find<Index>::basic_weighted_union_find(const Index& N) noexcept
 	{
 		// At initialiation, every element is in its own component.  Thus _count == _size == N.
 		_count = N;
 		_size = _count;
-		_id = new uint[_size];
-		_component_size = new uint[_size];
+		_id = new Index[_size];
+		_component_size = new Index[_size];
 		
-		for(int i = 0; i < _size; i++)
+		for(Index i = 0; i < _size; i++)
 		{
 			_id[i] = i;
 			_component_size[i] = 1;
 		}
 	}
 	
-	uint weighted_union_find::find(const uint& q) const
+	template <typename Index>
+	Index basic_weighted_union_find<Index>::find(const Index& q) const
 	{
-		uint p = q;
+		Index p = q;
 		
 		// Follow links to find root.
 		while(p != _id[p])
@@ -28,10 +30,49 @@ namespace algorithms
 		return p;
 	}
 	
-	void weighted_union_find::formUnion(const uint& p, const uint& q)
+	template <typename Index>
+	Index basic_weighted_union_find<Index>::find(const Index& q)
 	{
-		uint i = find(p);
-		uint j = find(q);
+		Index p = q;
+		
+		// Follow links to find root, shortening the path as we go.  Both variants are one pass, and
+		// keep the component sizes of the roots valid, as only non-root links are modified.
+		switch(_compression)
+		{
+			case HALVING:
+			{
+				while(p != _id[p])
+				{
+					_id[p] = _id[_id[p]];
+					p = _id[p];
+				}
+				break;
+			}
+			case SPLITTING:
+			{
+				while(p != _id[p])
+				{
+					Index next = _id[p];
+					_id[p] = _id[next];
+					p = next;
+				}
+				break;
+			}
+			default:
+			{
+				while(p != _id[p])
+					p = _id[p];
+			}
+		}
+		
+		return p;
+	}
+	
+	template <typename Index>
+	void basic_weighted_union_find<Index>::formUnion(const Index& p, const Index& q)
+	{
+		Index i = find(p);
+		Index j = find(q);
 		if(i == j)
 			return;
 		
@@ -49,4 +90,78 @@ namespace algorithms
 		
 		_count--;
 	}
+	
+	template <typename Index>
+	void basic_weighted_union_find<Index>::_prefetch(const site_pair* pairs, const Index& n) const
+	{
+		// Issue the loads of the first two links of each parent chain for the whole block.  The
+		// first loop only touches the sites, so its misses overlap.  The second then reads the
+		// (by now mostly cached) parents, and prefetches the grandparents.
+		for(Index k = 0; k < n; k++)
+		{
+			__builtin_prefetch(&_id[pairs[k].p]);
+			__builtin_prefetch(&_id[pairs[k].q]);
+		}
+		
+		for(Index k = 0; k < n; k++)
+		{
+			__builtin_prefetch(&_id[_id[pairs[k].p]]);
+			__builtin_prefetch(&_id[_id[pairs[k].q]]);
+		}
+	}
+	
+	template <typename Index>
+	void basic_weighted_union_find<Index>::formUnions(const site_pair* pairs, const Index& n)
+	{
+		for(Index begin = 0; begin < n; begin += _block_size)
+		{
+			Index length = n - begin < _block_size ? n - begin : _block_size;
+			_prefetch(pairs + begin, length);
+			
+			for(Index k = begin; k < begin + length; k++)
+				formUnion(pairs[k].p, pairs[k].q);
+		}
+	}
+	
+	template <typename Index>
+	void basic_weighted_union_find<Index>::connectedBatch(const site_pair* pairs, const Index& n, bool* result)
+	{
+		for(Index begin = 0; begin < n; begin += _block_size)
+		{
+			Index length = n - begin < _block_size ? n - begin : _block_size;
+			_prefetch(pairs + begin, length);
+			
+			for(Index k = begin; k < begin + length; k++)
+				result[k] = connected(pairs[k].p, pairs[k].q);
+		}
+	}
+	
+	template <typename Index>
+	const Index* basic_weighted_union_find<Index>::components()
+	{
+		const Index unlabeled = _size;
+		
+		if(_labels == nullptr)
+			_labels = new Index[_size];
+		
+		for(Index i = 0; i < _size; i++)
+			_labels[i] = unlabeled;
+		
+		// A component gets its label when its lowest site is reached.  Writing to a site that is not
+		// yet visited is only ever done for a root, and then with the label it would get anyway.
+		Index next = 0;
+		for(Index i = 0; i < _size; i++)
+		{
+			Index root = find(i);
+			if(_labels[root] == unlabeled)
+				_labels[root] = next++;
+			
+			_labels[i] = _labels[root];
+		}
+		
+		return _labels;
+	}
+	
+	template class basic_weighted_union_find<uint>;
+	template class basic_weighted_union_find<ulong>;
 }
@@ -4,45 +4,51 @@ namespace graphs
 {
 	acyclic_SP::acyclic_SP(const edge_weighted_digraph& g, const uint& s)
 	{
-		uint V = g.V();
-		_initialize(V);
-			
-		topological top(g);
-		path order = top.order();
+		p_workspace = new acyclic_workspace;
+		_ownsWorkspace = true;
 		
-		_distTo[s] = 0.0;
-		path_citer begin, end, v;
-		order.get_citers(begin, end);
-		for(v = begin; v != end; v++)
-			relax(g, *v);
+		(*this)(g, s);
 	}
 	
-	void acyclic_SP::_initialize(const uint& V)
+	acyclic_SP::acyclic_SP(const edge_weighted_digraph& g, const uint& s, acyclic_workspace& workspace)
 	{
-		if(_distTo != nullptr)
-			delete[] _distTo;
-		if(_edgeTo != nullptr)
-			delete[] _edgeTo;
+		p_workspace = &workspace;
 		
-		_distTo = new double[V];
-		_edgeTo = new edge[V];
-		
-		for(int i = 0; i < V; i++)
-			_distTo[i] = inf;
+		(*this)(g, s);
 	}
 	
-	void acyclic_SP::operator()(const edge_weighted_digraph& g, const uint& s)
+	acyclic_SP::acyclic_SP(acyclic_workspace& workspace)
+	{
+		p_workspace = &workspace;
+	}
+	
+	void acyclic_SP::_initialize(const edge_weighted_digraph& g, const uint& s)
 	{
+		// The arrays are grown by the workspace only, and reset here for every querry.  Resetting
+		// _edgeTo[] matters, as getPathTo() relies on _edgeTo[s] being invalid to stop.
 		uint V = g.V();
-		_initialize(V);
+		p_workspace->reserve(V);
+		_distTo = p_workspace->distTo();
+		_edgeTo = p_workspace->edgeTo();
 		
-		topological top(g);
-		path order = top.order();
+		for(uint i = 0; i < V; i++)
+		{
+			_distTo[i] = inf;
+			_edgeTo[i] = edge();
+		}
 		
 		_distTo[s] = 0.0;
-		path_citer begin, end, v;
-		order.get_citers(begin, end);
-		for(v = begin; v != end; v++)
+	}
+	
+	void acyclic_SP::operator()(const edge_weighted_digraph& g, const uint& s)
+	{
+		_initialize(g, s);
+		
+		// The topological order is only recomputed if g changed since the workspace last saw it.
+		const uint* begin = nullptr;
+		const uint* end = nullptr;
+		p_workspace->order(g, begin, end);
+		for(const uint* v = begin; v != end; v++)
 			relax(g, *v);
 	}
 	
@@ -0,0 +1,119 @@
+#include "acyclic_workspace.h"
+
+namespace graphs
+{
+	void acyclic_workspace::reserve(const uint& V)
+	{
+		if(V <= _capacity)
+			return;
+		
+		delete[] _distTo;
+		delete[] _edgeTo;
+		delete[] _order;
+		delete[] _stack;
+		delete[] _next;
+		delete[] _end;
+		
+		_capacity = V;
+		_reserved++;
+		_distTo = new double[V];
+		_edgeTo = new edge[V];
+		_order = new uint[V];
+		_stack = new uint[V];
+		_next = new adje_citer[V];
+		_end = new adje_citer[V];
+		_marked.resize(V);
+		_onStack.resize(V);
+		
+		// The order array was replaced, so whatever was cached is gone.
+		p_g = nullptr;
+	}
+	
+	void acyclic_workspace::order(const edge_weighted_digraph& g, const uint*& begin, const uint*& end)
+	{
+		if(p_g != &g || _version != g.version())
+		{
+			reserve(g.V());
+			_compute_order(g);
+			
+			p_g = &g;
+			_version = g.version();
+		}
+		
+		begin = _order;
+		end = _order + _orderCount;
+	}
+	
+	void acyclic_workspace::_compute_order(const edge_weighted_digraph& g)
+	{
+		uint V = g.V();
+		_marked.resize(V);
+		_onStack.resize(V);
+		_computed++;
+		
+		// Record the postorder, then reverse it in place.
+		uint count = 0;
+		bool acyclic = true;
+		for(uint s = 0; s < V && acyclic == true; s++)
+		{
+			if(_marked.test(s) == true)
+				continue;
+			
+			uint depth = 0;
+			_stack[depth] = s;
+			g.adj(s, _next[depth], _end[depth]);
+			_marked.set(s);
+			_onStack.set(s);
+			depth++;
+			
+			while(depth > 0)
+			{
+				uint top = depth - 1;
+				uint v = _stack[top];
+				if(_next[top] != _end[top])
+				{
+					uint w = _next[top]->to();
+					_next[top]++;
+					
+					// Have we been here before?
+					if(_marked.test(w) == false)
+					{
+						_stack[depth] = w;
+						g.adj(w, _next[depth], _end[depth]);
+						_marked.set(w);
+						_onStack.set(w);
+						depth++;
+					}
+					// If w is still on the stack, the v->w edge closes a cycle.
+					else if(_onStack.test(w) == true)
+					{
+						acyclic = false;
+						break;
+					}
+				}
+				else
+				{
+					// Done with v:  dfs(v) returns.
+					_onStack.reset(v);
+					_order[count++] = v;
+					depth--;
+				}
+			}
+		}
+		
+		if(acyclic == false)
+		{
+			_orderCount = 0;
+			return;
+		}
+		
+		for(uint i = 0, j = count - 1; i < j && j < count; i++, j--)
+		{
+			uint temp = _order[i];
+			_order[i] = _order[j];
+			_order[j] = temp;
+		}
+		
+		_orderCount = count;
+	}
+}
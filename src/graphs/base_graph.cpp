@@ -17,7 +17,7 @@ namespace graphs
 		_size = V;
 	}
 	
-	base_graph::base_graph(const base_graph& g) noexcept
+	base_graph::base_graph(const base_graph& g) noexcept : graph_version(g)
 	{
 		_V = g._V;
 		_E = g._E;
@@ -48,6 +48,8 @@ namespace graphs
 		aradj* temp = _adj;
 		_adj = g._adj;
 		g._adj = temp;
+		
+		g._changed(graph_change::CLEAR);
 	}
 	
 	base_graph& base_graph::operator=(const base_graph& g) noexcept
@@ -64,6 +66,8 @@ namespace graphs
 		for(int v = 0; v < _V; v++)
 			_adj->addAt(v, g._adj->get(v));
 		
+		_changed(graph_change::ASSIGN);
+		
 		return *this;
 	}
 	
@@ -85,6 +89,9 @@ namespace graphs
 		_adj = g._adj;
 		g._adj = temp;
 		
+		_changed(graph_change::ASSIGN);
+		g._changed(graph_change::ASSIGN);
+		
 		return *this;
 	}
 	
@@ -176,5 +183,6 @@ namespace graphs
 		_adj->clear();
 		_V = 0;
 		_E = 0;
+		_changed(graph_change::CLEAR);
 	}
 }
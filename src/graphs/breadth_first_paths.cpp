@@ -6,49 +6,59 @@ namespace graphs
 	{
 		uint V = g.V();
 		_size = V;
-		_marked = new bool[V];
+		_marked.resize(V);
 		_edgeTo = new uint[V];
 		for(int i = 0; i < V; i++)
-		{
-			_marked[i] = false;
 			_edgeTo[i] = undefined_uint;
-		}
 		
-		bfs(g, s);
+		bfs<adj_iter>(g, s);
+	}
+	
+	breadth_first_paths::breadth_first_paths(const compressed_digraph& g, uint s)
+	{
+		operator()(g, s);
 	}
 	
 	void breadth_first_paths::operator()(const base_graph& g, uint s)
 	{
-		uint V = g.V();
+		_prepare(g.V());
+		bfs<adj_iter>(g, s);
+	}
+	
+	void breadth_first_paths::operator()(const compressed_digraph& g, uint s)
+	{
+		_prepare(g.V());
+		bfs<compressed_digraph::iterator>(g, s);
+	}
+	
+	void breadth_first_paths::_prepare(const uint& V)
+	{
+		// Size the arrays for V vertices, or clear the marks if they are.
 		if(_size != V)
 		{
-			delete[] _marked;
 			delete[] _edgeTo;
 			
-			_marked = nullptr;
 			_edgeTo = nullptr;
 			
 			_size = V;
 			
-			_marked = new bool[V];
+			_marked.resize(V);
 			_edgeTo = new uint[V];
 			
 			for(int v = 0; v < V; v++)
-			{
-				_marked[v] = false;
 				_edgeTo[v] = undefined_uint;
-			}
 		}
-		
-		bfs(g, s);
+		else
+			_marked.clear();				// Stale _edgeTo[] entries are unreachable once unmarked.
 	}
 	
-	void breadth_first_paths::bfs(const base_graph& g, uint s)
+	template <typename Iterator, typename Graph>
+	void breadth_first_paths::bfs(const Graph& g, uint s)
 	{
-		adj_iter begin, end, W;
+		Iterator begin, end, W;
 		
 		quui q;
-		_marked[s] = true;
+		_marked.set(s);
 		q.enqueue(s);
 		
 		while(q.empty() == false)
@@ -59,10 +69,10 @@ namespace graphs
 			{
 				uint w = *W;
 				
-				if(_marked[w] == false)			// For every unmarked adjacent vertex,
+				if(_marked.test(w) == false)	// For every unmarked adjacent vertex,
 				{
 					_edgeTo[w] = v;				// save last edge on a shortest path,
-					_marked[w] = true;			// mark it because path is known,
+					_marked.set(w);				// mark it because path is known,
 					q.enqueue(w);				// and add it to the queue.
 				}
 			}
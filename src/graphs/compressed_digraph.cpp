@@ -0,0 +1,196 @@
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+#include "compressed_digraph.h"
+
+namespace graphs
+{
+	compressed_digraph::compressed_digraph(const digraph& g)
+	{
+		_build(g.V(), g.E(), [&g](const uint& v)
+		{
+			uint degree = 0;
+			adj_citer begin, end;
+			g.adj(v, begin, end);
+			for(adj_citer w = begin; w != end; w++)
+				degree++;
+			
+			return degree;
+		}, [&g](const uint& v, uint* neighbours)
+		{
+			adj_citer begin, end;
+			g.adj(v, begin, end);
+			for(adj_citer w = begin; w != end; w++)
+				*neighbours++ = *w;
+		});
+	}
+	
+	compressed_digraph::compressed_digraph(const uint& V, const uint* edgeStart, const uint* targets)
+	{
+		// The neighbours of v are targets[edgeStart[v], edgeStart[v+1]), in any order.
+		_build(V, edgeStart[V], [edgeStart](const uint& v)
+		{
+			return edgeStart[v + 1] - edgeStart[v];
+		}, [edgeStart, targets](const uint& v, uint* neighbours)
+		{
+			memcpy(neighbours, targets + edgeStart[v], (edgeStart[v + 1] - edgeStart[v]) * sizeof(uint));
+		});
+	}
+	
+	compressed_digraph::compressed_digraph(const compressed_digraph& g)
+	{
+		*this = g;
+	}
+	
+	compressed_digraph::compressed_digraph(compressed_digraph&& g) noexcept
+	{
+		*this = std::move(g);
+	}
+	
+	compressed_digraph& compressed_digraph::operator=(const compressed_digraph& g)
+	{
+		if(this == &g)
+			return *this;
+		
+		_release();
+		if(g._offsets == nullptr)
+			return *this;
+		
+		_V = g._V;
+		_E = g._E;
+		_size = g._size;
+		_offsets = new ulong[_V + 1];
+		memcpy(_offsets, g._offsets, (_V + 1) * sizeof(ulong));
+		_stream = new uchar[_size];
+		memcpy(_stream, g._stream, _size);
+		
+		return *this;
+	}
+	
+	compressed_digraph& compressed_digraph::operator=(compressed_digraph&& g) noexcept
+	{
+		std::swap(_offsets, g._offsets);
+		std::swap(_stream, g._stream);
+		std::swap(_size, g._size);
+		std::swap(_V, g._V);
+		std::swap(_E, g._E);
+		
+		return *this;
+	}
+	
+	compressed_digraph::~compressed_digraph() noexcept
+	{
+		_release();
+	}
+	
+	void compressed_digraph::_release()
+	{
+		delete[] _offsets;
+		delete[] _stream;
+		
+		_offsets = nullptr;
+		_stream = nullptr;
+		_size = 0;
+		_V = 0;
+		_E = 0;
+	}
+	
+	template <typename Degree, typename Fill>
+	void compressed_digraph::_build(const uint& V, const uint& E, const Degree& degree, const Fill& fill)
+	{
+		// Sort the neighbours of each vertex in turn, and append their differences to the stream, which grows as needed:
+		// a uint takes at most 5 bytes.  When done, the stream is copied to one of the size it came to.
+		_V = V;
+		_E = E;
+		_offsets = new ulong[_V + 1];
+		
+		ulong capacity = E + E / 2 + _padding;
+		uchar* stream = new uchar[capacity];
+		ulong used = 0;
+		
+		uint maxDegree = 0;
+		for(uint v = 0; v < V; v++)
+			maxDegree = std::max(maxDegree, (uint)degree(v));
+		
+		uint* neighbours = new uint[maxDegree + 1];
+		for(uint v = 0; v < V; v++)
+		{
+			_offsets[v] = used;
+			
+			uint n = degree(v);
+			fill(v, neighbours);
+			std::sort(neighbours, neighbours + n);
+			
+			if(used + 5ul * n + _padding > capacity)
+			{
+				capacity = std::max(2 * capacity, used + 5ul * n + _padding);
+				uchar* grown = new uchar[capacity];
+				memcpy(grown, stream, used);
+				delete[] stream;
+				stream = grown;
+			}
+			
+			uint previous = 0;
+			for(uint i = 0; i < n; i++)
+			{
+				uint delta = neighbours[i] - previous;
+				previous = neighbours[i];
+				while(delta >= 0x80)
+				{
+					stream[used++] = (uchar)(delta | 0x80);
+					delta >>= 7;
+				}
+				
+				stream[used++] = (uchar)delta;
+			}
+		}
+		
+		_offsets[V] = used;
+		delete[] neighbours;
+		
+		_size = used + _padding;
+		_stream = new uchar[_size];
+		memcpy(_stream, stream, used);
+		memset(_stream + used, 0, _padding);
+		delete[] stream;
+	}
+	
+	void compressed_digraph::adj(const uint& v, iterator& begin, iterator& end) const
+	{
+		begin = iterator(_stream + _offsets[v]);
+		end = iterator(_stream + _offsets[v + 1]);
+	}
+	
+	uint compressed_digraph::degree(const uint& v) const
+	{
+		// The last byte of each neighbour has its high bit clear.
+		uint degree = 0;
+		for(ulong i = _offsets[v]; i < _offsets[v + 1]; i++)
+			if((_stream[i] & 0x80) == 0)
+				degree++;
+		
+		return degree;
+	}
+	
+	std::string compressed_digraph::str() const
+	{
+		ostringstream o;
+		string indentation = "     ";
+		
+		o << indentation << _V << endl << _E << endl;
+		
+		iterator begin, end, it;
+		for(uint v = 0; v < _V; v++)
+		{
+			o << indentation << "g[" << v << "] = ";
+			adj(v, begin, end);
+			for(it = begin; it != end; it++)
+				o << (*it) << " -> ";
+			
+			o << endl;
+		}
+		
+		return o.str();
+	}
+}
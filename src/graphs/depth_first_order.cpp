@@ -7,8 +7,8 @@ namespace graphs
 		uint V = dg.V();
 		_initialize(V);
 		
-		for(int v = 0; v < V; v++)
-			if(_marked[v] == false)
+		for(uint v = 0; v < V; v++)
+			if(_marked.test(v) == false)
 				dfs(dg, v);
 	}
 	
@@ -17,8 +17,8 @@ namespace graphs
 		uint V = dg.V();
 		_initialize(V);
 		
-		for(int v = 0; v < V; v++)
-			if(_marked[v] == false)
+		for(uint v = 0; v < V; v++)
+			if(_marked.test(v) == false)
 				dfs(dg, v);
 	}
 	
@@ -27,8 +27,8 @@ namespace graphs
 		uint V = dg.V();
 		_initialize(V);
 		
-		for(int v = 0; v < V; v++)
-			if(_marked[v] == false)
+		for(uint v = 0; v < V; v++)
+			if(_marked.test(v) == false)
 				dfs(dg, v);
 	}
 	
@@ -37,8 +37,8 @@ namespace graphs
 		uint V = dg.V();
 		_initialize(V);
 		
-		for(int v = 0; v < V; v++)
-			if(_marked[v] == false)
+		for(uint v = 0; v < V; v++)
+			if(_marked.test(v) == false)
 				dfs(dg, v);
 	}
 	
@@ -47,35 +47,58 @@ namespace graphs
 		uint V = dg.V();
 		_initialize(V);
 		
-		for(int v = 0; v < V; v++)
-			if(_marked[v] == false)
+		for(uint v = 0; v < V; v++)
+			if(_marked.test(v) == false)
 				dfs(dg, v);
 	}
 	
 	void depth_first_order::_initialize(const uint& V)
 	{
-		_size = V;
-		if(_marked != nullptr)
-			delete[] _marked;
+		// Every vertex is visited, so each order holds V of them.
+		if(V > _capacity)
+		{
+			delete[] _pre;
+			delete[] _post;
+			delete[] _reversePost;
 			
-		_marked = new bool[V];
-		for(int v = 0; v < V; v++)
-			_marked[v] = false;
-		
-		if(_pre != nullptr)
-			_pre->clear();
-		else
-			_pre = new pre;
-		
-		if(_post != nullptr)
-			_post->clear();
-		else
-			_post = new post;
-		
-		if(_reversePost != nullptr)
-			_reversePost->clear();
-		else
-			_reversePost = new rpost;
+			_capacity = V;
+			_pre = new uint[V];
+			_post = new uint[V];
+			_reversePost = new uint[V];
+		}
+		
+		_size = V;
+		_preCount = 0;
+		_postCount = 0;
+		_marked.resize(V);
+	}
+	
+	pre depth_first_order::Pre() const
+	{
+		pre order;
+		for(uint i = 0; i < _size; i++)
+			order.add(_pre[i]);
+		
+		return order;
+	}
+	
+	post depth_first_order::Post() const
+	{
+		post order;
+		for(uint i = 0; i < _size; i++)
+			order.add(_post[i]);
+		
+		return order;
+	}
+	
+	rpost depth_first_order::ReversePost() const
+	{
+		// Added in postorder, as rpost reverses them.
+		rpost order;
+		for(uint i = 0; i < _size; i++)
+			order.add(_post[i]);
+		
+		return order;
 	}
 	
 	void depth_first_order::operator()(const digraph& dg)
@@ -83,8 +106,8 @@ namespace graphs
 		uint V = dg.V();
 		_initialize(V);
 		
-		for(int v = 0; v < V; v++)
-			if(_marked[v] == false)
+		for(uint v = 0; v < V; v++)
+			if(_marked.test(v) == false)
 				dfs(dg, v);
 	}
 	
@@ -94,20 +117,20 @@ namespace graphs
 		// _post = order in which the vertices are done, that is when dfs(v) finishes.
 		// _reversePost = mirror immage of _post.
 		
-		_pre->add(v);
-		_marked[v] = true;
+		_pre[_preCount++] = v;
+		_marked.set(v);
 		
 		adj_citer begin, end;
 		dg.adj(v, begin, end);
 		for(adj_citer W = begin; W != end; W++)
 		{
 			uint w = *W;
-			if(_marked[w] == false)
+			if(_marked.test(w) == false)
 				dfs(dg, w);
 		}
 		
-		_post->add(v);
-		_reversePost->add(v);
+		_reversePost[_size - 1 - _postCount] = v;
+		_post[_postCount++] = v;
 	}
 
 	void depth_first_order::dfs(const edge_weighted_digraph& ewdg, const uint& v)
@@ -116,8 +139,8 @@ namespace graphs
 		// _post = order in which the vertices are done, that is when dfs(v) finishes.
 		// _reversePost = mirror immage of _post.
 		
-		_pre->add(v);
-		_marked[v] = true;
+		_pre[_preCount++] = v;
+		_marked.set(v);
 		
 		adje_citer begin, end, E;
 		ewdg.adj(v, begin, end);
@@ -125,11 +148,11 @@ namespace graphs
 		{
 			edge const& e = *E;
 			uint w = e.to();
-			if(_marked[w] == false)
+			if(_marked.test(w) == false)
 				dfs(ewdg, w);
 		}
 		
-		_post->add(v);
-		_reversePost->add(v);
+		_reversePost[_size - 1 - _postCount] = v;
+		_post[_postCount++] = v;
 	}
 }
@@ -7,16 +7,13 @@ namespace graphs
 		uint V = g.V();
 		_size = V;
 		
-		_marked = new bool[V];
+		_marked.resize(V);
 		_edgeTo = new uint[V];
 		
 		for(int v = 0; v < V; v++)
-		{
-			_marked[v] = false;
 			_edgeTo[v] = undefined_uint;
-		}
 		
-		dfs(g, s);
+		dfs<adj_iter>(g, s);
 	}
 	
 	depth_first_search::depth_first_search(const base_graph& g, const arui& sources)
@@ -24,98 +21,107 @@ namespace graphs
 		uint V= g.V();
 		_size = V;
 		
-		_marked = new bool[V];
+		_marked.resize(V);
 		_edgeTo = new uint[V];
 		
 		for(int v = 0; v < V; v++)
-		{
-			_marked[v] = false;
 			_edgeTo[v] = undefined_uint;
-		}
 		
 		for(arui_citer s = sources.cbegin(); s != sources.cend(); s++)
 		{
-			if(_marked[*s] == false)
-				dfs(g, *s);
+			if(_marked.test(*s) == false)
+				dfs<adj_iter>(g, *s);
 		}
 	}
 	
 	void depth_first_search::operator()(const base_graph& g, const uint& s)
 	{
-		uint V = g.V();
-		if(_size != V)
+		_prepare(g.V());
+		_count = 0;
+		
+		dfs<adj_iter>(g, s);
+	}
+	
+	void depth_first_search::operator()(const base_graph& g, const arui& sources)
+	{
+		_prepare(g.V());
+		_count = 0;
+		
+		for(arui_citer s = sources.cbegin(); s != sources.cend(); s++)
 		{
-			delete[] _marked;
-			delete[] _edgeTo;
-			
-			_marked = nullptr;
-			_edgeTo = nullptr;
-			
-			_size = V;
-			
-			_marked = new bool[V];
-			_edgeTo = new uint[V];
-			
-			for(int v = 0; v < V; v++)
-			{
-				_marked[v] = false;
-				_edgeTo[v] = undefined_uint;
-			}
+			if(_marked.test(*s) == false)
+				dfs<adj_iter>(g, *s);
 		}
+	}
+	
+	depth_first_search::depth_first_search(const compressed_digraph& g, const uint& s)
+	{
+		operator()(g, s);
+	}
+	
+	depth_first_search::depth_first_search(const compressed_digraph& g, const arui& sources)
+	{
+		operator()(g, sources);
+	}
+	
+	void depth_first_search::operator()(const compressed_digraph& g, const uint& s)
+	{
+		_prepare(g.V());
+		_count = 0;
 		
+		dfs<compressed_digraph::iterator>(g, s);
+	}
+	
+	void depth_first_search::operator()(const compressed_digraph& g, const arui& sources)
+	{
+		_prepare(g.V());
 		_count = 0;
 		
-		dfs(g, s);
+		for(arui_citer s = sources.cbegin(); s != sources.cend(); s++)
+		{
+			if(_marked.test(*s) == false)
+				dfs<compressed_digraph::iterator>(g, *s);
+		}
 	}
 	
-	void depth_first_search::operator()(const base_graph& g, const arui& sources)
+	void depth_first_search::_prepare(const uint& V)
 	{
-		uint V = g.V();
+		// Size the arrays for V vertices, or clear the marks if they are.
 		if(_size != V)
 		{
-			delete[] _marked;
 			delete[] _edgeTo;
 			
-			_marked = nullptr;
 			_edgeTo = nullptr;
 			
 			_size = V;
 			
-			_marked = new bool[V];
+			_marked.resize(V);
 			_edgeTo = new uint[V];
 			
 			for(int v = 0; v < V; v++)
-			{
-				_marked[v] = false;
 				_edgeTo[v] = undefined_uint;
-			}
-		}
-		
-		_count = 0;
-		
-		for(arui_citer s = sources.cbegin(); s != sources.cend(); s++)
-		{
-			if(_marked[*s] == false)
-				dfs(g, *s);
 		}
+		else
+			_marked.clear();
 	}
 	
-	void depth_first_search::dfs(const base_graph& g, const uint& v)
+	template <typename Iterator, typename Graph>
+	void depth_first_search::dfs(const Graph& g, const uint& v)
 	{
-		_marked[v] = true;
+		_marked.set(v);
 		_count++;
 		
-		adj_iter begin, end, W;
+		Iterator begin, end, W;
 		g.adj(v, begin, end);
 		for(W = begin; W != end; W++)
 		{
 			uint w = *W;
 			
 			// Have we been here before?
-			if(_marked[w] == false)
+			if(_marked.test(w) == false)
 			{
 				_edgeTo[w] = v;			// Record the first vertex that lead us to w.
-				dfs(g, w);
+				dfs<Iterator>(g, w);
 			}
 		}
 	}
@@ -15,6 +15,7 @@ namespace graphs
 		
 		_adj->get(v).add(w);
 		_E++;
+		_changed(graph_change::ADD_EDGE, v, w);
 	}
 	
 	digraph digraph::reverse() const
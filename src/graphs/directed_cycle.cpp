@@ -9,7 +9,7 @@ namespace graphs
 		_initialize(V);
 
 		for(int v = 0; v < V; v++)
-			if((*_marked)[v] == false)
+			if(_marked.test(v) == false)
 				dfs(dg, v);
 	}
 	
@@ -21,22 +21,15 @@ namespace graphs
 		_initialize(V);
 		
 		for(int v = 0; v < V; v++)
-			if((*_marked)[v] == false)
+			if(_marked.test(v) == false)
 				dfs(dg, v);
 	}
 	
 	void directed_cycle::_initialize(const uint& V)
 	{
-		if(_marked == nullptr)
-			_marked = new containers::array<bool>(V);
-		else
-		{
-			if(_marked->size() != V)
-				_marked->reserve(V);
-			
-			_marked->clear();
-		}
-			
+		_marked.resize(V);
+		_onStack.resize(V);
+		
 		if(_edgeTo == nullptr)
 			_edgeTo = new containers::array<unsigned int>(V);
 		else
@@ -55,15 +48,6 @@ namespace graphs
 			_edgeTo_e->clear();
 		}
 		
-		if(_onStack == nullptr)
-			_onStack = new containers::array<bool>(V);
-		else
-		{
-			if(_onStack->size() != V)
-				_onStack->reserve(V);
-			_onStack->clear();
-		}
-		
 		if(p_cycle == nullptr)
 			p_cycle = new cyclic_path;
 		else
@@ -86,7 +70,7 @@ namespace graphs
 		_initialize(V);
 		
 		for(int v = 0; v < V; v++)
-			if((*_marked)[v] == false)
+			if(_marked.test(v) == false)
 				dfs(dg, v);
 	}
 	
@@ -98,14 +82,14 @@ namespace graphs
 		_initialize(V);
 		
 		for(int v = 0; v < V; v++)
-			if((*_marked)[v] == false)
+			if(_marked.test(v) == false)
 				dfs(dg, v);
 	}
 	
 	void directed_cycle::dfs(const digraph& dg, const uint& v)
 	{
-		(*_onStack)[v] = true;
-		(*_marked)[v] = true;
+		_onStack.set(v);
+		_marked.set(v);
 		
 		adj_iter begin, end;
 		dg.adj(v, begin, end);
@@ -116,13 +100,13 @@ namespace graphs
 			if(hasCycle() == true)
 				return;
 			// Have we been here before?
-			else if((*_marked)[w] == false)
+			else if(_marked.test(w) == false)
 			{
 				(*_edgeTo)[w] = v;			// Record the first vertex that lead us to w.
 				dfs(dg, w);
 			}
 			// If we encountered *w before, then we have a cycle.
-			else if((*_onStack)[w] == true)
+			else if(_onStack.test(w) == true)
 			{
 				/*
 				 * The v->w edge confirmed that we have a cycle.  Thus starting with v, trace the reverse of the path
@@ -146,13 +130,13 @@ namespace graphs
 			}
 		}
 		
-		(*_onStack)[v] = false;
+		_onStack.reset(v);
 	}
 	
 	void directed_cycle::dfs(const edge_weighted_digraph& dg, const uint& v)
 	{
-		(*_onStack)[v] = true;
-		(*_marked)[v] = true;
+		_onStack.set(v);
+		_marked.set(v);
 		
 		adje_citer begin, end, E;
 		dg.adj(v, begin, end);
@@ -165,7 +149,7 @@ namespace graphs
 				return;
 			
 			// Have we been here before?
-			else if((*_marked)[w] == false)
+			else if(_marked.test(w) == false)
 			{
 				(*_edgeTo)[w] = v;			// Record the first vertex that lead us to w.
 				(*_edgeTo_e)[w] = e;
@@ -173,7 +157,7 @@ namespace graphs
 			}
 			
 			// If we encountered w before, then we have a cycle.
-			else if((*_onStack)[w] == true)
+			else if(_onStack.test(w) == true)
 			{
 				/*
 				 * The v->w edge confirmed that we have a cycle.  Thus starting with v, trace the reverse of the path
@@ -199,6 +183,6 @@ namespace graphs
 			}
 		}
 		
-		(*_onStack)[v] = false;
+		_onStack.reset(v);
 	}
 }
@@ -9,8 +9,6 @@ namespace graphs
 	
 	directed_DFS_multi::~directed_DFS_multi()
 	{
-		delete[] _marked;
-		delete[] _edgeTo;
 		delete p_g;
 	}
 	
@@ -22,30 +20,14 @@ namespace graphs
 		p_g = new digraph(g);
 		
 		_V = g.V();
-		
-		if(_edgeTo == nullptr)
-			_edgeTo = new uint[_V];
-		
-		if(_marked == nullptr)
-			_marked = new bool[_V];
-		
-		for(int v = 0; v < _V; v++)
-		{
-			_edgeTo[v] = undefined_uint;
-			_marked[v] = false;
-		}
+		_marked.resize(_V);
 		
 		_initialized = true;
 	}
 	
 	void directed_DFS_multi::_reset()
 	{
-		for(int v = 0; v < _V; v++)
-		{
-			_marked[v] = false;
-			_edgeTo[v] = undefined_uint;
-		}
-		
+		_marked.clear();
 		_count = 0;
 	}
 	
@@ -71,18 +53,18 @@ namespace graphs
 	void directed_DFS_multi::dfs(const uint& v)
 	{
 		_count++;
-		_marked[v] = true;
+		_marked.set(v);
 		adj_citer begin, end, w;
 		p_g->adj(v, begin, end);
 		for(w = begin; w != end; w++)
 		{
-			if(_marked[*w] == false)
+			if(_marked.test(*w) == false)
 				dfs(*w);
 		}
 	}
 	
 	bool directed_DFS_multi::marked(const uint& v) const
 	{
-		return _marked[v];
+		return _marked.test(v);
 	}
 }
@@ -15,7 +15,7 @@ namespace graphs
 		_size = V;
 	}
 	
-	edge_weighted_digraph::edge_weighted_digraph(const edge_weighted_digraph& g) noexcept
+	edge_weighted_digraph::edge_weighted_digraph(const edge_weighted_digraph& g) noexcept : graph_version(g)
 	{
 		_V = g._V;
 		_E = g._E;
@@ -38,6 +38,7 @@ namespace graphs
 		
 		_adj = g._adj;
 		g._adj = nullptr;
+		g._changed(graph_change::CLEAR);
 	}
 	
 	edge_weighted_digraph& edge_weighted_digraph::operator=(const edge_weighted_digraph& g) noexcept
@@ -50,6 +51,7 @@ namespace graphs
 			_adj->addAt(v, g._adj->get(v));
 		
 		_size = g._size;
+		_changed(graph_change::ASSIGN);
 		
 		return *this;
 	}
@@ -72,6 +74,9 @@ namespace graphs
 		_adj = g._adj;
 		g._adj = temp;
 		
+		_changed(graph_change::ASSIGN);
+		g._changed(graph_change::ASSIGN);
+		
 		return *this;
 	}
 	
@@ -91,6 +96,7 @@ namespace graphs
 		
 		_adj->get(v).add(&de);
 		_E++;
+		_changed(graph_change::ADD_EDGE, v, w, de.weight);
 	}
 
 	void edge_weighted_digraph::addEdge(edge&& de)
@@ -108,6 +114,7 @@ namespace graphs
 		
 		_adj->get(de.from()).add(&de);
 		_E++;
+		_changed(graph_change::ADD_EDGE, v, w, de.weight);
 	}
 	
 	void edge_weighted_digraph::adj(const uint& v, adje_iter& b, adje_iter& e) const
@@ -187,6 +194,7 @@ namespace graphs
 		_adj->clear();
 		_V = 0;
 		_E = 0;
+		_changed(graph_change::CLEAR);
 	}
 	
 	std::string edge_weighted_digraph::str() const
@@ -15,7 +15,7 @@ namespace graphs
 		_edges = new are(2*_V);
 	}
 	
-	edge_weighted_graph::edge_weighted_graph(const edge_weighted_graph& g) noexcept
+	edge_weighted_graph::edge_weighted_graph(const edge_weighted_graph& g) noexcept : graph_version(g)
 	{
 		// Don't set _E, as it increases the array's _count variable.  addEdge() will take care of the correct value.
 		_V = g._V;
@@ -41,6 +41,7 @@ namespace graphs
 		
 		_edges = g._edges;
 		g._edges = nullptr;
+		g._changed(graph_change::CLEAR);
 	}
 	
 	edge_weighted_graph& edge_weighted_graph::operator=(const edge_weighted_graph& g) noexcept
@@ -50,6 +51,7 @@ namespace graphs
 
 		_adj->clear();
 		_edges->clear();
+		_changed(graph_change::CLEAR);
 		
 		for(int v = 0; v < _V; v++)
 			_adj->addAt(v, adjpe());
@@ -79,6 +81,9 @@ namespace graphs
 		_edges = g._edges;
 		g._edges = temp2;
 		
+		_changed(graph_change::ASSIGN);
+		g._changed(graph_change::ASSIGN);
+		
 		return *this;
 	}
 	
@@ -100,6 +105,8 @@ namespace graphs
 		
 		if(_V < max)
 			_V = max + 1;
+		
+		_changed(graph_change::ADD_EDGE, v, w, e.weight);
 	}
 	
 	void edge_weighted_graph::addEdge(edge&& e)
@@ -120,6 +127,8 @@ namespace graphs
 		
 		if(_V < max)
 			_V = max + 1;
+		
+		_changed(graph_change::ADD_EDGE, v, w, e.weight);
 	}
 
 	void edge_weighted_graph::adj(const uint& v, adjpe_iter& begin, adjpe_iter& end) const
@@ -222,5 +231,6 @@ namespace graphs
 		
 		_adj->clear();
 		_edges->clear();
+		_changed(graph_change::CLEAR);
 	}
 }
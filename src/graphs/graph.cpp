@@ -18,5 +18,6 @@ namespace graphs
 		_adj->get(w).add(v);
 		
 		_E++;
+		_changed(graph_change::ADD_EDGE, v, w);
 	}
 }
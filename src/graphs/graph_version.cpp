@@ -0,0 +1,116 @@
+#include "graph_version.h"
+
+namespace graphs
+{
+	std::atomic<ulong> graph_version::_versions{0};
+	
+	graph_version::~graph_version() noexcept
+	{
+		for(uint i = 0; i < _observerCount; i++)
+			p_observers[i]->graphDestroyed(*this);
+		
+		delete[] p_observers;
+		delete[] _log;
+	}
+	
+	void graph_version::subscribe(graph_observer* observer) const
+	{
+		for(uint i = 0; i < _observerCount; i++)
+			if(p_observers[i] == observer)
+				return;
+		
+		if(_observerCount == _observerCapacity)
+		{
+			uint capacity = _observerCapacity == 0 ? 4 : 2 * _observerCapacity;
+			graph_observer** temp = new graph_observer*[capacity];
+			for(uint i = 0; i < _observerCount; i++)
+				temp[i] = p_observers[i];
+			
+			delete[] p_observers;
+			p_observers = temp;
+			_observerCapacity = capacity;
+		}
+		
+		p_observers[_observerCount++] = observer;
+	}
+	
+	void graph_version::unsubscribe(graph_observer* observer) const
+	{
+		for(uint i = 0; i < _observerCount; i++)
+		{
+			if(p_observers[i] == observer)
+			{
+				p_observers[i] = p_observers[--_observerCount];
+				return;
+			}
+		}
+	}
+	
+	void graph_version::setLogging(const bool& on)
+	{
+		_logging = on;
+		clearLog();
+	}
+	
+	void graph_version::clearLog()
+	{
+		_logCount = 0;
+		_logStart = _version;
+	}
+	
+	bool graph_version::changesSince(const ulong& version, const graph_change*& begin, const graph_change*& end) const
+	{
+		// The log only covers the changes after _logStart.
+		if(_logging == false || version < _logStart)
+			return false;
+		
+		// Versions in the log are increasing, so find the first one past version by bisection.
+		uint lo = 0;
+		uint hi = _logCount;
+		while(lo < hi)
+		{
+			uint mid = lo + (hi - lo) / 2;
+			if(_log[mid].version <= version)
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+		
+		begin = _log + lo;
+		end = _log + _logCount;
+		
+		return true;
+	}
+	
+	void graph_version::_changed(const graph_change::change_type& type, const uint& v, const uint& w, const double& weight)
+	{
+		_version = ++_versions;
+		
+		graph_change change;
+		change.type = type;
+		change.v = v;
+		change.w = w;
+		change.weight = weight;
+		change.version = _version;
+		
+		if(_logging == true)
+		{
+			if(_logCount == _logCapacity)
+			{
+				uint capacity = _logCapacity == 0 ? 64 : 2 * _logCapacity;
+				graph_change* temp = new graph_change[capacity];
+				for(uint i = 0; i < _logCount; i++)
+					temp[i] = _log[i];
+				
+				delete[] _log;
+				_log = temp;
+				_logCapacity = capacity;
+			}
+			
+			_log[_logCount++] = change;
+		}
+		
+		for(uint i = 0; i < _observerCount; i++)
+			p_observers[i]->graphChanged(*this, change);
+	}
+}
@@ -10,24 +10,33 @@ namespace graphs
 		if(cyclefinder.hasCycle() == false)
 		{
 			depth_first_order dfo(dg);
-			rpost temp = dfo.ReversePost();
-			
-			for(rpost_citer i = temp.cbegin(); i != temp.cend(); i++)
-				_order->add(*i);
+			const uint* begin = nullptr;
+			const uint* end = nullptr;
+			dfo.postorder(begin, end);
+			for(const uint* v = begin; v != end; v++)
+				_order->add(*v);		// A path adds to the front, reversing the postorder.
 		}
+		
+		p_dg = &dg;
+		_watch(dg);
 	}
 	
 	void topological::operator()(const digraph& dg)
 	{
 		_order->clear();
+		p_dg = &dg;
+		p_ewdg = nullptr;
+		_watch(dg);
 		
 		directed_cycle cyclefinder(dg);
 		if(cyclefinder.hasCycle() == false)
 		{
 			depth_first_order dfo(dg);
-			rpost temp = dfo.ReversePost();
-			for(rpost_citer i = temp.cbegin(); i != temp.cend(); i++)
-				_order->add(*i);
+			const uint* begin = nullptr;
+			const uint* end = nullptr;
+			dfo.postorder(begin, end);
+			for(const uint* v = begin; v != end; v++)
+				_order->add(*v);		// A path adds to the front, reversing the postorder.
 		}
 	}
 	
@@ -39,24 +48,65 @@ namespace graphs
 		if(cyclefinder.hasCycle() == false)
 		{
 			depth_first_order dfo(dg);
-			rpost temp = dfo.ReversePost();
-			
-			for(rpost_citer i = temp.cbegin(); i != temp.cend(); i++)
-				_order->add(*i);
+			const uint* begin = nullptr;
+			const uint* end = nullptr;
+			dfo.postorder(begin, end);
+			for(const uint* v = begin; v != end; v++)
+				_order->add(*v);		// A path adds to the front, reversing the postorder.
 		}
+		
+		p_ewdg = &dg;
+		_watch(dg);
 	}
 	
 	void topological::operator()(const edge_weighted_digraph& dg)
 	{
 		_order->clear();
+		p_ewdg = &dg;
+		p_dg = nullptr;
+		_watch(dg);
 		
 		directed_cycle cyclefinder(dg);
 		if(cyclefinder.hasCycle() == false)
 		{
 			depth_first_order dfo(dg);
-			rpost temp = dfo.ReversePost();
-			for(rpost_citer i = temp.cbegin(); i != temp.cend(); i++)
-				_order->add(*i);
+			const uint* begin = nullptr;
+			const uint* end = nullptr;
+			dfo.postorder(begin, end);
+			for(const uint* v = begin; v != end; v++)
+				_order->add(*v);		// A path adds to the front, reversing the postorder.
+		}
+	}
+	
+	void topological::refresh()
+	{
+		if(_stale == false)
+			return;
+		
+		// operator() resubscribes to the same graph and clears _stale.
+		if(p_dg != nullptr)
+			(*this)(*p_dg);
+		else if(p_ewdg != nullptr)
+			(*this)(*p_ewdg);
+	}
+	
+	void topological::_watch(const graph_version& g)
+	{
+		if(p_source != &g)
+		{
+			_unwatch();
+			g.subscribe(this);
+			p_source = &g;
 		}
+		
+		_stale = false;
+	}
+	
+	void topological::_unwatch()
+	{
+		if(p_source != nullptr)
+			p_source->unsubscribe(this);
+		
+		p_source = nullptr;
 	}
 }
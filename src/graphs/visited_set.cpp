@@ -0,0 +1,90 @@
+#include "visited_set.h"
+
+namespace graphs
+{
+	void visited_set::clear()
+	{
+		// On wrap around, a stamp left from 2^32 clears ago could match again.
+		if(++_epoch == 0)
+		{
+			for(uint w = 0; w < _capacity; w++)
+				_epochs[w] = 0;
+			
+			_epoch = 1;
+		}
+	}
+	
+	void visited_set::resize(const uint& V)
+	{
+		uint words = (V + 63) / 64;
+		if(words > _capacity)
+		{
+			delete[] _words;
+			delete[] _epochs;
+			
+			_capacity = words;
+			_words = new ulong[_capacity];
+			_epochs = new uint[_capacity];
+			
+			for(uint w = 0; w < _capacity; w++)
+				_epochs[w] = 0;
+		}
+		
+		_size = V;
+		clear();
+	}
+	
+	uint visited_set::count() const
+	{
+		uint result = 0;
+		uint words = (_size + 63) / 64;
+		for(uint w = 0; w < words; w++)
+			result += __builtin_popcountl(_word(w));
+		
+		return result;
+	}
+	
+	uint visited_set::find_next_set(const uint& from) const
+	{
+		if(from >= _size)
+			return _size;
+		
+		// Mask off the bits below from in its word, then scan whole words.
+		uint words = (_size + 63) / 64;
+		uint w = from >> 6;
+		ulong bits = _word(w) & (~0ul << (from & 63));
+		
+		while(bits == 0)
+		{
+			if(++w == words)
+				return _size;
+			
+			bits = _word(w);
+		}
+		
+		uint v = (w << 6) + __builtin_ctzl(bits);
+		return v < _size ? v : _size;
+	}
+	
+	uint visited_set::find_next_unset(const uint& from) const
+	{
+		if(from >= _size)
+			return _size;
+		
+		uint words = (_size + 63) / 64;
+		uint w = from >> 6;
+		ulong bits = ~_word(w) & (~0ul << (from & 63));
+		
+		while(bits == 0)
+		{
+			if(++w == words)
+				return _size;
+			
+			bits = ~_word(w);
+		}
+		
+		// The unused bits past _size in the last word read as unset, hence the bound.
+		uint v = (w << 6) + __builtin_ctzl(bits);
+		return v < _size ? v : _size;
+	}
+}
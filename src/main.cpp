@@ -28,13 +28,38 @@ int test_acyclic_LP();
 int test_acyclic_paths();
 int test_solver(long);
 int test_topological();
+int test_union_find();
+int test_visited_set();
+int test_acyclic_workspace();
+int test_graph_version();
+int test_lazy_dfa();
+int test_dfa();
+int test_bit_parallel();
+int test_nfa_find();
+int test_pattern_set();
+int test_token_rule();
+int test_prefilter();
+int test_char_sets();
+int test_nfa_matcher();
+int test_nfa_utf8();
+int test_nfa_captures();
+int test_mapped_input();
+int test_streamed_input();
+int test_structural_index();
+int test_parallel_edge_reader();
+int test_number_scanner();
+int test_binary_graph();
+int test_symbol_graph();
+int test_symbol_table();
+int test_shared_lookups();
+int test_compressed_digraph();
 
-bool ProcessArgs(int argc, char* argv[], long& trialCount)
+bool ProcessArgs(int argc, char* argv[], long& trialCount, bool& benchmark)
 {
-	// --help, -h, --filename, --debug
+	// --help, -h, --filename, --debug, --benchmark
 	string optional_rename_arg("");
-	const string usage = "Usage:  " + string(argv[0]) + " --debug --trialCount" ;
-	const int OptionsCount = 4;
+	const string usage = "Usage:  " + string(argv[0]) + " --debug --trialCount --benchmark" ;
+	const int OptionsCount = 5;
 	utilities::ExpandPath ep;
 	algorithms::readNumber rn;
 
@@ -42,6 +67,7 @@ bool ProcessArgs(int argc, char* argv[], long& trialCount)
 	struct option long_options[OptionsCount] = {
 		{ "debug", no_argument, nullptr, 'b' },
 		{ "trialCount", required_argument, nullptr, 't'},
+		{ "benchmark", no_argument, nullptr, 'm' },
 		{ "help", no_argument, nullptr, 'h' },
 		{nullptr,0,nullptr,0}								// Mandatory "null" termination.
 	};
@@ -60,7 +86,7 @@ bool ProcessArgs(int argc, char* argv[], long& trialCount)
 	 * will be ignored in the sans '+' case.
 	*/
 	
-	while( (option = getopt_long(argc, argv, "bt:h", long_options, nullptr)) != -1 )
+	while( (option = getopt_long(argc, argv, "bt:mh", long_options, nullptr)) != -1 )
 	{
 		switch(option)
 		{
@@ -79,6 +105,9 @@ bool ProcessArgs(int argc, char* argv[], long& trialCount)
 					trialCount = rn.getLong();
 				break;
 			}
+			case 'm':			// -m, --benchmark
+				benchmark = true;
+				break;
 			case 'h': 			// -h, --help
 				cerr << usage << endl;
 				return false;
@@ -108,7 +137,8 @@ int main(int argc, char *argv[])
 	graphs::_DEBUG = false;
 
 	long rk4Trials = 0;
-	if(ProcessArgs(argc, argv, rk4Trials) == false)
+	bool benchmark = false;
+	if(ProcessArgs(argc, argv, rk4Trials, benchmark) == false)
 		return -1;
 	
 	// Regular Expression demo:
@@ -159,6 +189,35 @@ int main(int argc, char *argv[])
 	
 	test_solver(rk4Trials);
 	
+	if(benchmark)
+	{
+		test_union_find();
+		test_visited_set();
+		test_acyclic_workspace();
+		test_graph_version();
+		test_lazy_dfa();
+		test_dfa();
+		test_bit_parallel();
+		test_nfa_find();
+		test_pattern_set();
+		test_token_rule();
+		test_prefilter();
+		test_char_sets();
+		test_nfa_matcher();
+		test_nfa_utf8();
+		test_nfa_captures();
+		test_mapped_input();
+		test_streamed_input();
+		test_structural_index();
+		test_parallel_edge_reader();
+		test_number_scanner();
+		test_binary_graph();
+		test_symbol_graph();
+		test_symbol_table();
+		test_shared_lookups();
+		test_compressed_digraph();
+	}
+
     return 0;
 }
 
@@ -1,8 +1,17 @@
 #include <string>
 #include <iostream>
 #include <iomanip>
+#include <fstream>
+#include <random>
+#include <cctype>
+#include <thread>
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <filesystem>
 #include "algorithms.h"
 #include "graphs.h"
+#include "utilities.h"
 
 /*
  * This function reads integral and real tokens from a file, where the two numerial types
@@ -123,3 +132,2712 @@ int test_read_tokens_RE()
 }
 
 
+
+/*
+ * Benchmarks weighted_union_find with each path compression, followed by concurrent_union_find
+ * shared by 1 to 16 threads.  The same randomized mix of unions and connected() querries is
+ * used throughout.  Each thread works on its own slice of the operations, and since the order
+ * of unions does not change the final components, all runs have to agree on count().
+*/
+
+int test_union_find()
+{
+	using namespace std;
+	using namespace algorithms;
+	
+	const uint N = 1 << 20;
+	const uint ops = 1 << 22;
+	const uint union_percent = 25;
+	
+	uint* p = new uint[ops];
+	uint* q = new uint[ops];
+	bool* isUnion = new bool[ops];
+	
+	mt19937 gen(12345);
+	uniform_int_distribution<uint> site(0, N-1);
+	uniform_int_distribution<uint> percent(0, 99);
+	for(uint i = 0; i < ops; i++)
+	{
+		p[i] = site(gen);
+		q[i] = site(gen);
+		isUnion[i] = percent(gen) < union_percent;
+	}
+	
+	cout << "Union find, " << N << " sites, " << ops << " operations, " << union_percent << "% unions:" << endl;
+	
+	uint expected = 0;
+	int duration = 0;
+	const char* names[] = {"NONE", "HALVING", "SPLITTING"};
+	weighted_union_find::compression modes[] = {weighted_union_find::NONE, weighted_union_find::HALVING, weighted_union_find::SPLITTING};
+	
+	for(uint m = 0; m < 3; m++)
+	{
+		weighted_union_find uf(N);
+		uf.setCompression(modes[m]);
+		{
+			utilities::silent_timer Timer(duration);
+			for(uint i = 0; i < ops; i++)
+			{
+				if(isUnion[i])
+					uf.formUnion(p[i], q[i]);
+				else
+					uf.connected(p[i], q[i]);
+			}
+		}
+		
+		expected = uf.count();
+		cout << "\tweighted_union_find, " << names[m] << ":  " << duration << "ms, count = " << uf.count() << endl;
+	}
+	
+	int result = 0;
+	
+	// The same unions and querries, split into one batch each.
+	using site_pair = weighted_union_find::site_pair;
+	site_pair* unions = new site_pair[ops];
+	site_pair* querries = new site_pair[ops];
+	bool* answers = new bool[ops];
+	uint unionCount = 0;
+	uint queryCount = 0;
+	for(uint i = 0; i < ops; i++)
+	{
+		if(isUnion[i])
+			unions[unionCount++] = {p[i], q[i]};
+		else
+			querries[queryCount++] = {p[i], q[i]};
+	}
+	
+	{
+		weighted_union_find uf(N);
+		{
+			utilities::silent_timer Timer(duration);
+			for(uint i = 0; i < unionCount; i++)
+				uf.formUnion(unions[i].p, unions[i].q);
+			for(uint i = 0; i < queryCount; i++)
+				answers[i] = uf.connected(querries[i].p, querries[i].q);
+		}
+		
+		cout << "\tweighted_union_find, unions then querries:  " << duration << "ms, count = " << uf.count() << endl;
+	}
+	
+	{
+		weighted_union_find uf(N);
+		{
+			utilities::silent_timer Timer(duration);
+			uf.formUnions(unions, unionCount);
+			uf.connectedBatch(querries, queryCount, answers);
+		}
+		
+		cout << "\tweighted_union_find, formUnions() then connectedBatch():  " << duration << "ms, count = " << uf.count() << endl;
+		
+		// Labels have to be dense, and agree with connected().
+		const uint* labels = uf.components();
+		uint maxLabel = 0;
+		for(uint i = 0; i < N; i++)
+			maxLabel = labels[i] > maxLabel ? labels[i] : maxLabel;
+		
+		bool agree = maxLabel + 1 == uf.count();
+		for(uint i = 0; i < queryCount && agree; i++)
+			agree = answers[i] == (labels[querries[i].p] == labels[querries[i].q]);
+		
+		if(uf.count() != expected || agree == false)
+		{
+			cerr << "Batched weighted_union_find disagrees with the single operations." << endl;
+			result = -1;
+		}
+	}
+	
+	{
+		weighted_union_find64 uf(N);
+		{
+			utilities::silent_timer Timer(duration);
+			for(uint i = 0; i < unionCount; i++)
+				uf.formUnion(unions[i].p, unions[i].q);
+		}
+		
+		cout << "\tweighted_union_find64, unions:  " << duration << "ms, count = " << uf.count() << endl;
+		if(uf.count() != expected)
+		{
+			cerr << "weighted_union_find64 count " << uf.count() << " differs from expected " << expected << "." << endl;
+			result = -1;
+		}
+	}
+	
+	delete[] unions;
+	delete[] querries;
+	delete[] answers;
+	
+	for(uint threadCount = 1; threadCount <= 16; threadCount *= 2)
+	{
+		concurrent_union_find cuf(N);
+		thread* threads = new thread[threadCount];
+		{
+			utilities::silent_timer Timer(duration);
+			for(uint t = 0; t < threadCount; t++)
+			{
+				uint begin = (ulong)ops * t / threadCount;
+				uint end = (ulong)ops * (t + 1) / threadCount;
+				threads[t] = thread([&cuf, p, q, isUnion, begin, end]()
+				{
+					for(uint i = begin; i < end; i++)
+					{
+						if(isUnion[i])
+							cuf.formUnion(p[i], q[i]);
+						else
+							cuf.connected(p[i], q[i]);
+					}
+				});
+			}
+			
+			for(uint t = 0; t < threadCount; t++)
+				threads[t].join();
+		}
+		
+		delete[] threads;
+		cout << "\tconcurrent_union_find, " << threadCount << " thread(s):  " << duration << "ms, count = " << cuf.count() << endl;
+		if(cuf.count() != expected)
+		{
+			cerr << "concurrent_union_find count " << cuf.count() << " differs from expected " << expected << "." << endl;
+			result = -1;
+		}
+	}
+	
+	cout << endl;
+	
+	delete[] p;
+	delete[] q;
+	delete[] isUnion;
+	
+	return result;
+}
+
+/*
+ * Matches random tokens against the RE-s of read_tokens, with the lazy DFA, with the DFS per
+ * character, and with a lazy DFA too small to hold more than a few states, flushing often.  All
+ * three have to agree.  Then times the first two on the same tokens.
+*/
+
+int test_lazy_dfa()
+{
+	using namespace algorithms;
+	
+	const string res[] = {"(-?[[:digit:]]+.?[[:digit:]]*((e|E)-?[[:digit:]]{1,3})?)", "(-?[[:digit:]]+)", "(->)"};
+	const string alphabet = "0123456789-.eE>x";
+	const uint tokens = 200000;
+	
+	std::mt19937 generator(11);
+	std::uniform_int_distribution<uint> length(0, 12);
+	std::uniform_int_distribution<uint> character(0, alphabet.size() - 1);
+	
+	string* text = new string[tokens];
+	for(uint i = 0; i < tokens; i++)
+	{
+		if(i % 64 == 0)
+		{
+			text[i] = "->";
+			continue;
+		}
+		
+		// Mostly digits, so that a fair share of the tokens match.
+		uint n = length(generator);
+		for(uint j = 0; j < n; j++)
+		{
+			uint c = character(generator);
+			text[i] += alphabet[c < 12 ? c % 10 : c];
+		}
+	}
+	
+	int result = 0;
+	cout << "NFA, " << tokens << " random tokens:" << endl;
+	
+	for(const string& re : res)
+	{
+		NFA lazy(re);
+		NFA dfs(re);
+		NFA tiny(re);
+		lazy.setBackend(NFA::LAZY_DFA);
+		dfs.setBackend(NFA::DFS);
+		tiny.setBackend(NFA::LAZY_DFA);
+		tiny.dfaBudget(0);
+		
+		uint matches = 0;
+		for(uint i = 0; i < tokens; i++)
+		{
+			bool expected = dfs.recognizes(text[i]);
+			if(lazy.recognizes(text[i]) != expected || tiny.recognizes(text[i]) != expected)
+			{
+				cerr << "The lazy DFA of " << re << " disagrees with the NFA on \"" << text[i] << "\"." << endl;
+				result = -1;
+				break;
+			}
+			
+			matches += expected ? 1 : 0;
+		}
+		
+		int lazy_duration = 0;
+		int dfs_duration = 0;
+		uint lazy_matches = 0;
+		uint dfs_matches = 0;
+		{
+			utilities::silent_timer Timer(lazy_duration);
+			for(uint i = 0; i < tokens; i++)
+				lazy_matches += lazy.recognizes(text[i]) ? 1 : 0;
+		}
+		{
+			utilities::silent_timer Timer(dfs_duration);
+			for(uint i = 0; i < tokens; i++)
+				dfs_matches += dfs.recognizes(text[i]) ? 1 : 0;
+		}
+		
+		if(lazy_matches != matches || dfs_matches != matches)
+			result = -1;
+		
+		cout << "\t" << re << ":  " << matches << " matches, lazy DFA " << lazy_duration << "ms (" << lazy.dfa()->states() << " states, "
+			<< lazy.dfa()->used() << " bytes), DFS " << dfs_duration << "ms, " << tiny.dfa()->flushes() << " flushes at budget 0" << endl;
+	}
+	
+	cout << endl;
+	delete[] text;
+	
+	return result;
+}
+
+/*
+ * Compiles the RE-s of read_tokens and readNumber into minimal DFA-s, and matches random tokens,
+ * with metacharacters and escapes mixed in, against the DFA, the DFA reloaded from its blob, and
+ * the NFA sanitizing its input.  All three have to agree.  Then times NFA construction against
+ * loading the blob, and matching.
+*/
+
+int test_dfa()
+{
+	using namespace algorithms;
+	
+	const string res[] = {"(-?[[:digit:]]+.?[[:digit:]]*((e|E)-?[[:digit:]]{1,3})?)", "(-?[[:digit:]]+)", "(->)", "(-?[[:digit:]]{1,20})"};
+	const string alphabet = "0123456789-.eE>x(*|\\";
+	const uint tokens = 200000;
+	const uint constructions = 1000;
+	
+	std::mt19937 generator(13);
+	std::uniform_int_distribution<uint> length(0, 24);
+	std::uniform_int_distribution<uint> character(0, 2 * alphabet.size() - 1);
+	
+	string* text = new string[tokens];
+	for(uint i = 0; i < tokens; i++)
+	{
+		if(i % 64 == 0)
+		{
+			text[i] = "->";
+			continue;
+		}
+		
+		// Half of the characters are digits.
+		uint n = length(generator);
+		for(uint j = 0; j < n; j++)
+		{
+			uint c = character(generator);
+			text[i] += c < alphabet.size() ? alphabet[c] : alphabet[c % 10];
+		}
+	}
+	
+	int result = 0;
+	cout << "DFA, " << tokens << " random tokens:" << endl;
+	
+	for(const string& re : res)
+	{
+		NFA nfa(re);
+		nfa.setBackend(NFA::DFS);
+		DFA dfa(nfa);
+		string blob = dfa.save();
+		DFA loaded(blob.data(), blob.size());
+		if(dfa.ready() == false || loaded.ready() == false || loaded.save() != blob || DFA(re).save() != blob)
+		{
+			cerr << "The DFA of " << re << " failed to compile, or to load from its blob." << endl;
+			result = -1;
+			continue;
+		}
+		
+		uint matches = 0;
+		for(uint i = 0; i < tokens; i++)
+		{
+			bool expected = nfa.recognizes(text[i]);
+			if(dfa.recognizes(text[i]) != expected || loaded.recognizes(text[i]) != expected)
+			{
+				cerr << "The DFA of " << re << " disagrees with the NFA on \"" << text[i] << "\"." << endl;
+				result = -1;
+				break;
+			}
+			
+			matches += expected ? 1 : 0;
+		}
+		
+		int compile_duration = 0;
+		int load_duration = 0;
+		int match_duration = 0;
+		uint dfa_matches = 0;
+		{
+			utilities::silent_timer Timer(compile_duration);
+			for(uint i = 0; i < constructions; i++)
+			{
+				NFA constructed(re);
+				dfa_matches += constructed.ready() ? 0 : 1;
+			}
+		}
+		{
+			utilities::silent_timer Timer(load_duration);
+			for(uint i = 0; i < constructions; i++)
+			{
+				DFA constructed(blob.data(), blob.size());
+				dfa_matches += constructed.ready() ? 0 : 1;
+			}
+		}
+		{
+			utilities::silent_timer Timer(match_duration);
+			for(uint i = 0; i < tokens; i++)
+				dfa_matches += dfa.recognizes(text[i]) ? 1 : 0;
+		}
+		
+		if(dfa_matches != matches)
+			result = -1;
+		
+		cout << "\t" << re << ":  " << matches << " matches, " << dfa.states() << " states, " << dfa.classes() << " byte classes, "
+			<< blob.size() << " byte blob, " << match_duration << "ms to match; " << constructions << " constructions:  NFA "
+			<< compile_duration << "ms, DFA from blob " << load_duration << "ms" << endl;
+	}
+	
+	cout << endl;
+	delete[] text;
+	
+	return result;
+}
+
+/*
+ * Tokenizes a line of well and malformed numbers with read_tokens, against the rule it has always had:  a run of the
+ * characters of a real has to match the real RE as a whole, else it is a string, and an integer is only taken if no
+ * '.', 'e' or 'E' follows it.
+*/
+
+int test_token_rule()
+{
+	using namespace algorithms;
+	
+	struct token_case
+	{
+		read_tokens::tokenType type;
+		string text;
+		double value;
+	};
+	
+	const token_case cases[] = {{read_tokens::INT, "42", 42}, {read_tokens::INT, "-7", -7}, {read_tokens::REAL, "1.5", 1.5},
+		{read_tokens::STRING, "1e1234", 0}, {read_tokens::STRING, "3.0e", 0}, {read_tokens::STRING, "1.5.3", 0},
+		{read_tokens::INT, "12", 12}, {read_tokens::STRING, "abc", 0}, {read_tokens::OPERATOR, "->", 0},
+		{read_tokens::STRING, "-", 0}, {read_tokens::REAL, "4.", 4}, {read_tokens::REAL, "2.5e-3", 2.5e-3},
+		{read_tokens::INT, "1", 1}, {read_tokens::INT, "-2", -2}, {read_tokens::REAL, "1e5", 1e5}, {read_tokens::STRING, "x", 0},
+		{read_tokens::STRING, "1.5-2", 0}, {read_tokens::STRING, "-.5", 0}};
+	
+	const string filename = "token-rule.txt";
+	{
+		ofstream out(filename, std::ios_base::trunc);
+		out << "42 -7 1.5 1e1234 3.0e 1.5.3 12abc -> - 4. 2.5e-3 1-2 1e5x 1.5-2 -.5" << endl;
+	}
+	
+	int result = 0;
+	read_tokens tokens(filename, ' ');
+	for(const token_case& t : cases)
+	{
+		read_tokens::tokenType type = tokens.nextToken();
+		bool same = type == t.type;
+		if(same == true && type == read_tokens::INT)
+			same = tokens.getIntToken() == (int)t.value;
+		else if(same == true && type == read_tokens::REAL)
+			same = tokens.getRealToken() == t.value;
+		else if(same == true && type == read_tokens::STRING)
+			same = tokens.getStrToken() == t.text;
+		else if(same == true && type == read_tokens::OPERATOR)
+			same = tokens.getOpToken() == t.text;
+		
+		if(same == false)
+		{
+			cerr << "read_tokens read \"" << t.text << "\" as " << tokens.str(type) << "." << endl;
+			result = -1;
+		}
+	}
+	
+	std::remove(filename.c_str());
+	
+	cout << "Token rule, " << sizeof(cases) / sizeof(cases[0]) << " tokens:  " << (result == 0 ? "OK" : "wrong") << endl << endl;
+	
+	return result;
+}
+
+/*
+ * Matches random tokens against RE-s of growing size with each NFA backend:  BIT_PARALLEL (one
+ * word, then several), LAZY_DFA and DFS.  All have to agree, and NFA has to select BIT_PARALLEL
+ * on its own exactly when the states fit.  Then times the backends.
+*/
+
+int test_bit_parallel()
+{
+	using namespace algorithms;
+	
+	const string res[] = {"(->)", "(-?[[:digit:]]+)", "(-?[[:digit:]]+.?[[:digit:]]*((e|E)-?[[:digit:]]{1,3})?)", "(-?[[:digit:]]{1,20})",
+		"(-?[[:digit:]]{1,40})"};
+	const string alphabet = "0123456789-.eE>x";
+	const uint tokens = 200000;
+	
+	std::mt19937 generator(17);
+	std::uniform_int_distribution<uint> length(0, 30);
+	std::uniform_int_distribution<uint> character(0, alphabet.size() - 1);
+	
+	string* text = new string[tokens];
+	for(uint i = 0; i < tokens; i++)
+	{
+		if(i % 64 == 0)
+		{
+			text[i] = "->";
+			continue;
+		}
+		
+		// Mostly digits, so that a fair share of the tokens match.
+		uint n = length(generator);
+		for(uint j = 0; j < n; j++)
+		{
+			uint c = character(generator);
+			text[i] += alphabet[c < 12 ? c % 10 : c];
+		}
+	}
+	
+	int result = 0;
+	cout << "NFA backends, " << tokens << " random tokens:" << endl;
+	
+	for(const string& re : res)
+	{
+		NFA bits(re);
+		NFA lazy(re);
+		NFA dfs(re);
+		bool fits = bits.states() <= bit_parallel::max_states;
+		if((bits.getBackend() == NFA::BIT_PARALLEL) != fits || (fits == false && bits.getBackend() != NFA::LAZY_DFA))
+		{
+			cerr << "NFA selected the wrong backend for " << bits.states() << " states." << endl;
+			result = -1;
+		}
+		
+		lazy.setBackend(NFA::LAZY_DFA);
+		dfs.setBackend(NFA::DFS);
+		
+		uint matches = 0;
+		for(uint i = 0; i < tokens; i++)
+		{
+			bool expected = dfs.recognizes(text[i]);
+			if(bits.recognizes(text[i]) != expected || lazy.recognizes(text[i]) != expected)
+			{
+				cerr << "The backends of " << re << " disagree on \"" << text[i] << "\"." << endl;
+				result = -1;
+				break;
+			}
+			
+			matches += expected ? 1 : 0;
+		}
+		
+		NFA* backends[] = {&bits, &lazy, &dfs};
+		int durations[] = {0, 0, 0};
+		for(uint b = 0; b < 3; b++)
+		{
+			uint count = 0;
+			{
+				utilities::silent_timer Timer(durations[b]);
+				for(uint i = 0; i < tokens; i++)
+					count += backends[b]->recognizes(text[i]) ? 1 : 0;
+			}
+			
+			if(count != matches)
+				result = -1;
+		}
+		
+		cout << "\t" << re << ", " << bits.states() << " states:  " << matches << " matches, "
+			<< (fits ? "BIT_PARALLEL " : "(no BIT_PARALLEL) ") << durations[0] << "ms, LAZY_DFA " << durations[1] << "ms, DFS " << durations[2] << "ms" << endl;
+	}
+	
+	cout << endl;
+	delete[] text;
+	
+	return result;
+}
+
+int test_nfa_find()
+{
+	using namespace algorithms;
+	
+	const string res[] = {"(-?[[:digit:]]+)", "([[:alpha:]]+)", "(a*b?)", "(xy*z)"};
+	const string alphabet = "abcxyz-019 ";
+	const uint texts = 2000;
+	
+	std::mt19937 generator(23);
+	std::uniform_int_distribution<uint> length(0, 24);
+	std::uniform_int_distribution<uint> character(0, alphabet.size() - 1);
+	
+	string* text = new string[texts];
+	for(uint i = 0; i < texts; i++)
+	{
+		uint n = length(generator);
+		for(uint j = 0; j < n; j++)
+			text[i] += alphabet[character(generator)];
+	}
+	
+	int result = 0;
+	cout << "NFA search, " << texts << " random texts:" << endl;
+	
+	for(const string& re : res)
+	{
+		NFA nfa(re);
+		NFA::arspan found;
+		NFA::match_span span;
+		uint total = 0;
+		for(uint i = 0; i < texts && result == 0; i++)
+		{
+			// Leftmost-longest the slow way:  try every substring, leftmost start and longest end first.
+			const string& s = text[i];
+			uint from = 0;
+			uint count = 0;
+			nfa.find_all(s, found);
+			while(from <= s.size())
+			{
+				uint begin = from, end = 0;
+				bool matched = false;
+				for(; begin <= s.size() && matched == false; begin++)
+					for(end = s.size() + 1; end-- > begin && matched == false;)
+						matched = nfa.recognizes(s.substr(begin, end - begin));
+				
+				if(matched == false)
+					break;
+				
+				begin--;
+				end++;
+				if(count >= found.size() || found[count].begin != begin || found[count].end != end)
+				{
+					cerr << "NFA::find_all(" << re << ") is wrong on \"" << s << "\", match " << count << "." << endl;
+					result = -1;
+					break;
+				}
+				
+				if(count == 0 && (nfa.find(s, span) == false || span.begin != begin || span.end != end))
+				{
+					cerr << "NFA::find(" << re << ") is wrong on \"" << s << "\"." << endl;
+					result = -1;
+				}
+				
+				count++;
+				from = end > begin ? end : end + 1;
+			}
+			
+			if(result == 0 && count != found.size())
+			{
+				cerr << "NFA::find_all(" << re << ") found " << found.size() << " matches in \"" << s << "\", not " << count << "." << endl;
+				result = -1;
+			}
+			
+			total += count;
+		}
+		
+		// The same over lines, streamed.
+		containers::array<line> lines(texts);
+		for(uint i = 0; i < texts; i++)
+		{
+			line l;
+			l.set(text[i].c_str(), text[i].size());
+			lines.add(l);
+		}
+		
+		uint streamed = 0;
+		int duration = 0;
+		{
+			utilities::silent_timer Timer(duration);
+			line_matcher matcher(nfa, lines.cbegin(), lines.cend());
+			while(matcher.next() == true)
+				streamed++;
+		}
+		
+		if(streamed != total)
+		{
+			cerr << "line_matcher found " << streamed << " matches of " << re << ", not " << total << "." << endl;
+			result = -1;
+		}
+		
+		cout << "\t" << re << ":  " << total << " matches, line_matcher " << duration << "ms" << endl;
+	}
+	
+	cout << endl;
+	delete[] text;
+	
+	return result;
+}
+
+int test_pattern_set()
+{
+	using namespace algorithms;
+	
+	const string res[] = {"(-?[[:digit:]]+)", "(-?[[:digit:]]+.?[[:digit:]]*((e|E)-?[[:digit:]]{1,3})?)", "(->)", "([[:alpha:]]+)", "(0x[[:hex:]]+)"};
+	const uint count = sizeof(res) / sizeof(res[0]);
+	const string alphabet = "0123456789-.eE>xab";
+	const uint tokens = 200000;
+	
+	std::mt19937 generator(29);
+	std::uniform_int_distribution<uint> length(0, 12);
+	std::uniform_int_distribution<uint> character(0, alphabet.size() - 1);
+	
+	string* text = new string[tokens];
+	for(uint i = 0; i < tokens; i++)
+	{
+		uint n = length(generator);
+		for(uint j = 0; j < n; j++)
+			text[i] += alphabet[character(generator)];
+	}
+	
+	int result = 0;
+	cout << "Pattern set of " << count << " RE-s, " << tokens << " random tokens:" << endl;
+	
+	// The alpha RE has the highest priority, the rest go by the order added.
+	pattern_set set;
+	DFA* dfas[count];
+	for(uint k = 0; k < count; k++)
+	{
+		dfas[k] = new DFA(res[k]);
+		if(set.add(res[k], k == 3 ? 1 : 0) != k)
+			result = -1;
+	}
+	
+	if(set.compile() == false || result != 0)
+	{
+		cerr << "Failed to compile the pattern set." << endl;
+		result = -1;
+	}
+	
+	uint matched = 0;
+	for(uint i = 0; i < tokens && result == 0; i++)
+	{
+		const string& s = text[i];
+		
+		// The slow way:  each DFA on its own, on the whole token and on every prefix.
+		ulong mask = 0;
+		uint winner = pattern_set::none;
+		uint best = pattern_set::none;
+		uint bestLength = 0;
+		for(uint k = 0; k < count; k++)
+		{
+			if(dfas[k]->recognizes(s) == true)
+			{
+				mask |= 1ul << k;
+				if(winner == pattern_set::none || k == 3)
+					winner = k;
+			}
+			
+			for(uint n = 0; n <= s.size(); n++)
+			{
+				if(dfas[k]->recognizes(s.substr(0, n)) == false)
+					continue;
+				
+				if(best == pattern_set::none || n > bestLength || (n == bestLength && k == 3))
+				{
+					best = k;
+					bestLength = n;
+				}
+			}
+		}
+		
+		uint longest = 0;
+		uint found = set.longest(s, longest);
+		if(set.matches(s) != mask || set.match(s) != winner || found != best || (best != pattern_set::none && longest != bestLength))
+		{
+			cerr << "The pattern set is wrong on \"" << s << "\"." << endl;
+			result = -1;
+		}
+		
+		matched += winner != pattern_set::none ? 1 : 0;
+	}
+	
+	int durations[] = {0, 0};
+	uint counts[] = {0, 0};
+	{
+		utilities::silent_timer Timer(durations[0]);
+		for(uint i = 0; i < tokens; i++)
+			counts[0] += set.match(text[i]) != pattern_set::none ? 1 : 0;
+	}
+	
+	{
+		utilities::silent_timer Timer(durations[1]);
+		for(uint i = 0; i < tokens; i++)
+		{
+			bool any = false;
+			for(uint k = 0; k < count; k++)
+				any = dfas[k]->recognizes(text[i]) || any;
+			
+			counts[1] += any ? 1 : 0;
+		}
+	}
+	
+	if(counts[0] != matched || counts[1] != matched)
+		result = -1;
+	
+	cout << "\t" << set.states() << " states, " << set.classes() << " byte classes:  " << matched << " matches, one pass "
+		<< durations[0] << "ms, " << count << " DFAs " << durations[1] << "ms" << endl << endl;
+	
+	for(uint k = 0; k < count; k++)
+		delete dfas[k];
+	
+	delete[] text;
+	
+	return result;
+}
+
+int test_prefilter()
+{
+	using namespace algorithms;
+	
+	// A large text of words, with the odd number and arrow in it, as a whole, and its first lines as lines.
+	const uint size = 1u << 24;
+	const string words[] = {"the", "graph", "vertex", "edge", "weight", "path", "cycle", "tree", "order", "search"};
+	std::mt19937 generator(31);
+	std::uniform_int_distribution<uint> word(0, 9);
+	std::uniform_int_distribution<uint> rare(0, 999);
+	
+	string text;
+	text.reserve(size + 64);
+	containers::array<line> lines;
+	uint lineStart = 0;
+	while(text.size() < size)
+	{
+		uint r = rare(generator);
+		if(r == 0)
+			text += std::to_string(generator() % 100000);
+		else if(r == 1)
+			text += "->";
+		else
+			text += words[word(generator)];
+		
+		text += r % 16 == 0 ? '\n' : ' ';
+		if(text.back() == '\n' && lines.size() < 2000)
+		{
+			line l;
+			l.set(text.c_str() + lineStart, text.size() - 1 - lineStart);
+			lines.add(l);
+			lineStart = text.size();
+		}
+	}
+	
+	const string res[] = {"([[:digit:]]+)", "(-?[[:digit:]]+.?[[:digit:]]*)", "(->)", "(c[[:alpha:]]*e)", "(x[[:digit:]]*)"};
+	
+	int result = 0;
+	cout << "NFA prefilter, " << (text.size() >> 20) << "MB of text, and " << lines.size() << " lines of it:" << endl;
+	
+	for(const string& re : res)
+	{
+		NFA nfa(re);
+		const prefilter* filter = nfa.filter();
+		NFA::arspan spans[2];
+		int durations[2][2] = {{0, 0}, {0, 0}};
+		uint streamed[2] = {0, 0};
+		for(uint on = 0; on < 2; on++)
+		{
+			nfa.setPrefilter(on == 1);
+			{
+				utilities::silent_timer Timer(durations[on][0]);
+				nfa.find_all(text, spans[on]);
+			}
+			
+			{
+				utilities::silent_timer Timer(durations[on][1]);
+				line_matcher matcher(nfa, lines.cbegin(), lines.cend());
+				while(matcher.next() == true)
+					streamed[on]++;
+			}
+		}
+		
+		bool same = spans[0].size() == spans[1].size() && streamed[0] == streamed[1];
+		for(uint i = 0; i < spans[0].size() && same == true; i++)
+			same = spans[0][i].begin == spans[1][i].begin && spans[0][i].end == spans[1][i].end;
+		
+		// Anchored matching of the words, with and without.
+		for(uint i = 0; i < 10 && same == true; i++)
+		{
+			nfa.setPrefilter(false);
+			bool expected = nfa.recognizes(words[i]);
+			nfa.setPrefilter(true);
+			same = nfa.recognizes(words[i]) == expected;
+		}
+		
+		if(same == false)
+		{
+			cerr << "The prefilter changes the matches of " << re << "." << endl;
+			result = -1;
+		}
+		
+		cout << "\t" << re << ":  " << spans[1].size() << " matches, leading class of " << filter->leading() << " bytes, ";
+		if(filter->required() != prefilter::none)
+			cout << "requires '" << (char)filter->required() << "', ";
+		
+		cout << "find_all " << durations[0][0] << "ms -> " << durations[1][0] << "ms, line_matcher "
+			<< durations[0][1] << "ms -> " << durations[1][1] << "ms" << endl;
+	}
+	
+	cout << endl;
+	
+	return result;
+}
+
+// The character class dispatch NFA used before its bit maps:  a member function pointer per class, and a linear
+// scan over the ranges for user ranges.  Kept here to benchmark against.
+class class_dispatch
+{
+	using FP = bool (class_dispatch::*)(const char&) const;
+	
+	struct range
+	{
+		int rangeID;
+		char begin;
+		char end;
+	};
+	
+	FP _fp[3] = {&class_dispatch::_isDigit, &class_dispatch::_isAlpha, &class_dispatch::_isSpace};
+	range _ranges[4] = {{-80, 'a', 'f'}, {-80, 'x', 'z'}, {-79, '0', '9'}, {-79, '_', '_'}};
+	
+	bool _isDigit(const char& c) const { return c >= 48 && c <= 57; }
+	bool _isAlpha(const char& c) const { return c >= 97 && c <= 122; }
+	bool _isSpace(const char& c) const { return c == 32 || (c >= 9 && c <= 13); }
+
+public:
+	bool matches(const char& text, const char& re) const
+	{
+		if(re >= -99 && re <= -97)
+			return (this->*_fp[re + 99])(text);
+		
+		bool test = false;
+		for(const range& r : _ranges)
+		{
+			if(r.rangeID != re)
+				continue;
+			
+			if(text >= r.begin and text <= r.end)
+			{
+				test = true;
+				break;
+			}
+		}
+		
+		return test;
+	}
+};
+
+int test_char_sets()
+{
+	using namespace algorithms;
+	
+	struct set_case
+	{
+		string re;
+		bool (*member)(int);
+	};
+	
+	const set_case cases[] = {
+		{"([a-fx-z_])", [](int c) { return (c >= 'a' && c <= 'f') || (c >= 'x' && c <= 'z') || c == '_'; }},
+		{"([^[:space:],])", [](int c) { return c < 128 && !(c == ' ' || (c >= 9 && c <= 13) || c == ','); }},
+		{"([[:digit:].])", [](int c) { return (c >= '0' && c <= '9') || c == '.'; }},
+		{"([[:space:]])", [](int c) { return c == ' ' || (c >= 9 && c <= 13); }},
+		{"([[:punct:]])", [](int c) { return c < 128 && std::ispunct(c) != 0; }},
+		{"([\\]\\-])", [](int c) { return c == ']' || c == '-'; }},
+		{"(a-f)", [](int c) { return c >= 'a' && c <= 'f'; }},
+		{"(^a-f)", [](int c) { return !(c >= 'a' && c <= 'f'); }},
+	};
+	
+	int result = 0;
+	cout << "NFA character sets:" << endl;
+	
+	for(const set_case& test : cases)
+	{
+		NFA nfa(test.re);
+		uint members = 0;
+		for(uint c = 1; c < 256; c++)
+		{
+			bool expected = test.member(c);
+			if(nfa.recognizes(string(1, (char)c)) != expected)
+			{
+				cerr << "NFA " << test.re << " is wrong on byte " << c << "." << endl;
+				result = -1;
+				break;
+			}
+			
+			members += expected ? 1 : 0;
+		}
+		
+		cout << "\t" << test.re << ":  " << members << " bytes" << endl;
+	}
+	
+	NFA words("([a-z_][a-z_[:digit:]]*)");
+	if(words.recognizes("snake_case_1") == false || words.recognizes("1snake") == true)
+	{
+		cerr << "NFA ([a-z_][a-z_[:digit:]]*) is wrong." << endl;
+		result = -1;
+	}
+	
+	// Per character tests, the old dispatch against a bit lookup.
+	const uint tests = 1u << 24;
+	const char tokens[] = {-99, -98, -97, -80, -79};
+	ulong bits[5][4] = {};
+	class_dispatch dispatch;
+	for(uint t = 0; t < 5; t++)
+		for(uint b = 0; b < 256; b++)
+			if(dispatch.matches((char)b, tokens[t]) == true)
+				bits[t][b >> 6] |= 1ul << (b & 63);
+	
+	std::mt19937 generator(37);
+	uchar* text = new uchar[tests];
+	for(uint i = 0; i < tests; i++)
+		text[i] = generator() & 127;
+	
+	int durations[] = {0, 0};
+	uint counts[] = {0, 0};
+	{
+		utilities::silent_timer Timer(durations[0]);
+		for(uint i = 0; i < tests; i++)
+			counts[0] += dispatch.matches(text[i], tokens[i % 5]) ? 1 : 0;
+	}
+	
+	{
+		utilities::silent_timer Timer(durations[1]);
+		for(uint i = 0; i < tests; i++)
+			counts[1] += (bits[i % 5][text[i] >> 6] >> (text[i] & 63)) & 1;
+	}
+	
+	if(counts[0] != counts[1])
+	{
+		cerr << "The class bit maps disagree with the dispatch." << endl;
+		result = -1;
+	}
+	
+	cout << "\t" << tests << " class tests:  function pointers and range scans " << durations[0] << "ms, bit maps " << durations[1] << "ms" << endl << endl;
+	delete[] text;
+	
+	return result;
+}
+
+int test_nfa_matcher()
+{
+	using namespace algorithms;
+	
+	const string res[] = {"(-?[[:digit:]]+.?[[:digit:]]*((e|E)-?[[:digit:]]{1,3})?)", "(-?[[:digit:]]{1,40})"};
+	const string alphabet = "0123456789-.eE>x";
+	const uint tokens = 400000;
+	const uint threads = std::max(2u, std::min(8u, std::thread::hardware_concurrency()));
+	
+	std::mt19937 generator(41);
+	std::uniform_int_distribution<uint> length(0, 30);
+	std::uniform_int_distribution<uint> character(0, alphabet.size() - 1);
+	
+	string* text = new string[tokens];
+	for(uint i = 0; i < tokens; i++)
+	{
+		uint n = length(generator);
+		for(uint j = 0; j < n; j++)
+		{
+			uint c = character(generator);
+			text[i] += alphabet[c < 12 ? c % 10 : c];
+		}
+	}
+	
+	int result = 0;
+	cout << "NFA programs shared by " << threads << " threads, " << tokens << " random tokens:" << endl;
+	
+	for(const string& re : res)
+	{
+		NFA nfa(re);
+		uint expected = 0;
+		for(uint i = 0; i < tokens; i++)
+			expected += nfa.recognizes(text[i]) ? 1 : 0;
+		
+		// Each thread compiles the RE anew, or matches the shared program.
+		int durations[] = {0, 0};
+		uint counts[2][8] = {};
+		for(uint shared = 0; shared < 2; shared++)
+		{
+			utilities::silent_timer Timer(durations[shared]);
+			std::thread* workers[8];
+			for(uint t = 0; t < threads; t++)
+			{
+				workers[t] = new std::thread([&, t, shared]()
+				{
+					NFA* own = shared == 0 ? new NFA(re) : nullptr;
+					nfa_matcher matcher(shared == 0 ? *own : nfa);
+					for(uint i = t; i < tokens; i += threads)
+						counts[shared][t] += matcher.recognizes(text[i]) ? 1 : 0;
+					
+					delete own;
+				});
+			}
+			
+			for(uint t = 0; t < threads; t++)
+			{
+				workers[t]->join();
+				delete workers[t];
+			}
+		}
+		
+		for(uint shared = 0; shared < 2; shared++)
+		{
+			uint count = 0;
+			for(uint t = 0; t < threads; t++)
+				count += counts[shared][t];
+			
+			if(count != expected)
+			{
+				cerr << "nfa_matcher found " << count << " matches of " << re << ", not " << expected << "." << endl;
+				result = -1;
+			}
+		}
+		
+		cout << "\t" << re << ", " << nfa.states() << " states:  " << expected << " matches, compiled per thread "
+			<< durations[0] << "ms, shared " << durations[1] << "ms" << endl;
+	}
+	
+	// A matcher keeps the program after its NFA is gone.
+	nfa_matcher* matcher = nullptr;
+	{
+		NFA nfa("(->)");
+		matcher = new nfa_matcher(nfa);
+		if(nfa.program()->references() != 2)
+			result = -1;
+	}
+	
+	if(matcher->program()->references() != 1 || matcher->recognizes("->") == false || matcher->recognizes("-") == true)
+	{
+		cerr << "nfa_matcher lost its program." << endl;
+		result = -1;
+	}
+	
+	delete matcher;
+	delete[] text;
+	cout << endl;
+	
+	return result;
+}
+
+// The UTF-8 encoding of a code point, appended to text.
+static void append_utf8(string& text, const uint& cp)
+{
+	if(cp < 0x80)
+		text += (char)cp;
+	else if(cp < 0x800)
+	{
+		text += (char)(0xC0 | (cp >> 6));
+		text += (char)(0x80 | (cp & 0x3F));
+	}
+	else if(cp < 0x10000)
+	{
+		text += (char)(0xE0 | (cp >> 12));
+		text += (char)(0x80 | ((cp >> 6) & 0x3F));
+		text += (char)(0x80 | (cp & 0x3F));
+	}
+	else
+	{
+		text += (char)(0xF0 | (cp >> 18));
+		text += (char)(0x80 | ((cp >> 12) & 0x3F));
+		text += (char)(0x80 | ((cp >> 6) & 0x3F));
+		text += (char)(0x80 | (cp & 0x3F));
+	}
+}
+
+int test_nfa_utf8()
+{
+	using namespace algorithms;
+	
+	struct utf8_case
+	{
+		string re;
+		string text;
+		bool expected;
+	};
+	
+	const utf8_case cases[] = {
+		{"(café)", "café", true}, {"(xé*y)", "xéééy", true}, {"(xé?y)", "xééy", false}, {"(é{2,3})", "éééé", false},
+		{"([^a])", "é", true}, {"([^a])", "\xc3", false}, {"([^a])", "😀", true}, {"(x[é-ĉ]y)", "xĀy", true},
+		{"(x[é-ĉ]y)", "xèy", false}, {"([😀-🙏]+)", "😀🙏", true}, {"([😀-🙏]+)", "😀🚀", false}, {"(é{2,2})", "é", false},
+		{"(é{2,2})", "éé", true}, {"([а-я]{2,2})", "ж", false}, {"([а-я]{2,2})", "жи", true}, {"([а-я]{2,3})", "жиж", true},
+		{"([а-я]{2,3})", "жижи", false}, {"((ab){2,2})", "ab", false},
+	};
+	
+	int result = 0;
+	for(const utf8_case& test : cases)
+	{
+		NFA nfa(test.re);
+		nfa.sanitize(false);
+		DFA dfa(nfa);
+		if(nfa.recognizes(test.text) != test.expected || dfa.recognizes(test.text) != test.expected)
+		{
+			cerr << "NFA " << test.re << " is wrong on \"" << test.text << "\"." << endl;
+			result = -1;
+		}
+	}
+	
+	// Words of mixed scripts, and per script an RE of its letters, with their code points.
+	struct script
+	{
+		string name;
+		string re;
+		uint lo;
+		uint hi;
+	};
+	
+	const script scripts[] = {
+		{"Latin-1", "([à-ÿ]+)", 0xE0, 0xFF},
+		{"Greek", "([α-ω]+)", 0x3B1, 0x3C9},
+		{"Cyrillic", "([а-я]+)", 0x430, 0x44F},
+		{"CJK", "([一-龥]+)", 0x4E00, 0x9FA5},
+		{"Emoji", "([😀-🙏]+)", 0x1F600, 0x1F64F},
+	};
+	
+	const uint words = 200000;
+	std::mt19937 generator(43);
+	std::uniform_int_distribution<uint> length(1, 10);
+	std::uniform_int_distribution<uint> pick(0, 5);
+	string text;
+	for(uint i = 0; i < words; i++)
+	{
+		// Mostly one script per word, ASCII as the sixth, with a switch now and then.
+		uint s = pick(generator);
+		uint n = length(generator);
+		for(uint j = 0; j < n; j++)
+		{
+			if(generator() % 8 == 0)
+				s = pick(generator);
+			
+			if(s == 5)
+				text += (char)('a' + generator() % 26);
+			else
+				append_utf8(text, scripts[s].lo + generator() % (scripts[s].hi - scripts[s].lo + 1));
+		}
+		
+		text += ' ';
+	}
+	
+	cout << "NFA on UTF-8, " << text.size() << " bytes of " << words << " words in mixed scripts:" << endl;
+	
+	for(const script& s : scripts)
+	{
+		// The runs of the script's letters, decoding the text first.
+		int durations[] = {0, 0, 0};
+		uint expected = 0;
+		uint words_expected = 0;
+		{
+			utilities::silent_timer Timer(durations[0]);
+			bool inRun = false;
+			bool whole = true;
+			for(uint i = 0; i < text.size();)
+			{
+				uchar lead = text[i];
+				uint n = lead < 0x80 ? 1 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : 4;
+				uint cp = n == 1 ? lead : lead & (0x7F >> n);
+				for(uint k = 1; k < n; k++)
+					cp = (cp << 6) | (text[i+k] & 0x3F);
+				
+				i += n;
+				bool member = cp >= s.lo && cp <= s.hi;
+				expected += member && inRun == false ? 1 : 0;
+				inRun = member;
+				if(cp == ' ')
+				{
+					words_expected += whole ? 1 : 0;
+					whole = true;
+				}
+				else
+					whole &= member;
+			}
+		}
+		
+		NFA nfa(s.re);
+		NFA::arspan found;
+		uint count = 0;
+		{
+			utilities::silent_timer Timer(durations[1]);
+			count = nfa.find_all(text, found);
+		}
+		
+		// Whole words, one DFA lookup per byte.
+		nfa.sanitize(false);
+		DFA dfa(nfa);
+		uint wholeWords = 0;
+		{
+			utilities::silent_timer Timer(durations[2]);
+			std::string::const_iterator begin = text.cbegin();
+			for(std::string::const_iterator i = text.cbegin(); i != text.cend(); i++)
+			{
+				if(*i == ' ')
+				{
+					wholeWords += dfa.recognizes(begin, i) ? 1 : 0;
+					begin = i + 1;
+				}
+			}
+		}
+		
+		if(count != expected || wholeWords != words_expected)
+		{
+			cerr << "NFA " << s.re << " found " << count << " runs and " << wholeWords << " words, not " << expected
+				<< " and " << words_expected << "." << endl;
+			result = -1;
+		}
+		
+		double MB = text.size() / 1e6;
+		cout << "\t" << s.name << " " << s.re << ", " << nfa.states() << " states:  " << count << " runs, decoded "
+			<< durations[0] << "ms, find_all " << durations[1] << "ms (" << (uint)(MB * 1000 / std::max(durations[1], 1))
+			<< " MB/s); " << wholeWords << " words, DFA " << durations[2] << "ms (" << (uint)(MB * 1000 / std::max(durations[2], 1))
+			<< " MB/s)" << endl;
+	}
+	
+	cout << endl;
+	
+	return result;
+}
+
+int test_nfa_captures()
+{
+	using namespace algorithms;
+	
+	struct capture_case
+	{
+		string re;
+		string text;
+		string groups;			// The span of each group, '-' if unmatched, separated by ','.
+	};
+	
+	const capture_case cases[] = {
+		{"((a*)(a*))", "aaa", "aaa,aaa,"},
+		{"(x(ab)*y)", "xababy", "xababy,ab"},
+		{"(x(ab)*y)", "xy", "xy,-"},
+		{"((ab)?c)", "c", "c,-"},
+		{"((a{1,3})(a*))", "aaaa", "aaaa,aaa,a"},
+		{"((a|ab)(c|bcd)(d*))", "abcd", "abcd,a,bcd,"},
+		{"(([a-z]+)@([a-z]+))", "joe@host", "joe@host,joe,host"},
+		{"((é+)x)", "ééx", "ééx,éé"},
+	};
+	
+	int result = 0;
+	for(const capture_case& test : cases)
+	{
+		NFA nfa(test.re);
+		NFA::arspan groups;
+		string found;
+		if(nfa.match(test.text, groups) == true)
+		{
+			for(uint k = 0; k < groups.size(); k++)
+			{
+				found += k > 0 ? "," : "";
+				if(groups[k].begin == pike_vm::unmatched)
+					found += "-";
+				else
+					found += test.text.substr(groups[k].begin, groups[k].end - groups[k].begin);
+			}
+		}
+		
+		if(found != test.groups)
+		{
+			cerr << "NFA::match(" << test.re << ") on \"" << test.text << "\" found " << found << ", not " << test.groups << "." << endl;
+			result = -1;
+		}
+	}
+	
+	// Real numbers, their parts known:  the integer part, the fraction and the exponent.
+	const string re = "(-?([[:digit:]]+).?([[:digit:]]*)((e|E)(-?[[:digit:]]{1,3}))?)";
+	const uint tokens = 200000;
+	std::mt19937 generator(47);
+	string* text = new string[tokens];
+	uint (*parts)[3][2] = new uint[tokens][3][2];
+	for(uint i = 0; i < tokens; i++)
+	{
+		string& t = text[i];
+		t += generator() % 2 == 0 ? "-" : "";
+		parts[i][0][0] = t.size();
+		for(uint n = 1 + generator() % 8; n > 0; n--)
+			t += (char)('0' + generator() % 10);
+		
+		parts[i][0][1] = t.size();
+		t += generator() % 2 == 0 ? "." : "";
+		parts[i][1][0] = t.size();
+		for(uint n = t.back() == '.' ? generator() % 7 : 0; n > 0; n--)
+			t += (char)('0' + generator() % 10);
+		
+		parts[i][1][1] = t.size();
+		parts[i][2][0] = parts[i][2][1] = pike_vm::unmatched;
+		if(generator() % 2 == 0)
+		{
+			t += generator() % 2 == 0 ? "e" : "E";
+			parts[i][2][0] = t.size();
+			t += generator() % 2 == 0 ? "-" : "";
+			for(uint n = 1 + generator() % 3; n > 0; n--)
+				t += (char)('0' + generator() % 10);
+			
+			parts[i][2][1] = t.size();
+		}
+	}
+	
+	NFA nfa(re);
+	NFA::arspan groups;
+	int durations[] = {0, 0, 0};
+	uint counts[] = {0, 0, 0};
+	{
+		utilities::silent_timer Timer(durations[0]);
+		for(uint i = 0; i < tokens; i++)
+			counts[0] += nfa.recognizes(text[i]) ? 1 : 0;
+	}
+	
+	{
+		utilities::silent_timer Timer(durations[1]);
+		for(uint i = 0; i < tokens; i++)
+		{
+			if(nfa.match(text[i], groups) == false)
+				continue;
+			
+			const uint group[] = {1, 2, 5};
+			bool right = true;
+			for(uint p = 0; p < 3; p++)
+				right &= groups[group[p]].begin == parts[i][p][0] && groups[group[p]].end == parts[i][p][1];
+			
+			counts[1] += right ? 1 : 0;
+		}
+	}
+	
+	{
+		// The parse NFA::match spares:  strtod() over the token again.
+		utilities::silent_timer Timer(durations[2]);
+		for(uint i = 0; i < tokens; i++)
+		{
+			char* end = nullptr;
+			std::strtod(text[i].c_str(), &end);
+			counts[2] += end == text[i].c_str() + text[i].size() ? 1 : 0;
+		}
+	}
+	
+	if(counts[0] != tokens || counts[1] != tokens)
+	{
+		cerr << "NFA " << re << " recognized " << counts[0] << " and captured " << counts[1] << " of " << tokens << " numbers." << endl;
+		result = -1;
+	}
+	
+	cout << "NFA captures, " << re << ", " << nfa.groups() << " groups, " << tokens << " numbers:" << endl;
+	cout << "\trecognizes " << durations[0] << "ms, match with captures " << durations[1] << "ms, strtod " << durations[2] << "ms" << endl << endl;
+	delete[] parts;
+	delete[] text;
+	
+	return result;
+}
+
+/*
+ * Reads edge lists through the memory mapped path of file_input and read_tokens:  first a small one with a blank
+ * line, a line longer than a read buffer, and no final newline, then a large random one, timing the walk over the
+ * mapped lines, the tokenizing, and read_int_graph building the digraph.
+*/
+
+int test_mapped_input()
+{
+	using namespace algorithms;
+	
+	int result = 0;
+	const string filename = "mapped-input.txt";
+	
+	{
+		ofstream out(filename, std::ios_base::trunc);
+		out << "300\n299\n\n";
+		for(uint v = 0; v < 200; v++)
+			out << v << " " << v + 1 << "   ";
+		
+		out << "\n";
+		for(uint v = 200; v < 299; v++)
+			out << v << " " << v + 1 << (v < 298 ? "\n" : "");
+	}
+	
+	file_input in;
+	containers::array<algorithms::line> lines;
+	read_int_graph small(filename, ' ', true);
+	if(in(filename, lines) != 0 || lines.size() != 103 || lines[3].length() < 1024)
+	{
+		cerr << "file_input read " << lines.size() << " lines of " << filename << ", not 103." << endl;
+		result = -1;
+	}
+	
+	if(small.ready() == false || small.DG().E() != 299)
+	{
+		cerr << "read_int_graph read " << small.DG().E() << " edges of " << filename << ", not 299." << endl;
+		result = -1;
+	}
+	
+	const uint V = 100000;
+	const uint E = 1000000;
+	std::mt19937 generator(41);
+	{
+		ofstream out(filename, std::ios_base::trunc);
+		out << V << "\n" << E << "\n";
+		for(uint e = 0; e < E; e++)
+			out << generator() % V << " " << generator() % V << "\n";
+	}
+	
+	int durations[] = {0, 0, 0};
+	ulong count = 0;
+	ulong bytes = 0;
+	{
+		utilities::silent_timer Timer(durations[0]);
+		line_view view;
+		if(in.map(filename) == true)
+		{
+			for(const char* at = in.begin(); at != in.end(); count++)
+			{
+				at = file_input::next_line(at, in.end(), view);
+				bytes += view.length;
+			}
+		}
+		
+		bytes = in.size();
+		in.unmap();
+	}
+	
+	uint ints = 0;
+	{
+		utilities::silent_timer Timer(durations[1]);
+		read_tokens tokens(filename, ' ');
+		while(tokens.nextToken() == read_tokens::INT)
+			ints++;
+	}
+	
+	uint edges = 0;
+	{
+		utilities::silent_timer Timer(durations[2]);
+		read_int_graph large(filename, ' ', true);
+		edges = large.E();
+	}
+	
+	if(count != E + 2 || ints != 2 * E + 2 || edges != E)
+	{
+		cerr << "Mapped " << count << " lines, " << ints << " integers and " << edges << " edges, not " << E + 2 << ", "
+			<< 2 * E + 2 << " and " << E << "." << endl;
+		result = -1;
+	}
+	
+	std::remove(filename.c_str());
+	
+	double MB = bytes / 1e6;
+	cout << "Mapped input, " << E << " edges, " << (uint)MB << " MB:" << endl;
+	cout << "\tlines " << durations[0] << "ms (" << (uint)(MB * 1000 / std::max(durations[0], 1)) << " MB/s), tokens "
+		<< durations[1] << "ms (" << (uint)(MB * 1000 / std::max(durations[1], 1)) << " MB/s), read_int_graph "
+		<< durations[2] << "ms" << endl << endl;
+	
+	return result;
+}
+
+/*
+ * Streams files through file_input and read_tokens in chunks, and compares with the mapped path:  the lines of a
+ * small file with a line longer than the chunk, with a chunk of 16 bytes, then the tokens of a large edge list, with
+ * the default chunk, which must not grow.
+*/
+
+int test_streamed_input()
+{
+	using namespace algorithms;
+	
+	int result = 0;
+	const string filename = "streamed-input.txt";
+	
+	{
+		ofstream out(filename, std::ios_base::trunc);
+		out << "3\n\n0 1\n";
+		for(uint v = 0; v < 20; v++)
+			out << v << " -> " << v + 1 << " 0.5  ";
+		
+		out << "\n\n\n1 2";
+	}
+	
+	file_input mapped;
+	file_input streamed;
+	line_view m, s;
+	uint lines = 0;
+	if(mapped.map(filename) == false || streamed.stream(filename, 16) == false)
+		result = -1;
+	
+	for(bool more = true; more == true && result == 0; lines++)
+	{
+		more = mapped.next_line(m);
+		if(more != streamed.next_line(s) || (more == true && string(m.data, m.length) != string(s.data, s.length)))
+		{
+			cerr << "Streaming " << filename << " in chunks of 16 bytes differs from mapping it at line " << lines << "." << endl;
+			result = -1;
+		}
+	}
+	
+	const uint V = 100000;
+	const uint E = 1000000;
+	std::mt19937 generator(43);
+	{
+		ofstream out(filename, std::ios_base::trunc);
+		out << V << "\n" << E << "\n";
+		for(uint e = 0; e < E; e++)
+			out << generator() % V << " " << generator() % V << "\n";
+	}
+	
+	int durations[] = {0, 0};
+	ulong sums[] = {0, 0};
+	uint counts[] = {0, 0};
+	for(uint mode = 0; mode < 2; mode++)
+	{
+		utilities::silent_timer Timer(durations[mode]);
+		read_tokens tokens(filename, ' ', mode == 1);
+		while(tokens.nextToken() == read_tokens::INT)
+		{
+			sums[mode] += tokens.getIntToken();
+			counts[mode]++;
+		}
+	}
+	
+	if(counts[0] != 2 * E + 2 || counts[1] != counts[0] || sums[1] != sums[0])
+	{
+		cerr << "Streaming read " << counts[1] << " integers summing to " << sums[1] << ", mapping " << counts[0]
+			<< " summing to " << sums[0] << "." << endl;
+		result = -1;
+	}
+	
+	streamed.stream(filename);
+	while(streamed.next_line(s) == true);
+	
+	if(streamed.capacity() != file_input::default_chunk || streamed.linecount() != E + 2)
+	{
+		cerr << "Streaming " << E + 2 << " lines grew the chunk to " << streamed.capacity() << " bytes." << endl;
+		result = -1;
+	}
+	
+	streamed.close_stream();
+	mapped.unmap();
+	std::remove(filename.c_str());
+	
+	cout << "Streamed input, " << lines - 1 << " lines compared, " << E << " edges:" << endl;
+	cout << "\ttokens mapped " << durations[0] << "ms, streamed " << durations[1] << "ms in a chunk of "
+		<< file_input::default_chunk / 1024 << " kB" << endl << endl;
+	
+	return result;
+}
+
+/*
+ * Checks the masks of structural_index, and next() and next_clear() over them, against testing each byte, on random
+ * text of random lengths.  Then indexes the delimiters and the newlines of a 64 MB edge list, written to the temporary
+ * directory and mapped, against the byte by byte loop read_tokens used to run and against memchr().
+*/
+
+int test_structural_index()
+{
+	using namespace algorithms;
+	
+	int result = 0;
+	const string delimiters = " ,\t";
+	structural_index index(delimiters);
+	structural_index newlines("\n");
+	
+	std::mt19937 generator(53);
+	const char alphabet[] = " ,\t\n0123456789-.ab";
+	ulong masks[8];
+	for(uint trial = 0; trial < 2000 && result == 0; trial++)
+	{
+		char text[500];
+		uint n = generator() % 500;
+		for(uint i = 0; i < n; i++)
+			text[i] = alphabet[generator() % (sizeof(alphabet) - 1)];
+		
+		index.index(text, n, masks);
+		uint from = n > 0 ? generator() % n : 0;
+		uint next = from;
+		uint next_clear = from;
+		while(next < n && delimiters.find(text[next]) == string::npos)
+			next++;
+		
+		while(next_clear < n && delimiters.find(text[next_clear]) != string::npos)
+			next_clear++;
+		
+		for(uint i = 0; i < n; i++)
+			if((((masks[i >> 6] >> (i & 63)) & 1) != 0) != (delimiters.find(text[i]) != string::npos))
+				result = -1;
+		
+		if(result != 0 || structural_index::next(masks, from, n) != next || structural_index::next_clear(masks, from, n) != next_clear)
+		{
+			cerr << "structural_index differs from testing each byte on text of " << n << " bytes, from " << from << "." << endl;
+			result = -1;
+		}
+	}
+	
+	// A 64 MB edge list:  a block of random edges written over and over.
+	const string filename = (std::filesystem::temp_directory_path() / "structural-index.txt").string();
+	const ulong size = 1ul << 26;
+	{
+		string block;
+		while(block.size() < (1ul << 20))
+			block += std::to_string(generator() % 1000000) + " " + std::to_string(generator() % 1000000) + "\n";
+		
+		ofstream out(filename, std::ios_base::trunc);
+		for(ulong written = 0; written < size; written += block.size())
+			out << block;
+	}
+	
+	file_input in;
+	if(in.map(filename) == false)
+	{
+		std::remove(filename.c_str());
+		return -1;
+	}
+	
+	const char* text = in.begin();
+	const ulong n = in.size();
+	const ulong piece = 1ul << 16;
+	ulong* pieceMasks = new ulong[piece / 64];
+	int durations[] = {0, 0, 0, 0};
+	ulong counts[] = {0, 0, 0, 0};
+	{
+		// What read_tokens::isDelim() did per byte.
+		utilities::silent_timer Timer(durations[0]);
+		for(ulong i = 0; i < n; i++)
+			for(uint d = 0; d < delimiters.length(); d++)
+				if(text[i] == delimiters[d])
+				{
+					counts[0]++;
+					break;
+				}
+	}
+	
+	{
+		utilities::silent_timer Timer(durations[1]);
+		for(ulong i = 0; i < n; i += piece)
+		{
+			ulong length = std::min(piece, n - i);
+			index.index(text + i, length, pieceMasks);
+			for(ulong w = 0; w < (length + 63) / 64; w++)
+				counts[1] += __builtin_popcountl(pieceMasks[w]);
+		}
+	}
+	
+	{
+		utilities::silent_timer Timer(durations[2]);
+		for(const char* at = text; (at = (const char*)memchr(at, '\n', text + n - at)) != nullptr; at++)
+			counts[2]++;
+	}
+	
+	{
+		utilities::silent_timer Timer(durations[3]);
+		for(ulong i = 0; i < n; i += piece)
+		{
+			ulong length = std::min(piece, n - i);
+			newlines.index(text + i, length, pieceMasks);
+			for(ulong w = 0; w < (length + 63) / 64; w++)
+				counts[3] += __builtin_popcountl(pieceMasks[w]);
+		}
+	}
+	
+	delete[] pieceMasks;
+	in.unmap();
+	std::remove(filename.c_str());
+	
+	if(counts[1] != counts[0] || counts[3] != counts[2])
+	{
+		cerr << "structural_index found " << counts[1] << " delimiters and " << counts[3] << " newlines, not " << counts[0]
+			<< " and " << counts[2] << "." << endl;
+		result = -1;
+	}
+	
+	double MB = n / 1e6;
+	cout << "Structural index, " << (uint)MB << " MB edge list, " << counts[0] << " delimiters, " << counts[2] << " newlines:" << endl;
+	cout << "\tdelimiters byte by byte " << durations[0] << "ms (" << (uint)(MB * 1000 / std::max(durations[0], 1))
+		<< " MB/s), indexed " << durations[1] << "ms (" << (uint)(MB * 1000 / std::max(durations[1], 1)) << " MB/s); newlines memchr "
+		<< durations[2] << "ms (" << (uint)(MB * 1000 / std::max(durations[2], 1)) << " MB/s), indexed " << durations[3] << "ms ("
+		<< (uint)(MB * 1000 / std::max(durations[3], 1)) << " MB/s)" << endl << endl;
+	
+	return result;
+}
+
+/*
+ * Reads random edge lists, weighted and not, with parallel_edge_reader on 1 to 4 threads, checks the graphs against
+ * those of read_edge_weighted_digraph and read_int_graph, and the CSR against the adjacency, and times both readers.
+*/
+
+int test_parallel_edge_reader()
+{
+	using namespace algorithms;
+	
+	int result = 0;
+	const string filename = "parallel-edges.txt";
+	const uint V = 50000;
+	const uint E = 500000;
+	std::mt19937 generator(59);
+	
+	// The CSR holds the edges of each v in the order of the file, as the digraph holds them in reverse.
+	auto CSR = [](const string& filename, const bool& weighted)
+	{
+		parallel_edge_reader parallel(filename, weighted, 4);
+		digraph g = parallel.DG();
+		uint* edgeStart = new uint[g.V() + 1];
+		uint* targets = new uint[g.E()];
+		parallel.CSR(edgeStart, targets);
+		bool same = true;
+		for(uint v = 0; v < g.V() && same == true; v++)
+		{
+			adj_citer begin, end;
+			g.adj(v, begin, end);
+			uint i = edgeStart[v + 1];
+			for(adj_citer w = begin; w != end && same == true; w++)
+				if(i == edgeStart[v] || targets[--i] != *w)
+					same = false;
+			
+			if(i != edgeStart[v])
+				same = false;
+		}
+		
+		if(same == false)
+			cerr << "parallel_edge_reader's CSR of " << filename << " differs from its digraph." << endl;
+		
+		delete[] edgeStart;
+		delete[] targets;
+		
+		return same;
+	};
+	
+	for(uint weighted = 0; weighted < 2; weighted++)
+	{
+		{
+			ofstream out(filename, std::ios_base::trunc);
+			out << V << "\n" << E << "\n";
+			for(uint e = 0; e < E; e++)
+			{
+				out << generator() % V << " " << generator() % V;
+				if(weighted == 1)
+					out << " " << generator() % 1000 << "." << generator() % 100;
+				
+				out << "\n";
+			}
+		}
+		
+		int durations[] = {0, 0, 0, 0};
+		string expected;
+		if(weighted == 1)
+		{
+			read_edge_weighted_digraph* sequential = nullptr;
+			{
+				utilities::silent_timer Timer(durations[0]);
+				sequential = new read_edge_weighted_digraph(filename);
+			}
+			
+			expected = sequential->EWDG().str();
+			delete sequential;
+		}
+		else
+		{
+			read_int_graph* sequential = nullptr;
+			{
+				utilities::silent_timer Timer(durations[0]);
+				sequential = new read_int_graph(filename, ' ', true);
+			}
+			
+			expected = sequential->DG().str();
+			delete sequential;
+		}
+		
+		for(uint threads = 1, d = 1; threads <= 4; threads *= 2, d++)
+		{
+			parallel_edge_reader* parallel = nullptr;
+			{
+				utilities::silent_timer Timer(durations[d]);
+				parallel = new parallel_edge_reader(filename, weighted == 1, threads);
+			}
+			
+			string found = weighted == 1 ? parallel->EWDG().str() : parallel->DG().str();
+			if(parallel->ready() == false || parallel->E() != E || found != expected)
+			{
+				cerr << "parallel_edge_reader on " << threads << " threads read another graph than the sequential reader." << endl;
+				result = -1;
+			}
+			
+			delete parallel;
+		}
+		
+		if(CSR(filename, weighted == 1) == false)
+			result = -1;
+		
+		cout << "Parallel edge reader, " << E << (weighted == 1 ? " weighted" : "") << " edges:" << endl;
+		cout << "\tsequential reader " << durations[0] << "ms; parsed on 1 thread " << durations[1] << "ms, 2 " << durations[2]
+			<< "ms, 4 " << durations[3] << "ms (" << std::thread::hardware_concurrency() << " cores)" << endl;
+	}
+	
+	// A sparse digraph, of fewer than 2V edges a thread, whose 4 chunks are counted and placed by 2 threads.
+	{
+		ofstream out(filename, std::ios_base::trunc);
+		out << E / 4 << "\n" << E << "\n";
+		for(uint e = 0; e < E; e++)
+			out << generator() % (E / 4) << " " << generator() % (E / 4) << "\n";
+	}
+	
+	if(CSR(filename, false) == false)
+		result = -1;
+	
+	cout << endl;
+	std::remove(filename.c_str());
+	
+	return result;
+}
+
+/*
+ * Checks number_scanner against what read_tokens and readNumber did before:  the longest match of the integer and real
+ * RE-s by a DFA, then strtol() or strtod() over a copy of the token.  Random numbers and random junk must give the same
+ * token types, lengths, values and range errors both ways, read_tokens the tokens of the rule it had with the RE-s,
+ * malformed runs as "1e1234" or "1.5.3" included, and readNumber the same verdicts on whole tokens, trailing spaces
+ * and overflows included.  Then times both ways over millions of numbers.
+*/
+
+int test_number_scanner()
+{
+	using namespace algorithms;
+	
+	int result = 0;
+	const pattern_set res = {"(-?[[:digit:]]+)", "(-?[[:digit:]]+.?[[:digit:]]*((e|E)-?[[:digit:]]{1,3})?)"};
+	const uint tokens = 2000000;
+	const string alphabet = "0123456789-.eE x";
+	
+	std::mt19937 generator(61);
+	string* text = new string[tokens];
+	for(uint i = 0; i < tokens; i++)
+	{
+		string& t = text[i];
+		if(i % 4 == 3)
+		{
+			// Junk, half of it digits.
+			for(uint n = 1 + generator() % 25; n > 0; n--)
+			{
+				uint c = generator() % (2 * alphabet.size());
+				t += c < alphabet.size() ? alphabet[c] : alphabet[c % 10];
+			}
+			
+			continue;
+		}
+		
+		t += generator() % 2 == 0 ? "-" : "";
+		for(uint n = 1 + generator() % (i % 4 == 0 ? 10 : 8); n > 0; n--)
+			t += (char)('0' + generator() % 10);
+		
+		if(i % 4 == 2)
+		{
+			t += ".";
+			for(uint n = generator() % 7; n > 0; n--)
+				t += (char)('0' + generator() % 10);
+			
+			if(generator() % 2 == 0)
+				t += "e" + string(generator() % 2 == 0 ? "-" : "") + std::to_string(generator() % 400);
+		}
+	}
+	
+	// What the DFA and strtol()/strtod() made of each token:  its type (0 integer, 1 real, 2 neither), length, and value.
+	uchar* types = new uchar[tokens];
+	uint* lengths = new uint[tokens];
+	double* values = new double[tokens];
+	int durations[] = {0, 0};
+	{
+		utilities::silent_timer Timer(durations[0]);
+		char digits[64];
+		for(uint i = 0; i < tokens; i++)
+		{
+			uint length = 0;
+			uint re = res.longest(text[i].cbegin(), text[i].cend(), length);
+			types[i] = re == pattern_set::none || length == 0 ? 2 : re;
+			lengths[i] = length;
+			values[i] = 0.0;
+			if(types[i] == 2 || length >= sizeof(digits))
+				continue;
+			
+			memcpy(digits, text[i].data(), length);
+			digits[length] = '\0';
+			errno = 0;
+			double value = types[i] == 0 ? strtol(digits, nullptr, 10) : strtod(digits, nullptr);
+			values[i] = errno == 0 ? value : graphs::inf;
+		}
+	}
+	
+	uint differences = 0;
+	number_scanner scanner;
+	{
+		utilities::silent_timer Timer(durations[1]);
+		for(uint i = 0; i < tokens; i++)
+		{
+			uchar type = 2;
+			uint length = 0;
+			double value = 0.0;
+			if(scanner(text[i].data(), text[i].data() + text[i].size()) == true)
+			{
+				long integer = 0;
+				type = scanner.real() > scanner.integer() ? 1 : 0;
+				length = type == 1 ? scanner.real() : scanner.integer();
+				if(type == 0)
+					value = scanner.toLong(integer) == true ? integer : graphs::inf;
+				else if(scanner.toDouble(value) == false)
+					value = graphs::inf;
+			}
+			
+			differences += type != types[i] || length != lengths[i] || value != values[i] ? 1 : 0;
+		}
+	}
+	
+	// read_tokens, on malformed runs and the first tokens written to a file, against the rule it had with the RE-s:  a
+	// run of [0-9.eE-] has to match the real RE as a whole, else it is a string up to the next delimiter, and an integer
+	// is only taken if no '.', 'e' or 'E' follows it.  The lines with a range error, checked above, are left out, as
+	// read_tokens reports each.
+	auto rule = [&res](const string& line, const uint& at, uint& end, double& value)
+	{
+		read_tokens::tokenType type = read_tokens::STRING;
+		if(isdigit(line[at]) || line[at] == '-')
+		{
+			end = at + (line[at] == '-' ? 1 : 0);
+			while(end < line.size() && isdigit(line[end]))
+				end++;
+			
+			if((end == line.size() || string(".eE").find(line[end]) == string::npos) && res.match(line.substr(at, end - at)) == 0)
+				type = read_tokens::INT;
+			else
+			{
+				end = at + (line[at] == '-' ? 1 : 0);
+				while(end < line.size() && string("0123456789.eE-").find(line[end]) != string::npos)
+					end++;
+				
+				if(((res.matches(line.substr(at, end - at)) >> 1) & 1) != 0)
+					type = read_tokens::REAL;
+				else if(line.compare(at, 2, "->") == 0)
+				{
+					type = read_tokens::OPERATOR;
+					end = at + 2;
+				}
+			}
+		}
+		
+		if(type == read_tokens::STRING)
+			end = std::min(line.find(' ', at), line.size());
+		
+		errno = 0;
+		if(type == read_tokens::INT)
+			value = (int)strtol(line.substr(at, end - at).c_str(), nullptr, 10);
+		else if(type == read_tokens::REAL)
+			value = strtod(line.substr(at, end - at).c_str(), nullptr);
+		
+		return type;
+	};
+	
+	const string filename = "number-scanner.txt";
+	const string malformed = "1e1234 3.0e 1.5.3 12abc 1-2 -.5 1.5-2 -> - 4. 1e5x";
+	containers::array<uint> lines;
+	{
+		ofstream out(filename, std::ios_base::trunc);
+		out << malformed << "\n";
+		for(uint i = 0; i < 100000; i++)
+		{
+			bool inRange = true;
+			double value = 0.0;
+			for(uint at = 0, end = 0; at < text[i].size() && inRange == true; at = std::max(end, at + 1))
+			{
+				end = at;
+				if(text[i][at] != ' ')
+				{
+					rule(text[i], at, end, value);
+					inRange = errno == 0;
+				}
+			}
+			
+			if(inRange == true)
+			{
+				out << text[i] << "\n";
+				lines.add(i);
+			}
+		}
+	}
+	
+	uint mismatches = 0;
+	{
+		read_tokens tokens(filename, ' ');
+		for(uint i = 0; i <= lines.size() && mismatches == 0; i++)
+		{
+			const string& line = i == 0 ? malformed : text[lines[i-1]];
+			for(uint at = 0; at < line.size() && mismatches == 0;)
+			{
+				if(line[at] == ' ')
+				{
+					at++;
+					continue;
+				}
+				
+				uint end = at;
+				double value = 0.0;
+				read_tokens::tokenType type = rule(line, at, end, value);
+				read_tokens::tokenType found = tokens.nextToken();
+				bool same = found == type;
+				if(same == true && type == read_tokens::INT)
+					same = tokens.getIntToken() == (int)value;
+				else if(same == true && type == read_tokens::REAL)
+					same = tokens.getRealToken() == value;
+				else if(same == true && type == read_tokens::STRING)
+					same = tokens.getStrToken() == line.substr(at, end - at);
+				
+				if(same == false)
+				{
+					cerr << "read_tokens read \"" << line.substr(at, end - at) << "\" of \"" << line << "\" as " << tokens.str(found)
+						<< ", not " << tokens.str(type) << "." << endl;
+					mismatches++;
+				}
+				
+				at = end;
+			}
+		}
+	}
+	
+	std::remove(filename.c_str());
+	if(mismatches != 0)
+		result = -1;
+	
+	// readNumber, on whole tokens:  NATURAL and REAL become LONG and DOUBLE once converted.
+	struct number_case
+	{
+		string text;
+		readNumber::token expected;
+	};
+	
+	const number_case cases[] = {{"42", readNumber::LONG}, {"-42", readNumber::LONG}, {"42 ", readNumber::NONE},
+		{"4.2e-7", readNumber::DOUBLE}, {"4.", readNumber::DOUBLE}, {"4e1234", readNumber::NONE}, {"-", readNumber::NONE},
+		{"9223372036854775807", readNumber::LONG}, {"-9223372036854775808", readNumber::LONG},
+		{"9223372036854775808", readNumber::NATURAL}, {"123456789012345678901", readNumber::DOUBLE},
+		{"1e999", readNumber::REAL}, {"1e-320", readNumber::REAL}, {"x1", readNumber::NONE}, {"", readNumber::NONE}};
+	
+	readNumber rn;
+	for(const number_case& n : cases)
+	{
+		readNumber::token found = rn(n.text);
+		if(found != n.expected)
+		{
+			cerr << "readNumber read \"" << n.text << "\" as token " << (int)found << ", not " << (int)n.expected << "." << endl;
+			result = -1;
+		}
+	}
+	
+	if(differences != 0)
+	{
+		cerr << "number_scanner differs from the DFA and strtol()/strtod() on " << differences << " of " << tokens << " tokens." << endl;
+		result = -1;
+	}
+	
+	cout << "Number scanner, " << tokens << " tokens:  DFA and strtol()/strtod() " << durations[0] << "ms, one pass "
+		<< durations[1] << "ms" << endl << endl;
+	
+	delete[] text;
+	delete[] types;
+	delete[] lengths;
+	delete[] values;
+	
+	return result;
+}
+
+/*
+ * Writes a random digraph, graph, edge_weighted_digraph and edge_weighted_graph to binary graph files, loads them back
+ * and checks the adjacency of each vertex, in order, against the graph written.  Also checks that a truncated file is
+ * refused, and times loading the binary file against reading the edge list.
+*/
+
+int test_binary_graph()
+{
+	using namespace algorithms;
+	
+	int result = 0;
+	const string text = "binary-graph.txt";
+	const string unweighted = "binary-graph-unweighted.txt";
+	const string filename = "binary-graph.bin";
+	const uint V = 250000;				// edge_weighted_graph keeps edges in an array of 2V, so E <= 2V.
+	const uint E = 500000;
+	std::mt19937 generator(61);
+	
+	{
+		// The same edges, with weights and without, for the weighted and unweighted readers.
+		ofstream out(text, std::ios_base::trunc);
+		ofstream plain(unweighted, std::ios_base::trunc);
+		out << V << "\n" << E << "\n";
+		plain << V << "\n" << E << "\n";
+		for(uint e = 0; e < E; e++)
+		{
+			uint v = generator() % V;
+			uint w = generator() % V;
+			out << v << " " << w << " " << generator() % 1000 << "." << generator() % 100 << "\n";
+			plain << v << " " << w << "\n";
+		}
+	}
+	
+	const char* names[] = {"digraph", "graph", "edge_weighted_digraph", "edge_weighted_graph"};
+	int durations[] = {0, 0, 0, 0};
+	int loads[] = {0, 0, 0, 0};
+	for(uint k = 0; k < 4; k++)
+	{
+		// Each kind is written from the graph the text reader makes, timed for comparison.
+		digraph dg;
+		graph g;
+		edge_weighted_digraph ewdg;
+		edge_weighted_graph ewg;
+		bool written = false;
+		{
+			utilities::silent_timer Timer(durations[k]);
+			if(k == binary_graph::DIGRAPH || k == binary_graph::GRAPH)
+			{
+				read_int_graph reader(unweighted, ' ', k == binary_graph::DIGRAPH);
+				if(k == binary_graph::DIGRAPH)
+					dg = reader.DG();
+				else
+					g = reader.G();
+			}
+			else if(k == binary_graph::EDGE_WEIGHTED_DIGRAPH)
+				ewdg = read_edge_weighted_digraph(text).EWDG();
+			else
+			{
+				// read_edge_weighted_graph prints the graph it read, and the copy its EWG() returns counts the edges
+				// twice, thus the parallel reader makes this one.
+				ewg = parallel_edge_reader(text, true).EWG();
+			}
+		}
+		
+		if(k == binary_graph::DIGRAPH)
+			written = binary_graph::write(filename, dg);
+		else if(k == binary_graph::GRAPH)
+			written = binary_graph::write(filename, g);
+		else if(k == binary_graph::EDGE_WEIGHTED_DIGRAPH)
+			written = binary_graph::write(filename, ewdg);
+		else
+			written = binary_graph::write(filename, ewg);
+		
+		binary_graph* loaded = nullptr;
+		{
+			utilities::silent_timer Timer(loads[k]);
+			loaded = new binary_graph(filename);
+		}
+		
+		if(written == false || loaded->ready() == false || loaded->type() != k || loaded->E() != E || loaded->verify() == false)
+		{
+			cerr << "binary_graph failed to save and load a " << names[k] << "." << endl;
+			result = -1;
+			delete loaded;
+			continue;
+		}
+		
+		bool same = true;
+		const uint* begin = nullptr;
+		const uint* end = nullptr;
+		const double* weights = nullptr;
+		for(uint v = 0; v < loaded->V() && same == true; v++)
+		{
+			loaded->adj(v, begin, end, weights);
+			const uint* w = begin;
+			if(k == binary_graph::DIGRAPH || k == binary_graph::GRAPH)
+			{
+				adj_citer b, e;
+				if(k == binary_graph::DIGRAPH)
+					dg.adj(v, b, e);
+				else
+					g.adj(v, b, e);
+				
+				for(adj_citer i = b; i != e && same == true; i++, w++)
+					same = w != end && *w == *i && weights == nullptr;
+			}
+			else if(k == binary_graph::EDGE_WEIGHTED_DIGRAPH)
+			{
+				adje_citer b, e;
+				ewdg.adj(v, b, e);
+				for(adje_citer i = b; i != e && same == true; i++, w++)
+					same = w != end && *w == (uint)(*i).to() && weights[w - begin] == (*i).weight;
+			}
+			else
+			{
+				adjpe_citer b, e;
+				ewg.adj(v, b, e);
+				for(adjpe_citer i = b; i != e && same == true; i++, w++)
+					same = w != end && *w == (uint)(*i)->other(v) && weights[w - begin] == (*i)->weight;
+			}
+			
+			same = same && w == end;
+		}
+		
+		if(same == false)
+		{
+			cerr << "The " << names[k] << " loaded from a binary graph file differs from the one written." << endl;
+			result = -1;
+		}
+		
+		delete loaded;
+	}
+	
+	// A file cut short must not load.
+	{
+		digraph small(3);
+		small.addEdge(0, 1);
+		small.addEdge(1, 2);
+		binary_graph::write(filename, small);
+		struct stat status;
+		stat(filename.c_str(), &status);
+		if(truncate(filename.c_str(), status.st_size - 4) != 0 || binary_graph(filename).ready() == true)
+		{
+			cerr << "binary_graph loaded a truncated file." << endl;
+			result = -1;
+		}
+	}
+	
+	cout << "Binary graph, " << V << " vertices, " << E << " edges:" << endl;
+	for(uint k = 0; k < 4; k++)
+		cout << "\t" << names[k] << ":  edge list " << durations[k] << "ms, binary file " << loads[k] << "ms" << endl;
+	
+	cout << endl;
+	std::remove(text.c_str());
+	std::remove(unweighted.c_str());
+	std::remove(filename.c_str());
+	
+	return result;
+}
+
+/*
+ * Checks containers::hash_map on its own, then reads a symbol graph of random names with read_symbol_graph:  each name
+ * must map to its index and back, and each line give the edges from its first name.  Times interning the names in a
+ * hash_map against putting them in a symbol_table.
+*/
+
+int test_symbol_graph()
+{
+	using namespace algorithms;
+	
+	int result = 0;
+	
+	// Updates, misses, keys with the same characters in another order, copies and moves.
+	containers::hash_map<uint> m;
+	const string words[] = {"alpha", "beta", "gamma", "ammag", "", "alpha beta"};
+	for(uint i = 0; i < 6; i++)
+		m.put(words[i], i);
+	
+	m.put("beta", 7);
+	containers::hash_map<uint> copy(m);
+	containers::hash_map<uint> moved(std::move(copy));
+	uint value = 0;
+	if(m.size() != 6 || m.get("beta") != 7 || m.get("gamma") != 2 || m.get("ammag") != 3 || m.contains("") == false
+		|| m.contains("delta") == true || m.get("delta", value) == true || m.key(5) != "alpha beta" || moved.size() != 6
+		|| moved.get("alpha beta") != 5 || moved.get("beta") != 7)
+	{
+		cerr << "hash_map failed on a few keys." << endl;
+		result = -1;
+	}
+	
+	const string filename = "symbol-graph.txt";
+	const uint names = 200000;
+	const uint lines = 100000;
+	std::mt19937 generator(67);
+	
+	// Each line names a vertex, and the vertices it has edges to.  Map the names as read to check against.
+	containers::hash_map<uint> expected(names);
+	uint* sources = new uint[lines * 4];
+	uint* targets = new uint[lines * 4];
+	uint edges = 0;
+	{
+		ofstream out(filename, std::ios_base::trunc);
+		for(uint l = 0; l < lines; l++)
+		{
+			uint n = 2 + generator() % 4;
+			uint v = 0;
+			for(uint i = 0; i < n; i++)
+			{
+				string name = "name" + std::to_string(generator() % names);
+				out << (i == 0 ? "" : " ") << name;
+				if(expected.contains(name) == false)
+					expected.put(name, expected.size());
+				
+				if(i == 0)
+					v = expected.get(name);
+				else
+				{
+					sources[edges] = v;
+					targets[edges++] = expected.get(name);
+				}
+			}
+			
+			out << "\n";
+		}
+	}
+	
+	read_symbol_graph sg(filename, true);
+	digraph g = sg.DG();
+	bool same = sg.ready() == true && sg.V() == expected.size() && sg.E() == edges;
+	for(uint v = 0; v < sg.V() && same == true; v++)
+		same = sg.name(v) == expected.key(v) && sg.index(expected.key(v)) == (int)v && sg.contains(expected.key(v)) == true;
+	
+	// The same edges, added in the order read.
+	digraph check(expected.size());
+	for(uint e = 0; e < edges; e++)
+		check.addEdge(sources[e], targets[e]);
+	
+	same = same && g.str() == check.str();
+	if(same == false)
+	{
+		cerr << "read_symbol_graph read another graph than the one written." << endl;
+		result = -1;
+	}
+	
+	delete[] sources;
+	delete[] targets;
+	
+	// Interning, against the sorted symbol table.
+	const uint count = 50000;
+	int durations[] = {0, 0};
+	{
+		utilities::silent_timer Timer(durations[0]);
+		containers::symbol_table<std::string, uint> st;
+		for(uint i = 0; i < count; i++)
+		{
+			string name = expected.key(i);
+			if(st.contains(name) == false)
+				st.put(name, st.size());
+		}
+	}
+	
+	{
+		utilities::silent_timer Timer(durations[1]);
+		containers::hash_map<uint> hm;
+		for(uint i = 0; i < count; i++)
+		{
+			string name = expected.key(i);
+			if(hm.contains(name) == false)
+				hm.put(name, hm.size());
+		}
+	}
+	
+	cout << "Symbol graph, " << sg.V() << " names, " << sg.E() << " edges:" << endl;
+	cout << "\tinterning " << count << " names:  symbol_table " << durations[0] << "ms, hash_map " << durations[1] << "ms" << endl;
+	cout << endl;
+	
+	std::remove(filename.c_str());
+	
+	return result;
+}
+
+/*
+ * Checks bplus_tree against std::map over random puts, removes and queries, and the bulk loads of bplus_tree and
+ * symbol_table, then times symbol_table against bplus_tree at 10k, 100k and 1M keys.
+*/
+
+int test_symbol_table()
+{
+	int result = 0;
+	std::mt19937 generator(71);
+	
+	// Keys from a range small enough that puts and removes hit present keys, over enough of them for 3 levels.
+	const uint range = 400000;
+	containers::bplus_tree<uint, uint> tree;
+	std::map<uint, uint> expected;
+	for(uint op = 0; op < 1000000 && result == 0; op++)
+	{
+		uint key = generator() % range;
+		uint kind = generator() % 10;
+		uint found = 0;
+		if(kind < 5)
+		{
+			tree.put(key, op);
+			expected[key] = op;
+		}
+		else if(kind < 8)
+		{
+			bool removed = tree.remove(key, found);
+			if(removed != (expected.erase(key) == 1))
+				result = -1;
+		}
+		else
+		{
+			// rank, select, floor, ceiling, size(low, high) and get.
+			auto ceiling = expected.lower_bound(key);
+			uint rank = tree.rank(key);
+			if(op % 1000 == 0 && rank != std::distance(expected.begin(), ceiling))		// O(N), thus now and then.
+				result = -1;
+			
+			bool present = ceiling != expected.end() && ceiling->first == key;
+			bool hasFloor = present == true || ceiling != expected.begin();
+			uint floor = present == true ? key : hasFloor == true ? std::prev(ceiling)->first : 0;
+			uint high = key + generator() % 100;
+			uint count = std::distance(ceiling, expected.upper_bound(high));
+			if(tree.ceiling(key, found) != (ceiling != expected.end())
+				|| (ceiling != expected.end() && found != ceiling->first) || tree.floor(key, found) != hasFloor
+				|| (hasFloor == true && found != floor) || tree.size(key, high) != count
+				|| tree.get(key) != (present == true ? ceiling->second : 0) || tree.contains(key) != present
+				|| (ceiling != expected.end() && (tree.select(rank, found) == false || found != ceiling->first)))
+				result = -1;
+		}
+		
+		if(result != 0)
+			cerr << "bplus_tree differs from std::map after " << op << " operations." << endl;
+	}
+	
+	uint key = 0;
+	uint other = 0;
+	if(result == 0 && (tree.size() != expected.size() || tree.min(key) == false || key != expected.begin()->first
+		|| tree.max(other) == false || other != expected.rbegin()->first))
+	{
+		cerr << "bplus_tree has another size, min or max than std::map." << endl;
+		result = -1;
+	}
+	
+	// Emptied from both ends.
+	uint removed = 0;
+	while(result == 0 && tree.size() > 0)
+	{
+		bool fromMin = removed % 2 == 0;
+		if((fromMin ? tree.removeMin(key) : tree.removeMax(key)) == false
+			|| key != (fromMin ? expected.begin()->first : expected.rbegin()->first))
+		{
+			cerr << "bplus_tree removed another key than its " << (fromMin ? "min." : "max.") << endl;
+			result = -1;
+		}
+		
+		expected.erase(key);
+		removed++;
+	}
+	
+	if(result == 0 && (tree.empty() == false || tree.height() != 1))
+	{
+		cerr << "bplus_tree emptied is not a single leaf." << endl;
+		result = -1;
+	}
+	
+	// Bulk loads on top of present keys, with duplicates among the loaded ones:  the last put of a key wins.
+	{
+		const uint n = 100000;
+		uint* keys = new uint[n];
+		uint* values = new uint[n];
+		containers::symbol_table<uint, uint> table;
+		expected.clear();
+		for(uint i = 0; i < 1000; i++)
+		{
+			uint k = generator() % (n / 2);
+			tree.put(k, i);
+			table.put(k, i);
+			expected[k] = i;
+		}
+		
+		for(uint i = 0; i < n; i++)
+		{
+			keys[i] = generator() % (n / 2);
+			values[i] = n + i;
+			expected[keys[i]] = values[i];
+		}
+		
+		tree.bulk_load(keys, keys + n, values);
+		table.bulk_load(keys, keys + n, values);
+		bool same = tree.size() == expected.size() && table.size() == expected.size();
+		uint i = 0;
+		for(auto k = expected.cbegin(); k != expected.cend() && same == true; k++, i++)
+			same = tree.select(i, key) == true && key == k->first && tree.get(key) == k->second && table.select(i, other) == true
+				&& other == k->first && table.get(other) == k->second;
+		
+		// The tree built in bulk must take updates as any other.
+		for(uint j = 0; j < n && same == true; j++)
+		{
+			tree.remove(keys[j], key);
+			expected.erase(keys[j]);
+		}
+		
+		same = same && tree.size() == expected.size();
+		if(same == false)
+		{
+			cerr << "The bulk loads differ from the puts they stand for." << endl;
+			result = -1;
+		}
+		
+		delete[] keys;
+		delete[] values;
+	}
+	
+	// Times:  put the keys in random order one at a time, or in bulk, then get each.  symbol_table's put is O(N), thus
+	// too slow to time at 1M keys.
+	cout << "symbol_table against bplus_tree, random keys:" << endl;
+	for(uint n = 10000; n <= 1000000; n *= 10)
+	{
+		uint* keys = new uint[n];
+		uint* values = new uint[n];
+		for(uint i = 0; i < n; i++)
+		{
+			keys[i] = generator();
+			values[i] = i;
+		}
+		
+		int durations[] = {-1, 0, 0, 0, 0, 0};
+		uint sum = 0;
+		if(n <= 100000)
+		{
+			containers::symbol_table<uint, uint> table;
+			utilities::silent_timer Timer(durations[0]);
+			for(uint i = 0; i < n; i++)
+				table.put(keys[i], values[i]);
+		}
+		
+		{
+			containers::symbol_table<uint, uint> table;
+			{
+				utilities::silent_timer Timer(durations[1]);
+				table.bulk_load(keys, keys + n, values);
+			}
+			
+			utilities::silent_timer Timer(durations[2]);
+			for(uint i = 0; i < n; i++)
+				sum += table.get(keys[i]);
+		}
+		
+		{
+			containers::bplus_tree<uint, uint> btree;
+			{
+				utilities::silent_timer Timer(durations[3]);
+				for(uint i = 0; i < n; i++)
+					btree.put(keys[i], values[i]);
+			}
+			
+			{
+				utilities::silent_timer Timer(durations[4]);
+				for(uint i = 0; i < n; i++)
+					sum -= btree.get(keys[i]);
+			}
+			
+			containers::bplus_tree<uint, uint> bulk;
+			utilities::silent_timer Timer(durations[5]);
+			bulk.bulk_load(keys, keys + n, values);
+		}
+		
+		if(sum != 0)
+		{
+			cerr << "symbol_table and bplus_tree got other values at " << n << " keys." << endl;
+			result = -1;
+		}
+		
+		cout << "\t" << n << " keys:  symbol_table put ";
+		if(durations[0] < 0)
+			cout << "-";
+		else
+			cout << durations[0] << "ms";
+		
+		cout << ", bulk_load " << durations[1] << "ms, get " << durations[2] << "ms; bplus_tree put " << durations[3]
+			<< "ms, get " << durations[4] << "ms, bulk_load " << durations[5] << "ms" << endl;
+		
+		delete[] keys;
+		delete[] values;
+	}
+	
+	cout << endl;
+	
+	return result;
+}
+
+
+
+/*
+ * Lookups in a symbol_table, its frozen copy and a bplus_tree, shared by 1 to 8 threads, each thread looking up its
+ * own slice of the same random keys.  The getters of symbol_table and bplus_tree lock read_write_mutex shared, and the
+ * frozen copy locks nothing; for comparison, the frozen copy is also looked up under one std::mutex, as the getters
+ * were before.  All runs have to find the same number of keys.
+*/
+
+int test_shared_lookups()
+{
+	using namespace std;
+	
+	int result = 0;
+	int duration = 0;
+	std::mt19937 generator(73);
+	
+	const uint n = 1000000;
+	const uint range = 2 * n;
+	const uint lookups = 2000000;
+	uint* keys = new uint[n];
+	for(uint i = 0; i < n; i++)
+		keys[i] = generator() % range;
+	
+	containers::symbol_table<uint, uint> table;
+	containers::bplus_tree<uint, uint> tree;
+	table.bulk_load(keys, keys + n, keys);
+	tree.bulk_load(keys, keys + n, keys);
+	containers::symbol_table<uint, uint>::frozen frozen = table.freeze();
+	
+	uint* querries = new uint[lookups];
+	ulong expected = 0;
+	for(uint i = 0; i < lookups; i++)
+	{
+		querries[i] = generator() % range;
+		if(frozen.contains(querries[i]))
+			expected++;
+	}
+	
+	cout << "Lookups of " << lookups << " keys in " << frozen.size() << ", shared by threads:" << endl;
+	
+	std::mutex exclusive;
+	const char* names[4] = {"symbol_table", "symbol_table::frozen", "frozen under a mutex", "bplus_tree"};
+	for(uint threadCount = 1; threadCount <= 8; threadCount *= 2)
+	{
+		cout << "\t" << threadCount << " thread(s):  ";
+		for(uint kind = 0; kind < 4; kind++)
+		{
+			std::atomic<ulong> found = 0;
+			thread* threads = new thread[threadCount];
+			{
+				utilities::silent_timer Timer(duration);
+				for(uint t = 0; t < threadCount; t++)
+				{
+					uint begin = (ulong)lookups * t / threadCount;
+					uint end = (ulong)lookups * (t + 1) / threadCount;
+					threads[t] = thread([&, kind, begin, end]()
+					{
+						ulong hits = 0;
+						uint value = 0;
+						for(uint i = begin; i < end; i++)
+						{
+							bool hit = false;
+							if(kind == 0)
+								hit = table.get(querries[i], value);
+							else if(kind == 1)
+								hit = frozen.get(querries[i], value);
+							else if(kind == 2)
+							{
+								std::unique_lock<std::mutex> ul(exclusive);
+								hit = frozen.get(querries[i], value);
+							}
+							else
+								hit = tree.get(querries[i], value);
+							
+							if(hit == true && value == querries[i])
+								hits++;
+						}
+						
+						found += hits;
+					});
+				}
+				
+				for(uint t = 0; t < threadCount; t++)
+					threads[t].join();
+			}
+			
+			delete[] threads;
+			cout << (kind == 0 ? "" : ", ") << names[kind] << " " << duration << "ms";
+			if(found != expected)
+			{
+				cerr << endl << names[kind] << " found " << found << " keys rather than " << expected << "." << endl;
+				result = -1;
+			}
+		}
+		
+		cout << endl;
+	}
+	
+	// The frozen copy is a copy:  it doesn't see later changes to the table.
+	uint key = 0;
+	frozen.min(key);
+	table.remove(key, key);
+	if(frozen.contains(key) == false || table.contains(key) == true || frozen.size() != table.size() + 1)
+	{
+		cerr << "symbol_table::frozen changed with its table." << endl;
+		result = -1;
+	}
+	
+	delete[] keys;
+	delete[] querries;
+	
+	cout << endl;
+	
+	return result;
+}
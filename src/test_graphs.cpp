@@ -3,8 +3,70 @@
 #include "containers.h"
 #include "utilities.h"
 
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <stdlib.h>
+#include <malloc.h>
+#include <fstream>
+#include <algorithm>
+#include <cstdio>
+
 using namespace std;
 
+/*
+ * Replacing the global allocation functions lets test_acyclic_workspace() count the heap
+ * allocations made by a stretch of code.  Every form is replaced, plain, array, nothrow, sized
+ * and aligned, so that all memory comes from malloc() or aligned_alloc() and goes back to free(),
+ * whichever form the standard library picks.
+*/
+
+static std::atomic<unsigned long> allocation_count{0};
+
+static void* counted_alloc(std::size_t size, std::size_t alignment = 0) noexcept
+{
+	allocation_count.fetch_add(1, std::memory_order_relaxed);
+	if(size == 0)
+		size = 1;
+	
+	if(alignment <= alignof(std::max_align_t))
+		return malloc(size);
+	
+	// aligned_alloc() wants a multiple of the alignment.
+	return aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+static void* counted_alloc_or_throw(std::size_t size, std::size_t alignment = 0)
+{
+	void* p = counted_alloc(size, alignment);
+	if(p == nullptr)
+		throw std::bad_alloc();
+	
+	return p;
+}
+
+void* operator new(std::size_t size) { return counted_alloc_or_throw(size); }
+void* operator new[](std::size_t size) { return counted_alloc_or_throw(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return counted_alloc(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return counted_alloc(size); }
+void* operator new(std::size_t size, std::align_val_t a) { return counted_alloc_or_throw(size, (std::size_t)a); }
+void* operator new[](std::size_t size, std::align_val_t a) { return counted_alloc_or_throw(size, (std::size_t)a); }
+void* operator new(std::size_t size, std::align_val_t a, const std::nothrow_t&) noexcept { return counted_alloc(size, (std::size_t)a); }
+void* operator new[](std::size_t size, std::align_val_t a, const std::nothrow_t&) noexcept { return counted_alloc(size, (std::size_t)a); }
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, std::size_t) noexcept { free(p); }
+void operator delete[](void* p, std::size_t) noexcept { free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { free(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { free(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { free(p); }
+
 int test_acyclic_paths()
 {
 	using namespace graphs;
@@ -78,3 +140,499 @@ int test_acyclic_paths()
 	
 	return 0;
 }
+
+/*
+ * Checks graphs::visited_set against a plain bool array over random set() and reset() calls
+ * and several clear() epochs, then times repeated small directed_DFS_multi querries on a large
+ * digraph, where clear() replaces the O(V) reset of the marks.
+*/
+
+int test_visited_set()
+{
+	using namespace graphs;
+	
+	const uint V = 100003;
+	const uint rounds = 8;
+	const uint changes = 20000;
+	
+	visited_set marks(V);
+	bool* reference = new bool[V];
+	uint seed = 1;
+	int result = 0;
+	
+	for(uint r = 0; r < rounds && result == 0; r++)
+	{
+		marks.clear();
+		for(uint v = 0; v < V; v++)
+			reference[v] = false;
+		
+		for(uint i = 0; i < changes; i++)
+		{
+			seed = seed * 1103515245 + 12345;
+			uint v = (seed >> 8) % V;
+			if(i % 3 == 2)
+			{
+				marks.reset(v);
+				reference[v] = false;
+			}
+			else
+			{
+				marks.set(v);
+				reference[v] = true;
+			}
+		}
+		
+		uint expected = 0;
+		uint next_set = 0;
+		uint next_unset = 0;
+		for(uint v = 0; v < V && result == 0; v++)
+		{
+			if(reference[v])
+				expected++;
+			
+			if(marks.test(v) != reference[v])
+				result = -1;
+			
+			// The next set and unset vertices at or past v are v itself or lie ahead.
+			if(next_set < v)
+				next_set = marks.find_next_set(v);
+			if(next_unset < v)
+				next_unset = marks.find_next_unset(v);
+			if((reference[v] && next_set != v) || (reference[v] == false && next_unset != v))
+				result = -1;
+		}
+		
+		if(marks.count() != expected)
+			result = -1;
+	}
+	
+	delete[] reference;
+	
+	if(result != 0)
+	{
+		cerr << "visited_set disagrees with a bool array." << endl;
+		return result;
+	}
+	
+	// A digraph made of short chains, so that each DFS only reaches a handful of vertices.
+	const uint chain = 8;
+	const uint querries = 200000;
+	digraph dg(V);
+	for(uint v = 0; v + 1 < V; v++)
+		if((v + 1) % chain != 0)
+			dg.addEdge(v, v + 1);
+	
+	directed_DFS_multi dfs(dg);
+	int duration = 0;
+	ulong reached = 0;
+	{
+		utilities::silent_timer Timer(duration);
+		for(uint i = 0; i < querries; i++)
+		{
+			seed = seed * 1103515245 + 12345;
+			dfs((seed >> 8) % V);
+			reached += dfs.count();
+		}
+	}
+	
+	cout << "directed_DFS_multi, " << querries << " querries on " << V << " vertices:  " << duration << "ms, " << reached << " vertices reached" << endl << endl;
+	
+	return 0;
+}
+
+/*
+ * Runs acyclic_SP and acyclic_LP querries from every vertex of a random DAG, each borrowing
+ * an acyclic_workspace, and depth_first_order over it again and again.  After the first (warm-up)
+ * querry, no querry may allocate, nor grow the workspace, and the topological order may only be
+ * recomputed once the graph changed.  The workspace's order, and depth_first_order's, have to match
+ * the one of topological, and the results those of objects owning their workspace.
+*/
+
+int test_acyclic_workspace()
+{
+	using namespace graphs;
+	
+	const uint V = 2000;
+	const uint E = 10000;
+	uint seed = 7;
+	
+	ewdg g(V);
+	for(uint i = 0; i < E; i++)
+	{
+		seed = seed * 1103515245 + 12345;
+		uint v = (seed >> 8) % V;
+		seed = seed * 1103515245 + 12345;
+		uint w = (seed >> 8) % V;
+		if(v == w)
+			continue;
+		
+		// Only point from the lower to the higher vertex, so that g is a DAG.
+		double weight = (double)((seed >> 4) % 1000) / 100.0;
+		if(v < w)
+			g.addEdge(edge(v, w, weight));
+		else
+			g.addEdge(edge(w, v, weight));
+	}
+	
+	acyclic_workspace sp_workspace;
+	acyclic_workspace lp_workspace;
+	acyclic_SP sp(sp_workspace);
+	acyclic_LP lp(lp_workspace);
+	
+	// Warm-up
+	sp(g, 0);
+	lp(g, 0);
+	
+	int result = 0;
+	const uint* begin = nullptr;
+	const uint* end = nullptr;
+	sp_workspace.order(g, begin, end);
+	
+	topological top(g);
+	path order = top.order();
+	path_citer o = order.cbegin();
+	if(end - begin != order.size())
+		result = -1;
+	for(const uint* v = begin; v != end && result == 0; v++, o++)
+		if(*v != *o)
+			result = -1;
+	
+	if(result != 0)
+	{
+		cerr << "acyclic_workspace order differs from topological." << endl;
+		return result;
+	}
+	
+	// depth_first_order's reverse postorder is the topological order, and its list, which adds to the back, holds the
+	// postorder.
+	depth_first_order dfo(g);
+	const uint* rbegin = nullptr;
+	const uint* rend = nullptr;
+	dfo.reversePostorder(rbegin, rend);
+	o = order.cbegin();
+	for(const uint* v = rbegin; v != rend && result == 0; v++, o++)
+		if(*v != *o)
+			result = -1;
+	
+	rpost reversePost = dfo.ReversePost();
+	rpost_citer r = reversePost.cbegin();
+	for(const uint* v = rend; v != rbegin && result == 0; r++)
+		if(*--v != *r)
+			result = -1;
+	
+	if(rend - rbegin != V || reversePost.size() != V)
+		result = -1;
+	
+	if(result != 0)
+	{
+		cerr << "depth_first_order differs from topological." << endl;
+		return result;
+	}
+	
+	int durations[] = {0, 0};
+	double total = 0.0;
+	uint reservations = sp_workspace.reservations() + lp_workspace.reservations();
+	unsigned long allocations = allocation_count.load();
+	{
+		utilities::silent_timer Timer(durations[0]);
+		for(uint s = 0; s < V; s++)
+		{
+			sp(g, s);
+			lp(g, s);
+			total += sp.distance(V-1) + lp.distance(V-1);
+		}
+	}
+	
+	{
+		utilities::silent_timer Timer(durations[1]);
+		for(uint i = 0; i < V / 10; i++)
+		{
+			dfo(g);
+			dfo.postorder(rbegin, rend);
+			total += *rbegin;
+		}
+	}
+	
+	allocations = allocation_count.load() - allocations;
+	reservations = sp_workspace.reservations() + lp_workspace.reservations() - reservations;
+	cout << "acyclic_SP and acyclic_LP from all " << V << " vertices:  " << durations[0] << "ms; depth_first_order "
+		<< V / 10 << " times:  " << durations[1] << "ms; " << allocations << " allocations after warm-up, workspaces grown "
+		<< reservations << " times" << endl;
+	if(allocations != 0 || reservations != 0 || sp_workspace.orders_computed() != 1 || lp_workspace.orders_computed() != 1)
+	{
+		cerr << "Repeated acyclic_SP/LP or depth_first_order querries allocated, or recomputed the topological order." << endl;
+		result = -1;
+	}
+	
+	// Results have to match those of objects owning their workspace.
+	for(uint s = 0; s < V && result == 0; s += V/10)
+	{
+		sp(g, s);
+		lp(g, s);
+		acyclic_SP fresh_sp(g, s);
+		acyclic_LP fresh_lp(g, s);
+		for(uint v = 0; v < V; v++)
+			if(sp.distance(v) != fresh_sp.distance(v) || lp.distance(v) != fresh_lp.distance(v))
+				result = -1;
+	}
+	
+	// A changed graph has to invalidate the cached order.
+	g.addEdge(edge(0, V-1, 1.0));
+	sp(g, 0);
+	if(sp_workspace.orders_computed() != 2 || sp.distance(V-1) > 1.0)
+		result = -1;
+	
+	if(result != 0)
+		cerr << "acyclic_workspace results are wrong or stale." << endl;
+	
+	cout << endl;
+	
+	return result;
+}
+
+/*
+ * Checks the version, the change log and the observers of graph_version, through digraph,
+ * edge_weighted_digraph and edge_weighted_graph, and topological going stale and refreshing.
+*/
+
+int test_graph_version()
+{
+	using namespace graphs;
+	
+	int result = 0;
+	
+	digraph dg(6);
+	ulong first = dg.version();
+	dg.addEdge(0, 1);
+	if(dg.version() == first)
+		result = -1;
+	
+	digraph copy(dg);
+	if(copy.version() == dg.version())
+		result = -1;
+	
+	// The log covers the changes made once logging was turned on.
+	dg.setLogging(true);
+	ulong start = dg.version();
+	dg.addEdge(1, 2);
+	ulong middle = dg.version();
+	dg.addEdge(2, 3);
+	dg.addEdge(3, 4);
+	
+	const graph_change* begin = nullptr;
+	const graph_change* end = nullptr;
+	if(dg.changesSince(start, begin, end) == false || end - begin != 3 || begin->v != 1 || begin->w != 2)
+		result = -1;
+	if(dg.changesSince(middle, begin, end) == false || end - begin != 2 || begin->v != 2 || (end-1)->w != 4)
+		result = -1;
+	if(dg.changesSince(first, begin, end) == true)
+		result = -1;
+	
+	if(result != 0)
+	{
+		cerr << "graph_version versions or change log are wrong." << endl;
+		return result;
+	}
+	
+	// topological learns about changes through its subscription.
+	topological top(dg);
+	if(top.stale() == true || top.isDAG() == false)
+		result = -1;
+	
+	dg.addEdge(4, 5);
+	if(top.stale() == false)
+		result = -1;
+	
+	top.refresh();
+	topological fresh(dg);
+	path order = top.order();
+	path expected = fresh.order();
+	path_citer e = expected.cbegin();
+	if(top.stale() == true || order.size() != expected.size())
+		result = -1;
+	for(path_citer o = order.cbegin(); o != order.cend() && result == 0; o++, e++)
+		if(*o != *e)
+			result = -1;
+	
+	// A cycle empties the order on refresh.
+	dg.addEdge(5, 0);
+	top.refresh();
+	if(top.isDAG() == true)
+		result = -1;
+	
+	// The graph may go first:  topological keeps its order, and refresh() does nothing.
+	{
+		ewdg g(3);
+		g.addEdge(edge(0, 1, 1.0));
+		top(g);
+		g.addEdge(edge(1, 2, 1.0));
+		if(top.stale() == false)
+			result = -1;
+	}
+	top.refresh();
+	if(top.order().size() != 3)
+		result = -1;
+	
+	ewg ug(3);
+	ulong before = ug.version();
+	ug.addEdge(edge(0, 1, 2.5));
+	ug.setLogging(true);
+	ug.clear();
+	if(ug.version() == before || ug.changesSince(before, begin, end) == true)
+		result = -1;
+	if(ug.logSize() != 1 || ug.logEntry(0).type != graph_change::CLEAR)
+		result = -1;
+	
+	if(result != 0)
+		cerr << "topological or graph_version observers are wrong." << endl;
+	else
+		cout << "graph_version:  versions, change log and observers OK" << endl << endl;
+	
+	return result;
+}
+
+/*
+ * Reads a random edge list, whose edges mostly join nearby vertices, into a digraph and into a compressed_digraph,
+ * and compares the heap each takes.  The compressed_digraph, built from the CSR and from the digraph, has to hold the
+ * neighbours of the digraph, sorted, and breadth_first_paths has to reach the same vertices at the same distances
+ * on both.  depth_first_search, being recursive, is compared on a smaller digraph.
+*/
+
+int test_compressed_digraph()
+{
+	using namespace graphs;
+	
+	int result = 0;
+	const string filename = "compressed-digraph.txt";
+	const uint V = 500000;
+	const uint E = 3000000;
+	uint seed = 7;
+	auto next = [&seed]() { seed = seed * 1103515245 + 12345; return seed >> 4; };
+	{
+		ofstream out(filename, std::ios_base::trunc);
+		out << V << "\n" << E << "\n";
+		for(uint e = 0; e < E; e++)
+		{
+			uint v = next() % V;
+			uint w = next() % 10 == 0 ? next() % V : (v + next() % 64) % V;
+			out << v << " " << w << "\n";
+		}
+	}
+	
+	algorithms::parallel_edge_reader reader(filename, false);
+	std::remove(filename.c_str());
+	
+	int dgDuration = 0;
+	int cdgDuration = 0;
+	ulong heap = mallinfo2().uordblks;
+	digraph* dg = nullptr;
+	{
+		utilities::silent_timer Timer(dgDuration);
+		dg = new digraph(reader.DG());
+	}
+	
+	ulong dgHeap = mallinfo2().uordblks - heap;
+	heap = mallinfo2().uordblks;
+	compressed_digraph* cdg = nullptr;
+	{
+		utilities::silent_timer Timer(cdgDuration);
+		cdg = new compressed_digraph(reader.CDG());
+	}
+	
+	ulong cdgHeap = mallinfo2().uordblks - heap;
+	compressed_digraph fromDigraph(*dg);
+	
+	uint* neighbours = new uint[E];
+	for(uint v = 0; v < V && result == 0; v++)
+	{
+		uint n = 0;
+		adj_citer begin, end;
+		dg->adj(v, begin, end);
+		for(adj_citer w = begin; w != end; w++)
+			neighbours[n++] = *w;
+		
+		std::sort(neighbours, neighbours + n);
+		
+		for(const compressed_digraph* g : {cdg, &fromDigraph})
+		{
+			uint i = 0;
+			compressed_digraph::iterator cbegin, cend;
+			g->adj(v, cbegin, cend);
+			for(compressed_digraph::iterator w = cbegin; w != cend && result == 0; w++)
+				if(i == n || *w != neighbours[i++])
+					result = -1;
+			
+			if(i != n || g->degree(v) != n)
+				result = -1;
+		}
+	}
+	
+	delete[] neighbours;
+	
+	if(result != 0 || cdg->V() != V || cdg->E() != E)
+	{
+		cerr << "compressed_digraph holds other neighbours than its digraph." << endl;
+		result = -1;
+	}
+	
+	int bfsDuration = 0;
+	int cbfsDuration = 0;
+	for(uint s = 0; s < V && result == 0; s += V / 4)
+	{
+		breadth_first_paths* bfs = nullptr;
+		breadth_first_paths* cbfs = nullptr;
+		{
+			utilities::silent_timer Timer(bfsDuration, utilities::silent_timer::accumulating);
+			bfs = new breadth_first_paths(*dg, s);
+		}
+		
+		{
+			utilities::silent_timer Timer(cbfsDuration, utilities::silent_timer::accumulating);
+			cbfs = new breadth_first_paths(*cdg, s);
+		}
+		
+		for(uint v = 0; v < V && result == 0; v++)
+		{
+			if(bfs->hasPathTo(v) != cbfs->hasPathTo(v))
+				result = -1;
+			else if(v % 1000 == 0 && bfs->hasPathTo(v) == true && bfs->pathTo(s, v).size() != cbfs->pathTo(s, v).size())
+				result = -1;
+		}
+		
+		delete bfs;
+		delete cbfs;
+	}
+	
+	if(result != 0)
+		cerr << "breadth_first_paths searched a compressed_digraph otherwise than its digraph." << endl;
+	
+	delete dg;
+	delete cdg;
+	
+	// A smaller digraph for depth_first_search, whose recursion is as deep as the longest path it takes.
+	const uint smallV = 5000;
+	digraph small(smallV);
+	for(uint e = 0; e < 4 * smallV; e++)
+		small.addEdge(next() % smallV, next() % smallV);
+	
+	compressed_digraph compressedSmall(small);
+	compressed_digraph copy = compressedSmall;
+	depth_first_search dfs(small, 0);
+	depth_first_search cdfs(copy, 0);
+	for(uint v = 0; v < smallV && result == 0; v++)
+		if(dfs.marked(v) != cdfs.marked(v))
+			result = -1;
+	
+	if(result != 0 || dfs.count() != cdfs.count() || copy.str() != compressedSmall.str())
+	{
+		cerr << "depth_first_search searched a compressed_digraph otherwise than its digraph." << endl;
+		result = -1;
+	}
+	
+	cout << "compressed_digraph, " << V << " vertices and " << E << " edges:" << endl;
+	cout << "\tdigraph " << dgHeap / 1024 / 1024 << "MB in " << dgDuration << "ms, compressed_digraph " << cdgHeap / 1024 / 1024
+		<< "MB in " << cdgDuration << "ms (" << (double)fromDigraph.bytes() / E << " bytes an edge)" << endl;
+	cout << "\tbreadth_first_paths from 4 sources:  digraph " << bfsDuration << "ms, compressed_digraph " << cbfsDuration << "ms" << endl << endl;
+	
+	return result;
+}